@@ -1,5 +1,8 @@
 // NeoVACDM.cpp
 #include "NeoVACDM.h"
+#include <algorithm>
+#include <format>
+#include <fstream>
 #include <numeric>
 
 #include "Version.h"
@@ -17,11 +20,18 @@ using namespace vacdm::com;
 using namespace vacdm::core;
 using namespace std::chrono_literals;
 
+/// @brief time after which the latest release is requested again from GitHub
+static constexpr std::chrono::hours updateCheckTtl = std::chrono::hours(12);
+static constexpr std::chrono::seconds handshakeRetryBaseDelay = std::chrono::seconds(5);
+static constexpr std::chrono::seconds handshakeRetryMaxDelay = std::chrono::minutes(5);
+
 NeoVACDM::NeoVACDM() = default;
 NeoVACDM::~NeoVACDM() = default;
 
 void NeoVACDM::Initialize(const PluginMetadata &metadata, CoreAPI *coreAPI, ClientInformation info)
 {
+    const auto initializationStart = std::chrono::steady_clock::now();
+
     metadata_ = metadata;
     clientInfo_ = info;
     CoreAPI *lcoreAPI = coreAPI;
@@ -37,17 +47,18 @@ void NeoVACDM::Initialize(const PluginMetadata &metadata, CoreAPI *coreAPI, Clie
     vacdmLogger_ = std::make_unique<logging::Logger>();
     server_ = std::make_unique<Server>(GetLogger());
     dataManager_ = std::make_unique<core::DataManager>(GetServer(), GetLogger());
+    dataManager_->openOutboxJournal(clientInfo_.documentsPath.string() + DIR_SEPARATOR + "plugins" + DIR_SEPARATOR +
+                                    "vacdm_outbox.jsonl");
 
     if (vacdmLogger_)
         vacdmLogger_->setLogger(logger_);
 
+    this->m_stop = false;
+    this->m_handshake = std::thread(&NeoVACDM::runHandshake, this);
+
 
-	std::pair<bool, std::string> updateAvailable = newVersionAvailable();
-#ifndef DEV    
-	if (updateAvailable.first) {
-		DisplayMessage("A new version of NeoVACDM is available: " + updateAvailable.second + " (current version: " + PLUGIN_VERSION + ")", false, "Update", true);
-	}    
-#endif
+    this->m_updateCheckCancelled = false;
+    this->m_updateChecker = std::thread(&NeoVACDM::checkForUpdates, this);
 
     DisplayMessage("Version " + std::string(PLUGIN_VERSION) + " loaded", true, "Initialisation");
     if (vacdmLogger_)
@@ -70,42 +81,157 @@ void NeoVACDM::Initialize(const PluginMetadata &metadata, CoreAPI *coreAPI, Clie
         logger_->error("Failed to initialize NeoVACDM: " + std::string(e.what()));
     }
 
-    this->m_stop = false;
     this->m_worker = std::thread(&NeoVACDM::run, this);
+
+    const auto initializationTime =
+        std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - initializationStart);
+    logger_->info("NeoVACDM initialized in " + std::to_string(initializationTime.count()) + "ms");
+}
+
+void NeoVACDM::checkForUpdates()
+{
+    const auto checkStart = std::chrono::steady_clock::now();
+
+    std::pair<bool, std::string> updateAvailable = newVersionAvailable();
+#ifndef DEV
+    if (updateAvailable.first) {
+        this->postMessage("A new version of NeoVACDM is available: " + updateAvailable.second + " (current version: " + PLUGIN_VERSION + ")", false, "Update", true);
+    }
+#endif
+
+    const auto checkTime =
+        std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - checkStart);
+    if (vacdmLogger_)
+        vacdmLogger_->log(logging::Logger::LogSender::vACDM,
+                          "Update check finished in " + std::to_string(checkTime.count()) + "ms",
+                          logging::Logger::LogLevel::Info);
+}
+
+std::optional<std::string> NeoVACDM::cachedLatestVersion(const std::string &path)
+{
+    std::ifstream stream(path);
+    if (false == stream.is_open()) return std::nullopt;
+
+    try
+    {
+        const auto root = nlohmann::json::parse(stream);
+        const auto checkedAt =
+            std::chrono::system_clock::time_point(std::chrono::seconds(root["checkedAt"].get<long long>()));
+        if (std::chrono::system_clock::now() - checkedAt > updateCheckTtl) return std::nullopt;
+
+        return root["latestVersion"].get<std::string>();
+    }
+    catch (const std::exception &)
+    {
+        return std::nullopt;
+    }
 }
 
 std::pair<bool, std::string> NeoVACDM::newVersionAvailable()
 {
-    httplib::SSLClient cli("api.github.com");
-    httplib::Headers headers = { {"User-Agent", "VersionChecker"} };
-    std::string apiEndpoint = "/repos/ZeFlyingGnome/neoradar-vacdm/releases/latest";
+    const std::string cachePath = clientInfo_.documentsPath.string() + DIR_SEPARATOR + "plugins" + DIR_SEPARATOR + "vacdm_update.json";
+
+    auto latestVersion = this->cachedLatestVersion(cachePath);
+    if (!latestVersion) {
+        httplib::SSLClient cli("api.github.com");
+        // do not keep the plugin from shutting down while GitHub is unreachable
+        cli.set_connection_timeout(3);
+        cli.set_read_timeout(5);
+        httplib::Headers headers = { {"User-Agent", "VersionChecker"} };
+        std::string apiEndpoint = "/repos/ZeFlyingGnome/neoradar-vacdm/releases/latest";
+
+        {
+            std::lock_guard guard(this->m_updateCheckLock);
+            if (true == this->m_updateCheckCancelled) return { false, "" };
+            this->m_updateCheckClient = &cli;
+        }
+        auto res = cli.Get(apiEndpoint.c_str(), headers);
+        {
+            std::lock_guard guard(this->m_updateCheckLock);
+            this->m_updateCheckClient = nullptr;
+            // the request was stopped because the plugin shuts down
+            if (true == this->m_updateCheckCancelled) return { false, "" };
+        }
+        if (!res || res->status != 200) {
+            logger_->error("Failed to check for NeoVACDM updates. HTTP status: " + std::to_string(res ? res->status : 0));
+            return { false, "" };
+        }
 
-    auto res = cli.Get(apiEndpoint.c_str(), headers);
-    if (res && res->status == 200) {
         try
         {
             auto json = nlohmann::json::parse(res->body);
-            std::string latestVersion = json["tag_name"];
-            latestVersion.erase(0, 1); // remove leading 'v'
-            if (latestVersion != PLUGIN_VERSION) {
-                logger_->warning("A new version of NeoVACDM is available: " + latestVersion + " (current version: " + PLUGIN_VERSION + ")");
-                return { true, latestVersion };
-            }
-            else {
-                logger_->log(PluginSDK::Logger::LogLevel::Info, "NeoVACDM is up to date.");
-                return { false, "" };
-            }
+            latestVersion = json["tag_name"].get<std::string>();
+            latestVersion->erase(0, 1); // remove leading 'v'
         }
         catch (const std::exception& e)
         {
             logger_->error("Failed to parse version information from GitHub: " + std::string(e.what()));
             return { false, "" };
         }
+
+        // remember the latest release, GitHub is asked again after updateCheckTtl
+        std::ofstream cache(cachePath, std::ios::trunc);
+        cache << nlohmann::json({{"checkedAt", std::chrono::duration_cast<std::chrono::seconds>(
+                                                   std::chrono::system_clock::now().time_since_epoch()).count()},
+                                 {"latestVersion", *latestVersion}}).dump();
     }
-    else {
-        logger_->error("Failed to check for NeoVACDM updates. HTTP status: " + std::to_string(res ? res->status : 0));
-        return { false, "" };
+
+    if (*latestVersion != PLUGIN_VERSION) {
+        logger_->warning("A new version of NeoVACDM is available: " + *latestVersion + " (current version: " + PLUGIN_VERSION + ")");
+        return { true, *latestVersion };
+    }
+
+    logger_->log(PluginSDK::Logger::LogLevel::Info, "NeoVACDM is up to date.");
+    return { false, "" };
+}
+
+void NeoVACDM::displayStatistics()
+{
+    const auto milliseconds = [](const std::chrono::microseconds &duration) {
+        return std::format("{:.1f}ms", static_cast<double>(duration.count()) / 1000.0);
+    };
+    const auto kilobytes = [](std::uint64_t bytes) {
+        return std::format("{:.1f}kB", static_cast<double>(bytes) / 1024.0);
+    };
+
+    const auto statistics = server_->requestStatistics();
+    if (true == statistics.empty()) {
+        DisplayMessage("No requests sent yet", true, "Stats");
+        return;
+    }
+
+    for (const auto &entry : statistics) {
+        const auto &latency = entry.statistics.latency;
+        std::string message = entry.method + " " + Server::endpointName(entry.endpoint) + ": " +
+                              std::to_string(entry.statistics.requests) + " requests, p50 " +
+                              milliseconds(latency.percentile(50.0)) + ", p95 " + milliseconds(latency.percentile(95.0)) +
+                              ", p99 " + milliseconds(latency.percentile(99.0)) + ", in " +
+                              kilobytes(entry.statistics.bytesReceived) + ", out " + kilobytes(entry.statistics.bytesSent);
+
+        if (0 != entry.statistics.failures) message += ", " + std::to_string(entry.statistics.failures) + " failed";
+        for (const auto &[status, count] : entry.statistics.errorStatuses)
+            message += ", " + std::to_string(count) + "x " + std::to_string(status);
+
+        DisplayMessage(message, true, "Stats");
     }
+
+    const auto parsing = server_->parsingStatistics();
+    if (0 != parsing.count)
+        DisplayMessage("Parsing pilots: " + std::to_string(parsing.count) + " responses, p50 " +
+                           milliseconds(parsing.percentile(50.0)) + ", p95 " + milliseconds(parsing.percentile(95.0)) +
+                           ", p99 " + milliseconds(parsing.percentile(99.0)),
+                       true, "Stats");
+}
+
+std::string NeoVACDM::dumpStatistics()
+{
+    const std::string path = clientInfo_.documentsPath.string() + DIR_SEPARATOR + "plugins" + DIR_SEPARATOR + "vacdm_stats.json";
+
+    std::ofstream stream(path, std::ios::trunc);
+    if (false == stream.is_open()) return "";
+
+    stream << server_->statisticsDump().dump(4);
+    return true == stream.good() ? path : "";
 }
 
 void NeoVACDM::Shutdown()
@@ -116,8 +242,20 @@ void NeoVACDM::Shutdown()
         logger_->info("NeoVACDM shutdown complete");
     }
 
-    this->m_stop = true;
+    {
+        std::lock_guard guard(this->m_handshakeLock);
+        this->m_stop = true;
+    }
+    this->m_handshakeCondition.notify_all();
+    {
+        // the update check does not keep the plugin from unloading until GitHub answers
+        std::lock_guard guard(this->m_updateCheckLock);
+        this->m_updateCheckCancelled = true;
+        if (nullptr != this->m_updateCheckClient) this->m_updateCheckClient->stop();
+    }
     this->m_worker.join();
+    if (this->m_handshake.joinable()) this->m_handshake.join();
+    if (this->m_updateChecker.joinable()) this->m_updateChecker.join();
 
 	if (dataManager_) dataManager_.reset();
     if (server_) server_.reset();
@@ -138,24 +276,122 @@ void NeoVACDM::DisplayMessage(const std::string &message, const bool &dedicated,
     chatAPI_->sendClientMessage(textMessage);
 }
 
-void NeoVACDM::checkServerConfiguration() {
-    if (server_) {
-        if (server_->checkWebApi() == false) {
-            DisplayMessage("Connection failed.", false, "Server");
-            DisplayMessage(server_->errorMessage().c_str(), false, "Server");
-        } else {
-            std::string serverName = server_->getServerConfig().name;
-            DisplayMessage(("Connected to " + serverName), true, "Server");
-            server_->retrieveSupportedAirports();
-            // set active airports and runways
-            this->OnAirportConfigurationsUpdated(nullptr);
+void NeoVACDM::postMessage(const std::string &message, bool dedicated, const std::string &sender, bool important) {
+    std::lock_guard guard(this->m_pendingMessagesLock);
+    this->m_pendingMessages.push_back({message, dedicated, sender, important});
+}
+
+void NeoVACDM::displayPendingMessages() {
+    std::list<PendingMessage> messages;
+    {
+        std::lock_guard guard(this->m_pendingMessagesLock);
+        messages.swap(this->m_pendingMessages);
+    }
+
+    for (const auto &message : messages)
+        DisplayMessage(message.message, message.dedicated, message.sender, message.important);
+}
+
+void NeoVACDM::startHandshake() {
+    {
+        std::lock_guard guard(this->m_handshakeLock);
+        this->m_handshakeRequested = true;
+    }
+    this->m_handshakeCondition.notify_one();
+}
+
+void NeoVACDM::runHandshake() {
+    std::unique_lock lock(this->m_handshakeLock);
+    const auto requested = [this]() { return this->m_stop || this->m_handshakeRequested; };
+    int failedAttempts = 0;
+
+    while (true) {
+        if (0 == failedAttempts) {
+            this->m_handshakeCondition.wait(lock, requested);
+        } else if (true == this->m_handshakeCondition.wait_for(lock, handshakeRetryDelay(failedAttempts), requested)) {
+            // a requested handshake replaces the retry of the failed one
+            failedAttempts = 0;
         }
+        if (true == this->m_stop) return;
+        this->m_handshakeRequested = false;
+
+        lock.unlock();
+        const bool connected = this->performHandshake();
+        if (false == connected) {
+            const auto delay = handshakeRetryDelay(failedAttempts + 1);
+            // the chat only shows the first failure, the retries are logged
+            if (0 == failedAttempts) {
+                this->postMessage("Connection failed.", false, "Server");
+                this->postMessage(server_->errorMessage(), false, "Server");
+            }
+            if (vacdmLogger_)
+                vacdmLogger_->log(logging::Logger::LogSender::vACDM,
+                                  "Handshake failed, retrying in " + std::to_string(delay.count()) + " seconds",
+                                  logging::Logger::LogLevel::Info);
+        }
+        lock.lock();
+
+        failedAttempts = true == connected ? 0 : failedAttempts + 1;
+    }
+}
+
+std::chrono::seconds NeoVACDM::handshakeRetryDelay(int failedAttempts) {
+    // 5s, 10s, 20s, ... up to the limit, the shift is bounded to avoid an overflow
+    const auto delay = handshakeRetryBaseDelay * (1 << std::min(failedAttempts - 1, 8));
+    return std::min<std::chrono::seconds>(delay, handshakeRetryMaxDelay);
+}
+
+bool NeoVACDM::handshakeCancelled() {
+    std::lock_guard guard(this->m_handshakeLock);
+    return this->m_stop || this->m_handshakeRequested;
+}
+
+void NeoVACDM::setConnectionState(ConnectionState state) {
+    this->m_connectionState = state;
+
+    if (vacdmLogger_) {
+        static const char *stateNames[] = {"Disconnected", "Probing", "Configured", "Ready"};
+        vacdmLogger_->log(logging::Logger::LogSender::vACDM,
+                          "Connection state: " + std::string(stateNames[static_cast<int>(state)]),
+                          logging::Logger::LogLevel::Info);
     }
+}
+
+bool NeoVACDM::performHandshake() {
+    if (!server_) {
 #ifdef DEV
-    else {
         logger_->info("No server instance available 1");
+#endif
+        return true;
+    }
+
+    this->setConnectionState(ConnectionState::Probing);
+    if (server_->checkWebApi() == false) {
+        // the check of a replaced address failed, the requested handshake checks the new one
+        if (true == this->handshakeCancelled()) return true;
+
+        // no pilots are polled until the backend is reachable
+        this->setConnectionState(ConnectionState::Disconnected);
+        dataManager_->pause();
+        return false;
     }
-#endif    
+    if (true == this->handshakeCancelled()) return true;
+
+    std::string serverName = server_->getServerConfig().name;
+    this->setConnectionState(ConnectionState::Configured);
+    this->postMessage("Connected to " + serverName, true, "Server");
+    if (true == this->handshakeCancelled()) return true;
+
+    server_->retrieveSupportedAirports();
+    if (true == this->handshakeCancelled()) return true;
+
+    // set active airports and runways, the pilots of the airports are polled from now on
+    this->OnAirportConfigurationsUpdated(nullptr);
+    dataManager_->resume();
+    this->setConnectionState(ConnectionState::Ready);
+    this->postMessage("Received " + std::to_string(server_->getSupportedAirports().size()) + " supported airports",
+                      true, "Server");
+    return true;
 }
 
 void NeoVACDM::runScopeUpdate() {
@@ -163,6 +399,9 @@ void NeoVACDM::runScopeUpdate() {
 
     for (const auto &flightplan : flightplans)
     {
+        // the aircraft and the distance are only needed for flights which depart from an active airport
+        if (false == dataManager_->isActiveAirport(flightplan.origin)) continue;
+
         auto aircraft = GetAircraftByCallsign(flightplan.callsign);
         // if no aircraft found, skip to next flightplan (prefiles ?)
         if (aircraft) {
@@ -188,10 +427,19 @@ void NeoVACDM::reloadConfiguration(bool initialLoading) {
         if (this->m_pluginConfig.serverUrl != newConfig.serverUrl)
             this->changeServerUrl(newConfig.serverUrl);
         else
-            this->checkServerConfiguration();
+            this->startHandshake();
 
         this->m_pluginConfig = newConfig;
         DisplayMessage(dataManager_->setUpdateCycleSeconds(newConfig.updateCycleSeconds));
+        if (server_) {
+            server_->setParallelRequests(newConfig.parallelRequests);
+            server_->setIncrementalSync(newConfig.incrementalSync);
+            server_->setPushUpdates(newConfig.pushUpdates);
+            server_->setBatchRequests(newConfig.batchRequests);
+            server_->setResponseCompression(newConfig.compressResponses);
+            server_->setRequestCompression(newConfig.compressRequests,
+                                           static_cast<std::size_t>(newConfig.compressionThreshold));
+        }
         tagitems::Color::updatePluginConfig(newConfig);
     }
 }
@@ -204,15 +452,16 @@ void NeoVACDM::changeServerUrl(const std::string &url) {
     else
         logger_->info("No server instance available 2");
 #endif
-    this->checkServerConfiguration();
+    // the data manager is resumed by the handshake once the airports of the new backend are known
+    this->startHandshake();
 
-    dataManager_->resume();
     DisplayMessage("Changed URL to " + url);
     if (vacdmLogger_)
         vacdmLogger_->log(logging::Logger::LogSender::vACDM, "Changed URL to " + url, logging::Logger::LogLevel::Info);
 }
 
 void NeoVACDM::OnTimer(int Counter) {
+    this->displayPendingMessages();
     if (Counter % 5 == 0) this->runScopeUpdate();
 }
 
@@ -1,7 +1,12 @@
 // NeoVACDM.h
 #pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <list>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <thread>
 
 #include <NeoRadarSDK/SDK.h>
@@ -20,6 +25,9 @@ class NeoVACDMCommandProvider;
 class NeoVACDM : public BasePlugin
 {
 public:
+    /// @brief progress of the handshake with the backend
+    enum class ConnectionState { Disconnected, Probing, Configured, Ready };
+
     NeoVACDM();
     ~NeoVACDM();
 
@@ -43,8 +51,16 @@ public:
     core::DataManager* GetDataManager() const { return dataManager_.get(); }
     com::Server* GetServer() const { return server_.get(); }
     logging::Logger* GetLogger() const { return vacdmLogger_.get(); }
+    ConnectionState GetConnectionState() const { return m_connectionState; }
 
-    std::pair<bool, std::string> newVersionAvailable();    
+    /// @brief Checks if a newer release is published on GitHub, the latest release is cached on disk for a while
+    /// @return true and the latest version if the plugin is outdated
+    std::pair<bool, std::string> newVersionAvailable();
+    /// @brief Shows the latency percentiles, errors and transferred bytes of the backend requests in the chat
+    void displayStatistics();
+    /// @brief Writes the backend request statistics as JSON into the plugin directory
+    /// @return path of the written file, empty if it could not be written
+    std::string dumpStatistics();
 
     std::string helpCommandId_;
     std::string masterCommandId_;
@@ -53,6 +69,7 @@ public:
     std::string logCommandId_;
     std::string loglevelCommandId_;
     std::string updaterateCommandId_;    
+    std::string statsCommandId_;
 #ifdef DEV
     std::string purgeCommandId_;
 #endif
@@ -81,7 +98,8 @@ private:
     void changeServerUrl(const std::string &url);
 
     void runScopeUpdate();
-    void checkServerConfiguration();
+    /// @brief Starts the handshake with the backend in the background, a running handshake is restarted
+    void startHandshake();
 
     void RegisterTagItems();
     void RegisterTagActions();
@@ -126,6 +144,46 @@ private:
     bool m_stop;
     void run();
 
+    /// @brief runs the update check in the background, plugin loading does not wait for GitHub
+    std::thread m_updateChecker;
+    /// @brief guards the client and the cancellation of the update check
+    std::mutex m_updateCheckLock;
+    /// @brief connection of the running update check, it is stopped if the plugin shuts down
+    httplib::ClientImpl *m_updateCheckClient = nullptr;
+    bool m_updateCheckCancelled = false;
+
+    /// @brief chat message of a background thread, the messages are shown by the timer
+    struct PendingMessage {
+        std::string message;
+        bool dedicated;
+        std::string sender;
+        bool important;
+    };
+    std::mutex m_pendingMessagesLock;
+    std::list<PendingMessage> m_pendingMessages;
+    /// @brief Queues a chat message of a background thread, it is shown by the next OnTimer
+    void postMessage(const std::string &message, bool dedicated = true, const std::string &sender = "",
+                     bool important = false);
+    void displayPendingMessages();
+
+    /// @brief checks the API version, requests the server configuration and the supported airports
+    std::thread m_handshake;
+    std::mutex m_handshakeLock;
+    std::condition_variable m_handshakeCondition;
+    bool m_handshakeRequested = false;
+    std::atomic<ConnectionState> m_connectionState = ConnectionState::Disconnected;
+    /// @brief waits for requested handshakes, a failed handshake is retried with an increasing delay
+    void runHandshake();
+    /// @brief returns false if the backend was not reachable, a cancelled handshake counts as done
+    bool performHandshake();
+    static std::chrono::seconds handshakeRetryDelay(int failedAttempts);
+    /// @brief checks if the running handshake is outdated because a new one was requested or the plugin stops
+    bool handshakeCancelled();
+    void setConnectionState(ConnectionState state);
+    void checkForUpdates();
+    /// @brief reads the latest release from the update cache file if it is not outdated
+    std::optional<std::string> cachedLatestVersion(const std::string &path);
+
     std::shared_ptr<NeoVACDMCommandProvider> CommandProvider_;
 };
 
@@ -35,6 +35,21 @@ bool ConfigParser::parseColor(const std::string &block, std::array<unsigned int,
     return true;
 }
 
+bool ConfigParser::parseBoolean(const std::string &block, bool &value, std::uint32_t line) {
+    if ("true" == block || "1" == block) {
+        value = true;
+        return true;
+    }
+    if ("false" == block || "0" == block) {
+        value = false;
+        return true;
+    }
+
+    this->m_errorLine = line;
+    this->m_errorMessage = "Value must be true or false";
+    return false;
+}
+
 bool ConfigParser::parse(const std::string &filename, PluginConfig &config) {
     config.valid = true;
 
@@ -98,6 +113,46 @@ bool ConfigParser::parse(const std::string &filename, PluginConfig &config) {
                 this->m_errorLine = lineOffset;
             }
 
+        } else if ("SERVER_parallelRequests" == values[0]) {
+            try {
+                const int parallelRequests = std::stoi(values[1]);
+                if (parallelRequests < com::minParallelRequests || parallelRequests > com::maxParallelRequests) {
+                    this->m_errorLine = lineOffset;
+                    this->m_errorMessage = "Value must be number between " +
+                                           std::to_string(com::minParallelRequests) + " and " +
+                                           std::to_string(com::maxParallelRequests);
+                } else {
+                    config.parallelRequests = parallelRequests;
+                    parsed = true;
+                }
+            } catch (const std::exception &e) {
+                this->m_errorMessage = e.what();
+                this->m_errorLine = lineOffset;
+            }
+        } else if ("SERVER_incrementalSync" == values[0]) {
+            parsed = this->parseBoolean(values[1], config.incrementalSync, lineOffset);
+        } else if ("SERVER_pushUpdates" == values[0]) {
+            parsed = this->parseBoolean(values[1], config.pushUpdates, lineOffset);
+        } else if ("SERVER_batchRequests" == values[0]) {
+            parsed = this->parseBoolean(values[1], config.batchRequests, lineOffset);
+        } else if ("SERVER_compressResponses" == values[0]) {
+            parsed = this->parseBoolean(values[1], config.compressResponses, lineOffset);
+        } else if ("SERVER_compressRequests" == values[0]) {
+            parsed = this->parseBoolean(values[1], config.compressRequests, lineOffset);
+        } else if ("SERVER_compressionThreshold" == values[0]) {
+            try {
+                const int compressionThreshold = std::stoi(values[1]);
+                if (compressionThreshold < 0) {
+                    this->m_errorLine = lineOffset;
+                    this->m_errorMessage = "Value must be a positive number of bytes";
+                } else {
+                    config.compressionThreshold = compressionThreshold;
+                    parsed = true;
+                }
+            } catch (const std::exception &e) {
+                this->m_errorMessage = e.what();
+                this->m_errorLine = lineOffset;
+            }
         } else if ("COLOR_lightgreen" == values[0]) {
             parsed = this->parseColor(values[1], config.lightgreen, lineOffset);
         } else if ("COLOR_lightblue" == values[0]) {
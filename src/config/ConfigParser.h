@@ -13,6 +13,7 @@ class ConfigParser {
     std::uint32_t m_errorLine;  /* Defines the line number the error has occurred */
     std::string m_errorMessage; /* The error message to print */
     bool parseColor(const std::string &block, std::array<unsigned int, 3> &color, std::uint32_t line);
+    bool parseBoolean(const std::string &block, bool &value, std::uint32_t line);
 
    public:
     ConfigParser();
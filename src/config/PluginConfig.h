@@ -9,6 +9,13 @@ struct PluginConfig {
     bool valid = true;
     std::string serverUrl = "https://app.vacdm.net";
     int updateCycleSeconds = 5;
+    int parallelRequests = 4;
+    bool incrementalSync = false;
+    bool pushUpdates = false;
+    bool batchRequests = false;
+    bool compressResponses = true;
+    bool compressRequests = false;
+    int compressionThreshold = 1024;
     std::array<unsigned int, 3> lightgreen = std::array<unsigned int, 3>({127, 252, 73});
     std::array<unsigned int, 3> lightblue = std::array<unsigned int, 3>({53, 218, 235});
     std::array<unsigned int, 3> green = std::array<unsigned int, 3>({0, 181, 27});
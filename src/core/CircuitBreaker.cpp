@@ -0,0 +1,79 @@
+#include "CircuitBreaker.h"
+
+#include <algorithm>
+
+using namespace vacdm::com;
+
+CircuitBreaker::CircuitBreaker(std::size_t failureThreshold, std::chrono::milliseconds openDuration,
+                               std::chrono::milliseconds maxOpenDuration)
+    : m_lock(),
+      m_state(State::Closed),
+      m_failures(0),
+      m_failureThreshold(failureThreshold),
+      m_initialOpenDuration(openDuration),
+      m_openDuration(openDuration),
+      m_maxOpenDuration(maxOpenDuration),
+      m_openUntil() {}
+
+CircuitBreaker::Decision CircuitBreaker::acquire() {
+    std::lock_guard guard(m_lock);
+
+    switch (m_state) {
+        case State::Closed:
+            return Decision::Send;
+        case State::Open:
+            if (std::chrono::steady_clock::now() < m_openUntil) return Decision::Reject;
+            // the caller probes the backend, all others are rejected until the probe is finished
+            m_state = State::HalfOpen;
+            return Decision::Probe;
+        default:
+            return Decision::Reject;
+    }
+}
+
+void CircuitBreaker::recordSuccess() {
+    std::lock_guard guard(m_lock);
+
+    m_state = State::Closed;
+    m_failures = 0;
+    m_openDuration = m_initialOpenDuration;
+}
+
+bool CircuitBreaker::recordFailure() {
+    std::lock_guard guard(m_lock);
+
+    const auto now = std::chrono::steady_clock::now();
+    switch (m_state) {
+        case State::HalfOpen:
+            // the backend is still unreachable, wait longer before the next probe
+            m_openDuration = std::min(m_openDuration * 2, m_maxOpenDuration);
+            this->open(now);
+            return true;
+        case State::Closed:
+            m_failures += 1;
+            if (m_failures < m_failureThreshold) return false;
+            this->open(now);
+            return true;
+        default:
+            return false;
+    }
+}
+
+CircuitBreaker::State CircuitBreaker::state() {
+    std::lock_guard guard(m_lock);
+    return m_state;
+}
+
+void CircuitBreaker::reset() {
+    std::lock_guard guard(m_lock);
+
+    m_state = State::Closed;
+    m_failures = 0;
+    m_openDuration = m_initialOpenDuration;
+}
+
+void CircuitBreaker::open(const std::chrono::steady_clock::time_point& now) {
+    m_state = State::Open;
+    m_failures = 0;
+    m_openUntil = now + m_openDuration;
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <mutex>
+
+namespace vacdm::com {
+/// @brief Stops the requests to the backend while it is unreachable
+///
+/// The breaker opens after a number of consecutive failures and rejects all requests until the open duration has
+/// passed. Afterwards a single caller is allowed to probe the backend (half-open). A successful probe closes the
+/// breaker, a failed probe opens it again with a doubled open duration.
+class CircuitBreaker {
+   public:
+    enum class State { Closed, Open, HalfOpen };
+
+    /// @brief what the caller has to do with its request
+    enum class Decision {
+        /// @brief send the request
+        Send,
+        /// @brief probe the backend before the request is sent
+        Probe,
+        /// @brief fail the request without sending it
+        Reject,
+    };
+
+    CircuitBreaker(std::size_t failureThreshold, std::chrono::milliseconds openDuration,
+                   std::chrono::milliseconds maxOpenDuration);
+
+    Decision acquire();
+    void recordSuccess();
+    /// @brief counts a failed request
+    /// @return true if the breaker opened because of the failure
+    bool recordFailure();
+    State state();
+    /// @brief closes the breaker, used after the backend address changed
+    void reset();
+
+   private:
+    void open(const std::chrono::steady_clock::time_point& now);
+
+    std::mutex m_lock;
+    State m_state;
+    std::size_t m_failures;
+    std::size_t m_failureThreshold;
+    std::chrono::milliseconds m_initialOpenDuration;
+    std::chrono::milliseconds m_openDuration;
+    std::chrono::milliseconds m_maxOpenDuration;
+    std::chrono::steady_clock::time_point m_openUntil;
+};
+}  // namespace vacdm::com
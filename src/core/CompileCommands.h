@@ -94,6 +94,18 @@ void NeoVACDM::RegisterCommand() {
         definition.parameters.push_back(parameter);
 
         updaterateCommandId_ = chatAPI_->registerCommand(definition.name, definition, CommandProvider_);        
+
+        definition.name = "vacdm stats";
+        definition.description = "Show the vACDM backend request statistics";
+        definition.lastParameterHasSpaces = false;
+		definition.parameters.clear();
+
+        parameter.name = "FORMAT";
+        parameter.type = Chat::ParameterType::String; 
+        parameter.required = false;
+        definition.parameters.push_back(parameter);
+
+        statsCommandId_ = chatAPI_->registerCommand(definition.name, definition, CommandProvider_);
   
 #ifdef DEV
         definition.name = "vacdm purge";
@@ -126,6 +138,7 @@ inline void NeoVACDM::unRegisterCommand()
         chatAPI_->unregisterCommand(logCommandId_);
         chatAPI_->unregisterCommand(loglevelCommandId_);
         chatAPI_->unregisterCommand(updaterateCommandId_);
+        chatAPI_->unregisterCommand(statsCommandId_);
 #ifdef DEV
         chatAPI_->unregisterCommand(purgeCommandId_);
 #endif        
@@ -145,6 +158,7 @@ Chat::CommandResult NeoVACDMCommandProvider::Execute(
         neoVACDM_->DisplayMessage(".vacdm log (ON/OFF/DEBUG)");
         neoVACDM_->DisplayMessage(".vacdm loglevel (vACDM/DataManager/Server/ConfigParser/Utils) (DEBUG/INFO/WARNING/ERROR/CRITICAL/SYSTEM/DISABLED)");
         neoVACDM_->DisplayMessage(".vacdm updaterate (1-10)");
+        neoVACDM_->DisplayMessage(".vacdm stats (JSON)");
     }
     else if (commandId == neoVACDM_->masterCommandId_) {
         std::string userIsNotEligibleMessage;
@@ -157,10 +171,12 @@ Chat::CommandResult NeoVACDMCommandProvider::Execute(
             userIsInSweatbox = (*connectionInfo).serverType == Fsd::ServerType::Sweatbox;
             userIsObserver = (*connectionInfo).facility == Fsd::NetworkFacility::OBS;
         }
+        // served from the cache, the command does not wait for the backend
+        const auto serverConfig = neoVACDM_->GetServer()->getServerConfig();
 #ifndef DEV
-        bool serverAllowsObsAsMaster = neoVACDM_->GetServer()->getServerConfig().allowMasterAsObserver;
+        bool serverAllowsObsAsMaster = serverConfig.allowMasterAsObserver;
 #endif // !DEV
-        bool serverAllowsSweatboxAsMaster = neoVACDM_->GetServer()->getServerConfig().allowMasterInSweatbox;
+        bool serverAllowsSweatboxAsMaster = serverConfig.allowMasterInSweatbox;
 
         if (!connectionInfo || !userIsConnected) {
             userIsNotEligibleMessage = "You are not logged in to the VATSIM network";
@@ -216,6 +232,25 @@ Chat::CommandResult NeoVACDMCommandProvider::Execute(
             return {false, error};
         }
         neoVACDM_->DisplayMessage(neoVACDM_->GetDataManager()->setUpdateCycleSeconds(std::stoi(updaterate)));
+    } else if (commandId == neoVACDM_->statsCommandId_) {
+        std::string format = true == args.empty() ? "" : args[0];
+        std::transform(format.begin(), format.end(), format.begin(), ::toupper);
+
+        if (true == format.empty()) {
+            neoVACDM_->displayStatistics();
+        } else if ("JSON" == format) {
+            const auto path = neoVACDM_->dumpStatistics();
+            if (true == path.empty()) {
+                std::string error = "Failed to write the statistics";
+                neoVACDM_->DisplayMessage(error, false);
+                return {false, error};
+            }
+            neoVACDM_->DisplayMessage("Statistics written to " + path);
+        } else {
+            std::string error = "Usage: .vacdm stats (JSON)";
+            neoVACDM_->DisplayMessage(error, false);
+            return {false, error};
+        }
     }    
 #ifdef DEV
     else if (commandId == neoVACDM_->purgeCommandId_) {
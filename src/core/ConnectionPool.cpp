@@ -0,0 +1,100 @@
+#include "ConnectionPool.h"
+
+#include "Version.h"
+
+using namespace vacdm::com;
+
+ConnectionPool::Lease::Lease(ConnectionPool* pool, std::unique_ptr<httplib::Client> client, std::uint64_t generation)
+    : m_pool(pool), m_client(std::move(client)), m_generation(generation) {}
+
+ConnectionPool::Lease::Lease(Lease&& other) noexcept
+    : m_pool(other.m_pool), m_client(std::move(other.m_client)), m_generation(other.m_generation) {}
+
+ConnectionPool::Lease::~Lease() {
+    if (m_client) m_pool->release(std::move(m_client), m_generation);
+}
+
+ConnectionPool::ConnectionPool(std::size_t maxIdleConnections, std::chrono::seconds idleTimeout)
+    : m_lock(),
+      m_idleConnections(),
+      m_maxIdleConnections(maxIdleConnections),
+      m_idleTimeout(idleTimeout),
+      m_baseUrl(),
+      m_authToken(),
+      m_generation(0) {}
+
+void ConnectionPool::reset(const std::string& baseUrl, const std::string& authToken) {
+    std::lock_guard guard(m_lock);
+
+    m_baseUrl = baseUrl;
+    m_authToken = authToken;
+    // connections which are currently in use are dropped when they are handed back
+    m_generation += 1;
+    m_idleConnections.clear();
+}
+
+void ConnectionPool::setMaxIdleConnections(std::size_t maxIdleConnections) {
+    std::lock_guard guard(m_lock);
+
+    m_maxIdleConnections = maxIdleConnections;
+    while (m_idleConnections.size() > m_maxIdleConnections) m_idleConnections.pop_front();
+}
+
+ConnectionPool::Lease ConnectionPool::acquire() {
+    std::lock_guard guard(m_lock);
+
+    this->reapIdleConnections(std::chrono::steady_clock::now());
+
+    // reuse the most recently used connection, it is the most likely one to be still open
+    if (false == m_idleConnections.empty()) {
+        auto client = std::move(m_idleConnections.back().client);
+        m_idleConnections.pop_back();
+        return Lease(this, std::move(client), m_generation);
+    }
+
+    return Lease(this, this->createClient(), m_generation);
+}
+
+void ConnectionPool::release(std::unique_ptr<httplib::Client> client, std::uint64_t generation) {
+    std::lock_guard guard(m_lock);
+
+    const auto now = std::chrono::steady_clock::now();
+    this->reapIdleConnections(now);
+
+    // the address changed while the connection was in use or the pool is full
+    if (generation != m_generation || m_idleConnections.size() >= m_maxIdleConnections) return;
+
+    m_idleConnections.push_back({std::move(client), now});
+}
+
+void ConnectionPool::reapIdleConnections(const std::chrono::steady_clock::time_point& now) {
+    // the list is ordered by the last usage, the oldest connections are in front
+    while (false == m_idleConnections.empty() && now - m_idleConnections.front().lastUsed > m_idleTimeout)
+        m_idleConnections.pop_front();
+}
+
+std::unique_ptr<httplib::Client> ConnectionPool::createClient() const {
+    auto client = std::make_unique<httplib::Client>(m_baseUrl);
+
+    // Configure client settings similar to curl options
+    client->set_connection_timeout(2);
+    client->set_read_timeout(5);
+    client->set_write_timeout(5);
+    client->set_keep_alive(true);
+    // compressed responses are decompressed by Server::request which collects the statistics
+    client->set_decompress(false);
+
+    client->enable_server_certificate_verification(false);
+    client->enable_server_hostname_verification(false);
+
+    // Set default headers
+    client->set_default_headers({{"Accept", "application/json"}, {"Content-Type", "application/json"},
+                                 {"User-Agent", "VACDM Plugin Neo/" + std::string(PLUGIN_VERSION)}});
+
+    // Add authorization if token is available
+    if (!m_authToken.empty()) {
+        client->set_bearer_token_auth(m_authToken);
+    }
+
+    return client;
+}
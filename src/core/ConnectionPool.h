@@ -0,0 +1,69 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "core/Http.h"
+
+namespace vacdm::com {
+/// @brief Keeps a small set of persistent keep-alive connections to the backend
+///
+/// Every request checks out its own connection, so concurrent requests do not wait on each other.
+/// Connections are handed back after the request and reused by the next request, which avoids new TLS
+/// handshakes. Connections that have not been used for the idle timeout are closed.
+class ConnectionPool {
+   public:
+    /// @brief RAII handle of a checked out connection, hands the connection back to the pool on destruction
+    class Lease {
+       public:
+        Lease(ConnectionPool* pool, std::unique_ptr<httplib::Client> client, std::uint64_t generation);
+        Lease(Lease&& other) noexcept;
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+        Lease& operator=(Lease&&) = delete;
+        ~Lease();
+
+        httplib::Client* operator->() const { return m_client.get(); }
+        httplib::Client& operator*() const { return *m_client; }
+
+       private:
+        ConnectionPool* m_pool;
+        std::unique_ptr<httplib::Client> m_client;
+        std::uint64_t m_generation;
+    };
+
+    ConnectionPool(std::size_t maxIdleConnections, std::chrono::seconds idleTimeout);
+
+    /// @brief Drops all pooled connections and uses the new address for upcoming connections
+    /// @param baseUrl address of the backend
+    /// @param authToken bearer token, ignored if empty
+    void reset(const std::string& baseUrl, const std::string& authToken);
+    /// @brief Checks out an idle connection or creates a new one if all connections are in use
+    Lease acquire();
+    /// @brief Sets the number of connections which are kept alive
+    void setMaxIdleConnections(std::size_t maxIdleConnections);
+
+   private:
+    struct IdleConnection {
+        std::unique_ptr<httplib::Client> client;
+        std::chrono::steady_clock::time_point lastUsed;
+    };
+
+    std::mutex m_lock;
+    std::list<IdleConnection> m_idleConnections;
+    std::size_t m_maxIdleConnections;
+    std::chrono::seconds m_idleTimeout;
+    std::string m_baseUrl;
+    std::string m_authToken;
+    std::uint64_t m_generation;
+
+    std::unique_ptr<httplib::Client> createClient() const;
+    void release(std::unique_ptr<httplib::Client> client, std::uint64_t generation);
+    /// @brief closes all connections that exceeded the idle timeout, requires m_lock
+    void reapIdleConnections(const std::chrono::steady_clock::time_point& now);
+};
+}  // namespace vacdm::com
@@ -1,5 +1,8 @@
 #include "DataManager.h"
 
+#include <string_view>
+#include <unordered_map>
+
 #include "utils/Date.h"
 
 using namespace vacdm::com;
@@ -13,61 +16,144 @@ static constexpr std::size_t ConsolidatedData = 0;
 static constexpr std::size_t ScopeData = 1;
 static constexpr std::size_t ServerData = 2;
 
-DataManager::DataManager(com::Server* server, logging::Logger* logger) 
-     : m_pause(false), m_stop(false), server_(server), vacdmLogger_(logger) 
-     { this->m_worker = std::thread(&DataManager::run, this); }
+DataManager::DataManager(com::Server* server, logging::Logger* logger)
+    : m_pause(false),
+      m_stop(false),
+      server_(server),
+      vacdmLogger_(logger),
+      m_activeAirports(std::make_shared<const ActiveAirports>()),
+      m_clearGeneration(0),
+      m_scopeFlightplanUpdates(scopeUpdateQueueCapacity),
+      m_asynchronousMessages(outboxQueueCapacity) {
+    this->m_worker = std::thread(&DataManager::run, this);
+    this->m_sender = std::thread(&DataManager::runSender, this);
+}
 
 DataManager::~DataManager() {
-    this->m_stop = true;
+    {
+        std::lock_guard guard(this->m_asyncMessagesLock);
+        this->m_stop = true;
+    }
+    this->m_asyncMessagesCondition.notify_all();
+
     this->m_worker.join();
+    this->m_sender.join();
 }
 
 bool DataManager::checkPilotExists(const std::string& callsign) {
     if (true == this->m_pause) return false;
 
-    std::lock_guard guard(this->m_pilotLock);
-    return this->m_pilots.cend() != this->m_pilots.find(callsign);
+    const auto snapshot = this->m_pilots.snapshot();
+    return snapshot->pilots.cend() != snapshot->pilots.find(callsign);
 }
 
 const types::Pilot DataManager::getPilot(const std::string& callsign) {
-    std::lock_guard guard(this->m_pilotLock);
-    return this->m_pilots.find(callsign)->second[ConsolidatedData];
+    const auto snapshot = this->m_pilots.snapshot();
+    const auto it = snapshot->pilots.find(callsign);
+    if (snapshot->pilots.cend() == it) return types::Pilot();
+
+    return (*it->second)[ConsolidatedData];
+}
+
+const types::TagCaches DataManager::getTagCaches(const std::string& callsign) {
+    std::lock_guard guard(this->m_tagCacheLock);
+
+    const auto caches = this->m_tagCaches.find(callsign);
+    if (this->m_tagCaches.cend() == caches) return types::TagCaches();
+    return caches->second;
 }
 
 std::vector<std::string> DataManager::getPilots() {
-    this->m_pilotLock.lock();
-    auto pilotMaps = this->m_pilots;
-    this->m_pilotLock.unlock();
-    
-    std::vector<std::string> pilots;
+    const auto snapshot = this->m_pilots.snapshot();
 
-    for (auto& pilotMap : pilotMaps)
-        pilots.push_back(pilotMap.second[ConsolidatedData].callsign);
+    std::vector<std::string> pilots;
+    pilots.reserve(snapshot->pilots.size());
+    for (const auto& pilot : snapshot->pilots) pilots.push_back(pilot.first);
 
     return pilots;
 }
 
+std::shared_ptr<const PilotSnapshotStore::Snapshot> DataManager::pilotSnapshot() { return this->m_pilots.snapshot(); }
+
 
 void DataManager::pause() { this->m_pause = true; }
 
-void DataManager::resume() { this->m_pause = false; }
+void DataManager::resume() {
+    {
+        std::lock_guard guard(this->m_asyncMessagesLock);
+        this->m_pause = false;
+    }
+    // the sender keeps the queued messages while paused, it continues right away
+    this->m_asyncMessagesCondition.notify_all();
+}
 
 void DataManager::clearAllPilotData() {
-    std::lock_guard guard(this->m_pilotLock);
     this->m_pilots.clear();
 
-    // Also clear any pending updates
-    std::lock_guard guardUpdates(this->m_scopeUpdatesLock);
-    this->m_scopeFlightplanUpdates.clear();
+    {
+        std::lock_guard guard(this->m_tagCacheLock);
+        this->m_tagCaches.clear();
+    }
 
-    // Clear any pending messages
-    std::lock_guard guardMessages(this->m_asyncMessagesLock);
-    this->m_asynchronousMessages.clear();
+    // Also discard any pending updates and messages, they are dropped by the worker and the sender when they are
+    // taken. The journaled controller actions belong to the cleared pilots and must not be replayed either.
+    this->m_clearGeneration.fetch_add(1);
+    this->m_outboxJournal.discard();
 
     if (vacdmLogger_)
         vacdmLogger_->log(Logger::LogSender::DataManager, "All pilot data cleared", Logger::LogLevel::Info);
 }
 
+DataManager::OutboxStatistics DataManager::outboxStatistics() {
+    const auto queueStatistics = this->m_asynchronousMessages.statistics();
+
+    std::lock_guard guard(this->m_asyncMessagesLock);
+
+    auto statistics = this->m_outboxStatistics;
+    statistics.queueDepth = this->m_asynchronousMessages.size();
+    statistics.droppedMessages = static_cast<std::size_t>(queueStatistics.dropped);
+    statistics.contendedEnqueues = static_cast<std::size_t>(queueStatistics.contended);
+    statistics.journaledMessages = this->m_outboxJournal.pendingEntries();
+    return statistics;
+}
+
+bool DataManager::openOutboxJournal(const std::string& path) {
+    const auto opened = this->m_outboxJournal.open(path, outboxJournalMaxAge);
+
+    if (vacdmLogger_)
+        vacdmLogger_->log(Logger::LogSender::DataManager,
+                           true == opened ? "Opened outbox journal " + path + " with " +
+                                                std::to_string(this->m_outboxJournal.pendingEntries()) +
+                                                " pending actions"
+                                          : "Failed to open outbox journal " + path,
+                           Logger::LogLevel::Info);
+    return opened;
+}
+
+void DataManager::replayOutboxJournal() {
+    auto entries = this->m_outboxJournal.takeReplayEntries();
+
+    for (auto& entry : entries) {
+        const auto type = static_cast<MessageType>(entry.type);
+
+        if (vacdmLogger_)
+            vacdmLogger_->log(Logger::LogSender::DataManager,
+                               "Replaying " + std::to_string(entry.ids.size()) + " journaled actions of " +
+                                   entry.callsign,
+                               Logger::LogLevel::Info);
+
+        // a delete is journaled without content, all other actions are patches
+        this->queueMessage({.type = true == entry.message.is_null() ? MessageType::ResetPilot : type,
+                            .callsign = entry.callsign,
+                            .value = entry.value,
+                            .pilot = types::Pilot(),
+                            .message = std::move(entry.message),
+                            .queuedAt = std::chrono::steady_clock::now(),
+                            .description = DataManager::messageTypeDescription(type) + " (replayed)",
+                            .journalIds = std::move(entry.ids)});
+    }
+}
+
 std::string DataManager::setUpdateCycleSeconds(const int newUpdateCycleSeconds) {
     if (newUpdateCycleSeconds < minUpdateCycleSeconds || newUpdateCycleSeconds > maxUpdateCycleSeconds)
         return "Could not set update rate";
@@ -83,38 +169,46 @@ void DataManager::run() {
     while (true) {
         std::this_thread::sleep_for(1s);
         if (true == this->m_stop) return;
+
+        // keep the queue of the Scope updates short, the updates are applied in the update cycle
+        this->takeScopeUpdates();
         if (true == this->m_pause) continue;
 
-        // run every updateCycleSeconds seconds
-        if (counter++ % updateCycleSeconds != 0) continue;
+        // the changes of the subscribed pilot events are applied immediately, polling is only the fallback
+        const bool pilotEventsConnected = server_ && true == server_->pilotEventsConnected();
+        if (true == pilotEventsConnected) this->applyPilotEvents(server_->takePilotEvents());
 
-        // obtain a copy of the pilot data, work with the copy to minimize lock time
-        this->m_pilotLock.lock();
-        auto pilots = this->m_pilots;
-        this->m_pilotLock.unlock();
+        // run every updateCycleSeconds seconds, or every pilotEventsPollInterval while the events are received
+        const auto cycleSeconds = true == pilotEventsConnected ? static_cast<int>(pilotEventsPollInterval.count())
+                                                               : updateCycleSeconds;
+        if (counter++ % cycleSeconds != 0) continue;
 
-        this->processAsynchronousMessages(pilots);
+        // each step changes the pilots in a short transaction, the tag functions and the pilot events are not
+        // blocked while the backend is requested
+        this->m_pilots.update([this](PilotSnapshotStore::Pilots& pilots) { this->processScopeUpdates(pilots); });
 
-        this->processScopeUpdates(pilots);
+        this->consolidateWithBackend();
 
-        this->consolidateWithBackend(pilots);
+        const auto snapshot = this->m_pilots.snapshot();
+        this->removeStaleTagCaches(*snapshot);
 
         if (server_) {
             if (true == server_->getMaster()) {
-                std::list<std::tuple<types::Pilot, DataManager::MessageType, nlohmann::json>> transmissionBuffer;
-                for (auto& pilot : pilots) {
+                // send the controller actions again which were not delivered before
+                this->replayOutboxJournal();
+
+                // hand the deltas over to the sender, the update cycle does not wait for the backend
+                for (const auto& [callsign, pilot] : snapshot->pilots) {
                     nlohmann::json message;
-                    const auto sendType = DataManager::deltaScopeToBackend(pilot.second, message);
+                    const auto sendType = DataManager::deltaScopeToBackend(*pilot, message);
                     if (MessageType::None != sendType)
-                        transmissionBuffer.push_back({pilot.second[ConsolidatedData], sendType, message});
-                }
-
-                for (const auto& transmission : std::as_const(transmissionBuffer)) {
-                    if (std::get<1>(transmission) == MessageType::Post)
-                        server_->postPilot(std::get<0>(transmission));
-                    else if (std::get<1>(transmission) == MessageType::Patch)
-                        server_->sendPatchMessage("/api/v1/pilots/" + std::get<0>(transmission).callsign,
-                                                                std::get<2>(transmission));
+                        this->queueMessage({.type = sendType,
+                                            .callsign = callsign,
+                                            .value = types::defaultTime,
+                                            .pilot = (*pilot)[ConsolidatedData],
+                                            .message = std::move(message),
+                                            .queuedAt = std::chrono::steady_clock::now(),
+                                            .description = DataManager::messageTypeDescription(sendType)});
                 }
             }
         }
@@ -124,214 +218,436 @@ void DataManager::run() {
                 vacdmLogger_->log(Logger::LogSender::DataManager, "No server instance available 3", Logger::LogLevel::Info);
         }
 #endif
+    }
+}
+
+void DataManager::runSender() {
+    while (true) {
+        std::unique_lock lock(this->m_asyncMessagesLock);
+        this->m_asyncMessagesCondition.wait_for(
+            lock, 1s, [this]() { return true == this->m_stop || false == this->m_asynchronousMessages.empty(); });
 
-        // replace the pilot data with the updated copy
-        this->m_pilotLock.lock();
-        this->m_pilots = pilots;
-        this->m_pilotLock.unlock();
+        if (true == this->m_stop) return;
+        if (true == this->m_pause) {
+            // keep the messages until the data manager is resumed
+            this->m_asyncMessagesCondition.wait_for(
+                lock, 1s, [this]() { return true == this->m_stop || false == this->m_pause; });
+            continue;
+        }
+        if (true == this->m_asynchronousMessages.empty()) continue;
+
+        // give a single controller action the chance to queue all of its messages, they are sent as one patch
+        this->m_asyncMessagesCondition.wait_for(lock, outboxCoalescingDelay, [this]() { return true == this->m_stop; });
+        if (true == this->m_stop) return;
+        lock.unlock();
+
+        // take the queued messages, new messages can be queued while the messages are sent
+        std::list<AsynchronousMessage> messages;
+        this->takeAsynchronousMessages(messages);
+        if (false == messages.empty()) this->processAsynchronousMessages(messages);
     }
 }
 
-void DataManager::processAsynchronousMessages(std::map<std::string, std::array<types::Pilot, 3U>>& pilots) {
-    this->m_asyncMessagesLock.lock();
-    auto messages = this->m_asynchronousMessages;
-    this->m_asynchronousMessages.clear();
-    this->m_asyncMessagesLock.unlock();
+void DataManager::queueMessage(AsynchronousMessage&& message) {
+    message.generation = this->m_clearGeneration.load();
 
-    for (auto& message : messages) {
-        // find pilot in list
-        for (auto& [callsign, data] : pilots) {
-            if (callsign == message.callsign) {
-                std::string messageType;
-
-                if (server_) {
-                    switch (message.type) {
-                        case MessageType::UpdateEXOT:
-                            server_->updateExot(message.callsign, message.value);
-                            messageType = "EXOT";
-                            break;
-                        case MessageType::UpdateTOBT:
-                            server_->updateTobt(data[ConsolidatedData], message.value, false);
-                            messageType = "TOBT";
-                            break;
-                        case MessageType::UpdateTOBTConfirmed:
-                            server_->updateTobt(data[ConsolidatedData], message.value, true);
-                            messageType = "TOBT Confirmed Status";
-                            break;
-                        case MessageType::UpdateASAT:
-                            server_->updateAsat(message.callsign, message.value);
-                            messageType = "ASAT";
-                            break;
-                        case MessageType::UpdateASRT:
-                            server_->updateAsrt(message.callsign, message.value);
-                            messageType = "ASRT";
-                            break;
-                        case MessageType::UpdateAOBT:
-                            server_->updateAobt(message.callsign, message.value);
-                            messageType = "AOBT";
-                            break;
-                        case MessageType::UpdateAORT:
-                            server_->updateAort(message.callsign, message.value);
-                            messageType = "AORT";
-                            break;
-                        case MessageType::ResetTOBT:
-                            server_->resetTobt(message.callsign, types::defaultTime,
-                                                        data[ConsolidatedData].tobt_state);
-                            messageType = "TOBT reset";
-                            break;
-                        case MessageType::ResetASAT:
-                            server_->updateAsat(message.callsign, message.value);
-                            messageType = "ASAT reset";
-                            break;
-                        case MessageType::ResetASRT:
-                            server_->updateAsrt(message.callsign, message.value);
-                            messageType = "ASRT reset";
-                            break;
-                        case MessageType::ResetTOBTConfirmed:
-                            server_->resetTobt(message.callsign, data[ConsolidatedData].tobt, "GUESS");
-                            messageType = "TOBT confirmed reset";
-                            break;
-                        case MessageType::ResetAORT:
-                            server_->updateAort(message.callsign, message.value);
-                            messageType = "AORT reset";
-                            break;
-                        case MessageType::ResetAOBT:
-                            server_->updateAobt(message.callsign, message.value);
-                            messageType = "AOBT reset";
-                            break;
-                        case MessageType::ResetPilot:
-                            server_->deletePilot(message.callsign);
-                            messageType = "Pilot reset";
-                            break;
-
-                        default:
-                            break;
-                    }
-                }
-#ifdef DEV
-                else {
-                    if (vacdmLogger_)
-                        vacdmLogger_->log(Logger::LogSender::DataManager, "No server instance available 4", Logger::LogLevel::Info);
-                }
-#endif
+    if (false == this->m_asynchronousMessages.push(std::move(message))) {
+        // the message is unchanged if it was not queued, the controller actions are replayed from the journal
+        this->m_outboxJournal.reject(message.journalIds);
+
+        if (vacdmLogger_)
+            vacdmLogger_->log(Logger::LogSender::DataManager,
+                               "Outbox full, dropped " + message.description + " update: " + message.callsign,
+                               Logger::LogLevel::Warning);
+        return;
+    }
 
-                if (vacdmLogger_)
-                    vacdmLogger_->log(Logger::LogSender::DataManager,
-                                       "Sending " + messageType + " update: " + callsign + " - " +
-                                           utils::Date::timestampToIsoString(message.value),
-                                       Logger::LogLevel::Info);
+    // the sender checks the queue while it holds the lock, it cannot miss the notification after the lock was taken
+    { std::lock_guard guard(this->m_asyncMessagesLock); }
+    this->m_asyncMessagesCondition.notify_one();
+}
 
-                break;
+void DataManager::takeAsynchronousMessages(std::list<AsynchronousMessage>& messages) {
+    const auto generation = this->m_clearGeneration.load();
+
+    // queued scope delta (post or patch) of every pilot, replaced by newer deltas of the pilot
+    std::unordered_map<std::string, std::list<AsynchronousMessage>::iterator> pendingScopeDeltas;
+
+    this->m_asynchronousMessages.drain([&](AsynchronousMessage&& message) {
+        // the message was queued before all pilot data was cleared, its actions are confirmed so that they are
+        // not replayed
+        if (generation != message.generation) {
+            this->m_outboxJournal.acknowledge(message.journalIds);
+            return;
+        }
+
+        // a newer scope delta supersedes a delta of the same pilot which has not been sent yet
+        const bool scopeDelta = MessageType::Post == message.type || MessageType::Patch == message.type;
+        if (true == scopeDelta) {
+            const auto pending = pendingScopeDeltas.find(message.callsign);
+            if (pendingScopeDeltas.end() != pending) {
+                auto& it = pending->second;
+                if (MessageType::Post == it->type) message.type = MessageType::Post;
+                *it = std::move(message);
+                return;
             }
         }
+
+        messages.push_back(std::move(message));
+        if (true == scopeDelta) {
+            const auto queued = std::prev(messages.end());
+            pendingScopeDeltas.insert({queued->callsign, queued});
+        }
+    });
+}
+
+void DataManager::processAsynchronousMessages(std::list<AsynchronousMessage>& messages) {
+    const auto queuedMessages = messages.size();
+    this->coalesceMessages(messages);
+
+    std::chrono::milliseconds maxLatency(0);
+
+    const auto results = this->sendMessages(messages);
+    auto result = results.begin();
+
+    for (auto& message : messages) {
+        const bool sent = *result++;
+
+        // undelivered controller actions stay in the journal and are replayed in the next update cycle
+        if (true == sent)
+            this->m_outboxJournal.acknowledge(message.journalIds);
+        else
+            this->m_outboxJournal.reject(message.journalIds);
+
+        const auto latency =
+            std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - message.queuedAt);
+        maxLatency = std::max(maxLatency, latency);
+
+        {
+            std::lock_guard guard(this->m_asyncMessagesLock);
+            auto& statistics = this->m_outboxStatistics;
+            statistics.averageSendLatency =
+                (statistics.averageSendLatency * statistics.sentMessages + latency) / (statistics.sentMessages + 1);
+            statistics.sentMessages += 1;
+            statistics.lastSendLatency = latency;
+            statistics.maxSendLatency = std::max(statistics.maxSendLatency, latency);
+        }
+
+        if (vacdmLogger_)
+            vacdmLogger_->log(Logger::LogSender::DataManager,
+                               (true == sent ? "Sent " : "Failed to send ") + message.description +
+                                   " update: " + message.callsign + " after " +
+                                   std::to_string(latency.count()) + "ms",
+                               Logger::LogLevel::Info);
+    }
+
+    {
+        std::lock_guard guard(this->m_asyncMessagesLock);
+        this->m_outboxStatistics.coalescedMessages += queuedMessages - messages.size();
+    }
+
+    if (vacdmLogger_) {
+        const auto statistics = this->outboxStatistics();
+        vacdmLogger_->log(Logger::LogSender::DataManager,
+                           "Outbox: sent " + std::to_string(messages.size()) + " of " +
+                               std::to_string(queuedMessages) + " queued messages, max latency " +
+                               std::to_string(maxLatency.count()) + "ms, average latency " +
+                               std::to_string(statistics.averageSendLatency.count()) + "ms, queue depth " +
+                               std::to_string(statistics.queueDepth) + ", dropped " +
+                               std::to_string(statistics.droppedMessages) + ", contended enqueues " +
+                               std::to_string(statistics.contendedEnqueues),
+                           Logger::LogLevel::Info);
     }
 }
 
-void DataManager::handleTagFunction(MessageType type, const std::string callsign,
-                                    const std::chrono::system_clock::time_point value) {
-    if (!server_){
+std::vector<bool> DataManager::sendMessages(std::list<AsynchronousMessage>& messages) {
+    std::vector<bool> sent(messages.size(), false);
+    if (!server_) {
 #ifdef DEV
-    if (vacdmLogger_)
-        vacdmLogger_->log(Logger::LogSender::DataManager, "No server instance available 5", Logger::LogLevel::Info); 
+        if (vacdmLogger_)
+            vacdmLogger_->log(Logger::LogSender::DataManager, "No server instance available 4", Logger::LogLevel::Info);
 #endif
-        return;
+        return sent;
     }
-    // do not handle the tag function if the aircraft does not exist or the client is not master
-    if (false == this->checkPilotExists(callsign) || false == server_->getMaster()) return;
 
-    // queue the update message which will be sent to the backend
-    {
-        std::lock_guard guard(this->m_asyncMessagesLock);
-        this->m_asynchronousMessages.push_back({type, callsign, value});
+    const bool batched = server_->batchRequests();
+    std::vector<AsynchronousMessage*> entries;
+    for (auto& message : messages) entries.push_back(&message);
+
+    // creations and updates are collected and sent in bulk requests, the creations before the updates
+    std::vector<std::size_t> posts;
+    std::vector<std::size_t> patches;
+    const auto flush = [&]() {
+        if (false == posts.empty()) {
+            std::vector<types::Pilot> pilots;
+            for (const auto idx : posts) pilots.push_back(entries[idx]->pilot);
+
+            const auto results = server_->postPilots(pilots);
+            for (std::size_t i = 0; i < posts.size(); ++i) sent[posts[i]] = results[i];
+            posts.clear();
+        }
+        if (false == patches.empty()) {
+            std::vector<nlohmann::json> contents;
+            for (const auto idx : patches) contents.push_back(entries[idx]->message);
+
+            const auto results = server_->patchPilots(contents);
+            for (std::size_t i = 0; i < patches.size(); ++i) sent[patches[i]] = results[i];
+            patches.clear();
+        }
+    };
+
+    for (std::size_t idx = 0; idx < entries.size(); ++idx) {
+        switch (entries[idx]->type) {
+            case MessageType::Post:
+                if (true == batched)
+                    posts.push_back(idx);
+                else
+                    sent[idx] = server_->postPilot(entries[idx]->pilot);
+                break;
+            case MessageType::ResetPilot:
+                // the collected messages may belong to the deleted pilot and have to be sent before the delete
+                flush();
+                sent[idx] = server_->deletePilot(entries[idx]->callsign);
+                break;
+            case MessageType::None:
+                sent[idx] = true;
+                break;
+            default:
+                if (true == batched)
+                    patches.push_back(idx);
+                else
+                    sent[idx] = server_->patchPilot(entries[idx]->message);
+                break;
+        }
     }
+    flush();
 
-    // set the data locally, gives feedback to user that the action was handled, might get overwritten again in the
-    // update cycle if the backend does not accept the message
-    std::lock_guard guard(this->m_pilotLock);
-    auto it = this->m_pilots.find(callsign);
-    auto& pilot = it->second[ConsolidatedData];
+    return sent;
+}
 
-    pilot.lastUpdate = std::chrono::system_clock::now();
+void DataManager::coalesceMessages(std::list<AsynchronousMessage>& messages) {
+    // pending patch of every pilot, further patches of the pilot are merged into it
+    std::map<std::string, std::list<AsynchronousMessage>::iterator> pendingPatches;
 
-    switch (type) {
-        case MessageType::UpdateEXOT:
-            pilot.exot = value;
-            pilot.tsat = types::defaultTime;
-            pilot.ttot = types::defaultTime;
-            pilot.asat = types::defaultTime;
-            pilot.aobt = types::defaultTime;
-            pilot.atot = types::defaultTime;
-            break;
-        case MessageType::UpdateTOBT: {
-            bool resetTsat = value >= pilot.tsat;
-
-            pilot.tobt = value;
-            if (true == resetTsat) pilot.tsat = types::defaultTime;
-            pilot.ttot = types::defaultTime;
-            pilot.exot = types::defaultTime;
-            pilot.asat = types::defaultTime;
-            pilot.aobt = types::defaultTime;
-            pilot.atot = types::defaultTime;
-
-            break;
+    for (auto it = messages.begin(); it != messages.end();) {
+        // posts and deletes are sent as they are, patches queued after them must not be merged into older patches
+        if (MessageType::Post == it->type || MessageType::ResetPilot == it->type || MessageType::None == it->type) {
+            pendingPatches.erase(it->callsign);
+            ++it;
+            continue;
         }
-        case MessageType::UpdateTOBTConfirmed: {
-            bool resetTsat = value == types::defaultTime || value >= pilot.tsat;
-
-            pilot.tobt = value;
-            if (true == resetTsat) pilot.tsat = types::defaultTime;
-            pilot.ttot = types::defaultTime;
-            pilot.exot = types::defaultTime;
-            pilot.asat = types::defaultTime;
-            pilot.aobt = types::defaultTime;
-            pilot.atot = types::defaultTime;
-
-            break;
+
+        auto pending = pendingPatches.find(it->callsign);
+        if (pendingPatches.end() == pending) {
+            pendingPatches.insert({it->callsign, it});
+            ++it;
+            continue;
         }
+
+        // later messages overwrite the fields of earlier messages, same as sending them one after another
+        pending->second->message.merge_patch(it->message);
+        pending->second->description += ", " + it->description;
+        pending->second->journalIds.insert(pending->second->journalIds.end(), it->journalIds.begin(),
+                                           it->journalIds.end());
+        it = messages.erase(it);
+    }
+}
+
+nlohmann::json DataManager::createUpdateMessage(MessageType type, const std::string& callsign,
+                                                const std::chrono::system_clock::time_point& value,
+                                                const types::Pilot& pilot) {
+    switch (type) {
+        case MessageType::UpdateEXOT:
+            return Server::exotUpdate(callsign, value);
+        case MessageType::UpdateTOBT:
+            return Server::tobtUpdate(pilot, value, false);
+        case MessageType::UpdateTOBTConfirmed:
+            return Server::tobtUpdate(pilot, value, true);
         case MessageType::UpdateASAT:
-            pilot.asat = value;
-            break;
+        case MessageType::ResetASAT:
+            return Server::asatUpdate(callsign, value);
         case MessageType::UpdateASRT:
-            pilot.asrt = value;
-            break;
+        case MessageType::ResetASRT:
+            return Server::asrtUpdate(callsign, value);
+        case MessageType::UpdateAOBT:
+        case MessageType::ResetAOBT:
+            return Server::aobtUpdate(callsign, value);
+        case MessageType::UpdateAORT:
+        case MessageType::ResetAORT:
+            return Server::aortUpdate(callsign, value);
+        case MessageType::ResetTOBT:
+            return Server::tobtReset(callsign, types::defaultTime, pilot.tobt_state);
+        case MessageType::ResetTOBTConfirmed:
+            return Server::tobtReset(callsign, pilot.tobt, types::TobtState::Guess);
+        default:
+            return nlohmann::json();
+    }
+}
+
+std::string DataManager::messageTypeDescription(MessageType type) {
+    switch (type) {
+        case MessageType::Post:
+            return "POST";
+        case MessageType::Patch:
+            return "PATCH";
+        case MessageType::UpdateEXOT:
+            return "EXOT";
+        case MessageType::UpdateTOBT:
+            return "TOBT";
+        case MessageType::UpdateTOBTConfirmed:
+            return "TOBT Confirmed Status";
+        case MessageType::UpdateASAT:
+            return "ASAT";
+        case MessageType::UpdateASRT:
+            return "ASRT";
         case MessageType::UpdateAOBT:
-            pilot.aobt = value;
-            break;
+            return "AOBT";
         case MessageType::UpdateAORT:
-            pilot.aort = value;
-            break;
+            return "AORT";
         case MessageType::ResetTOBT:
-            pilot.tobt = types::defaultTime;
-            pilot.tsat = types::defaultTime;
-            pilot.ttot = types::defaultTime;
-            pilot.exot = types::defaultTime;
-            pilot.asat = types::defaultTime;
-            pilot.asrt = types::defaultTime;
-            pilot.aobt = types::defaultTime;
-            pilot.aort = types::defaultTime;
-            pilot.atot = types::defaultTime;
-            break;
+            return "TOBT reset";
         case MessageType::ResetASAT:
-            pilot.asat = types::defaultTime;
-            break;
+            return "ASAT reset";
         case MessageType::ResetASRT:
-            pilot.asrt = types::defaultTime;
-            break;
+            return "ASRT reset";
         case MessageType::ResetTOBTConfirmed:
-            pilot.tobt_state = "GUESS";
-            break;
+            return "TOBT confirmed reset";
         case MessageType::ResetAORT:
-            pilot.aort = types::defaultTime;
-            break;
+            return "AORT reset";
         case MessageType::ResetAOBT:
-            pilot.aobt = types::defaultTime;
-            break;
+            return "AOBT reset";
         case MessageType::ResetPilot:
-            this->m_pilots.erase(it);
-            break;
+            return "Pilot reset";
         default:
-            break;
+            return "";
+    }
+}
+
+void DataManager::handleTagFunction(MessageType type, const std::string callsign,
+                                    const std::chrono::system_clock::time_point value) {
+    if (!server_){
+#ifdef DEV
+    if (vacdmLogger_)
+        vacdmLogger_->log(Logger::LogSender::DataManager, "No server instance available 5", Logger::LogLevel::Info); 
+#endif
+        return;
     }
+    // do not handle the tag function if the aircraft does not exist or the client is not master
+    if (false == this->checkPilotExists(callsign) || false == server_->getMaster()) return;
+
+    // set the data locally, gives feedback to user that the action was handled, might get overwritten again in the
+    // update cycle if the backend does not accept the message
+    nlohmann::json message;
+    bool exists = false;
+    this->m_pilots.update([&](PilotSnapshotStore::Pilots& pilots) {
+        auto it = pilots.find(callsign);
+        if (pilots.end() == it) return;
+        exists = true;
+
+        if (MessageType::ResetPilot == type) {
+            pilots.erase(it);
+            return;
+        }
+
+        auto& pilot = PilotSnapshotStore::modify(it->second)[ConsolidatedData];
+        pilot.lastUpdate = std::chrono::system_clock::now();
+
+        switch (type) {
+            case MessageType::UpdateEXOT:
+                pilot.exot = value;
+                pilot.tsat = types::defaultTime;
+                pilot.ttot = types::defaultTime;
+                pilot.asat = types::defaultTime;
+                pilot.aobt = types::defaultTime;
+                pilot.atot = types::defaultTime;
+                break;
+            case MessageType::UpdateTOBT: {
+                bool resetTsat = value >= pilot.tsat;
+
+                pilot.tobt = value;
+                if (true == resetTsat) pilot.tsat = types::defaultTime;
+                pilot.ttot = types::defaultTime;
+                pilot.exot = types::defaultTime;
+                pilot.asat = types::defaultTime;
+                pilot.aobt = types::defaultTime;
+                pilot.atot = types::defaultTime;
+
+                break;
+            }
+            case MessageType::UpdateTOBTConfirmed: {
+                bool resetTsat = value == types::defaultTime || value >= pilot.tsat;
+
+                pilot.tobt = value;
+                if (true == resetTsat) pilot.tsat = types::defaultTime;
+                pilot.ttot = types::defaultTime;
+                pilot.exot = types::defaultTime;
+                pilot.asat = types::defaultTime;
+                pilot.aobt = types::defaultTime;
+                pilot.atot = types::defaultTime;
+
+                break;
+            }
+            case MessageType::UpdateASAT:
+                pilot.asat = value;
+                break;
+            case MessageType::UpdateASRT:
+                pilot.asrt = value;
+                break;
+            case MessageType::UpdateAOBT:
+                pilot.aobt = value;
+                break;
+            case MessageType::UpdateAORT:
+                pilot.aort = value;
+                break;
+            case MessageType::ResetTOBT:
+                pilot.tobt = types::defaultTime;
+                pilot.tsat = types::defaultTime;
+                pilot.ttot = types::defaultTime;
+                pilot.exot = types::defaultTime;
+                pilot.asat = types::defaultTime;
+                pilot.asrt = types::defaultTime;
+                pilot.aobt = types::defaultTime;
+                pilot.aort = types::defaultTime;
+                pilot.atot = types::defaultTime;
+                break;
+            case MessageType::ResetASAT:
+                pilot.asat = types::defaultTime;
+                break;
+            case MessageType::ResetASRT:
+                pilot.asrt = types::defaultTime;
+                break;
+            case MessageType::ResetTOBTConfirmed:
+                pilot.tobt_state = types::TobtState::Guess;
+                break;
+            case MessageType::ResetAORT:
+                pilot.aort = types::defaultTime;
+                break;
+            case MessageType::ResetAOBT:
+                pilot.aobt = types::defaultTime;
+                break;
+            default:
+                break;
+        }
+
+        // the update message which will be sent to the backend uses the updated local data
+        message = this->createUpdateMessage(type, callsign, value, pilot);
+    });
+    // the pilot was removed since the existence was checked
+    if (false == exists) return;
+
+    // journal the action before it is queued, it is replayed if the plugin stops before the backend received it
+    std::vector<std::uint64_t> journalIds;
+    const auto journalId = this->m_outboxJournal.append(static_cast<int>(type), callsign, value, message);
+    if (0 != journalId) journalIds.push_back(journalId);
+
+    this->queueMessage({.type = type,
+                        .callsign = callsign,
+                        .value = value,
+                        .pilot = types::Pilot(),
+                        .message = std::move(message),
+                        .queuedAt = std::chrono::steady_clock::now(),
+                        .description = DataManager::messageTypeDescription(type),
+                        .journalIds = std::move(journalIds)});
 }
 
 DataManager::MessageType DataManager::deltaScopeToBackend(const std::array<types::Pilot, 3>& data,
@@ -393,38 +709,79 @@ DataManager::MessageType DataManager::deltaScopeToBackend(const std::array<types
 }
 
 void DataManager::setActiveAirports(const std::list<std::string> activeAirports) {
-    std::lock_guard guard(this->m_airportLock);
-
-    std::list<std::string> supportedAirports = server_->getSupportedAirports();
-    std::list<std::string> cdmActiveAirports;
+    const auto supportedAirports = server_->getSupportedAirports();
+    const std::unordered_set<std::string> supported(supportedAirports.begin(), supportedAirports.end());
 
+    auto cdmActiveAirports = std::make_shared<ActiveAirports>();
     for (const auto& activeAirport : activeAirports) {
-        for (const auto& supportedAirport : supportedAirports) {
-            if (supportedAirport == activeAirport) {
-                cdmActiveAirports.push_back(supportedAirport);
-                break;
-            }
-        }
+        if (supported.end() != supported.find(activeAirport) &&
+            true == cdmActiveAirports->set.insert(activeAirport).second)
+            cdmActiveAirports->list.push_back(activeAirport);
     }
 
-    this->m_activeAirports = cdmActiveAirports;
+    server_->subscribePilotEvents(cdmActiveAirports->list);
+    this->m_activeAirports.store(std::move(cdmActiveAirports));
+}
+
+bool DataManager::isActiveAirport(const std::string& icao) {
+    const auto activeAirports = this->m_activeAirports.load();
+    return activeAirports->set.end() != activeAirports->set.find(icao);
 }
 
 void DataManager::queueFlightplanUpdate(Flightplan flightplan, Aircraft aircraft, double distanceFromOrigin) {
     // skip the update if:
     // - the flightplan or its data is invalid
     //  - More than 10nm away from origin
-    if (false == flightplan.isValid || distanceFromOrigin > 10.0) {
+    //  - the flight does not depart from an active airport
+    if (false == flightplan.isValid || distanceFromOrigin > 10.0 || false == this->isActiveAirport(flightplan.origin)) {
         return;
     }
 
     auto pilot = this->CFlightPlanToPilot(flightplan, aircraft, distanceFromOrigin);
+    if (!pilot) {
+        if (vacdmLogger_)
+            vacdmLogger_->log(Logger::LogSender::DataManager,
+                               "Skipped flightplan of " + flightplan.callsign +
+                                   ", the callsign, an airport, the runway or the SID is too long",
+                               Logger::LogLevel::Warning);
+        return;
+    }
 
-    std::lock_guard guard(this->m_scopeUpdatesLock);
-    this->m_scopeFlightplanUpdates.push_back({std::chrono::system_clock::now(), pilot});
+    // the Scope timer does not wait for the worker, the update is dropped if the queue is full and the next
+    // update of the pilot is used
+    this->m_scopeFlightplanUpdates.push(
+        ScopeFlightplanUpdate{std::chrono::system_clock::now(), std::move(*pilot), this->m_clearGeneration.load()});
 }
 
-void DataManager::consolidateWithBackend(std::map<std::string, std::array<types::Pilot, 3U>>& pilots) {
+void DataManager::takeScopeUpdates() {
+    const auto generation = this->m_clearGeneration.load();
+    if (generation != this->m_pendingScopeUpdatesGeneration) {
+        this->m_pendingScopeUpdates.clear();
+        this->m_pendingScopeUpdatesGeneration = generation;
+    }
+
+    // the latest update of a pilot wins, older updates which were not processed yet are replaced
+    this->m_scopeFlightplanUpdates.drain([this, generation](ScopeFlightplanUpdate&& update) {
+        if (generation != update.generation) return;
+
+        auto callsign = update.data.callsign.str();
+        this->m_pendingScopeUpdates.insert_or_assign(std::move(callsign), std::move(update));
+    });
+
+    const auto statistics = this->m_scopeFlightplanUpdates.statistics();
+    if (statistics.dropped != this->m_reportedScopeUpdateDrops) {
+        if (vacdmLogger_)
+            vacdmLogger_->log(Logger::LogSender::DataManager,
+                               "Scope update queue full, dropped " +
+                                   std::to_string(statistics.dropped - this->m_reportedScopeUpdateDrops) +
+                                   " flightplan updates, contended enqueues " +
+                                   std::to_string(statistics.contended),
+                               Logger::LogLevel::Warning);
+        this->m_reportedScopeUpdateDrops = statistics.dropped;
+    }
+}
+
+void DataManager::consolidateWithBackend() {
     // retrieving backend data
     if (!server_)
     {
@@ -434,24 +791,42 @@ void DataManager::consolidateWithBackend(std::map<std::string, std::array<types:
 #endif
         return;
     } 
-    auto backendPilots = server_->getPilots(this->m_activeAirports);
+    auto backendPilots = server_->getPilots(this->m_activeAirports.load()->list);
+    this->m_pilots.update([this, &backendPilots](PilotSnapshotStore::Pilots& pilots) {
+        this->mergeBackendPilots(pilots, std::move(backendPilots));
+    });
+}
+
+void DataManager::applyPilotEvents(std::list<types::Pilot> backendPilots) {
+    if (true == backendPilots.empty()) return;
+
+    this->m_pilots.update([this, &backendPilots](PilotSnapshotStore::Pilots& pilots) {
+        this->mergeBackendPilots(pilots, std::move(backendPilots));
+    });
+}
+
+void DataManager::mergeBackendPilots(PilotSnapshotStore::Pilots& pilots, std::list<types::Pilot> backendPilots) {
+    // index the backend pilots by callsign, the first pilot of a callsign is used if the backend sends duplicates
+    std::unordered_map<std::string_view, types::Pilot*> backendIndex;
+    backendIndex.reserve(backendPilots.size());
+    for (auto& backendPilot : backendPilots) backendIndex.emplace(backendPilot.callsign, &backendPilot);
 
     for (auto pilot = pilots.begin(); pilots.end() != pilot;) {
         // update backend data & consolidate
-        bool removeFlight = pilot->second[ServerData].inactive == true;
-        for (auto updateIt = backendPilots.begin(); updateIt != backendPilots.end(); ++updateIt) {
-            if (updateIt->callsign == pilot->second[ScopeData].callsign) {
-                if (vacdmLogger_)
-                    vacdmLogger_->log(
-                        Logger::LogSender::DataManager,
-                        "Updating " + pilot->second[ScopeData].callsign + " with " + updateIt->callsign,
-                        Logger::LogLevel::Info);
-                pilot->second[ServerData] = *updateIt;
-                DataManager::consolidateData(pilot->second);
-                removeFlight = false;
-                updateIt = backendPilots.erase(updateIt);
-                break;
-            }
+        bool removeFlight = (*pilot->second)[ServerData].inactive == true;
+
+        const auto update = backendIndex.find(pilot->first);
+        if (backendIndex.end() != update) {
+            if (vacdmLogger_)
+                vacdmLogger_->log(Logger::LogSender::DataManager,
+                                   "Updating " + pilot->first + " with " + update->second->callsign,
+                                   Logger::LogLevel::Info);
+            auto& record = PilotSnapshotStore::modify(pilot->second);
+            record[ServerData] = std::move(*update->second);
+            DataManager::consolidateData(record);
+            removeFlight = false;
+            // the key refers to the moved callsign, every local callsign is looked up only once
+            backendIndex.erase(update);
         }
 
         // remove pilot if he has been flagged as inactive from the backend
@@ -507,93 +882,46 @@ void DataManager::consolidateData(std::array<types::Pilot, 3>& pilot) {
     }
 }
 
-void DataManager::processScopeUpdates(std::map<std::string, std::array<types::Pilot, 3U>>& pilots) {
-    // obtain a copy of the flightplan updates, clear the update list, consolidate flightplan updates
-    this->m_scopeUpdatesLock.lock();
-    auto flightplanUpdates = this->m_scopeFlightplanUpdates;
-    this->m_scopeFlightplanUpdates.clear();
-    this->m_scopeUpdatesLock.unlock();
-
-    this->consolidateFlightplanUpdates(flightplanUpdates);
-
-    for (auto& update : flightplanUpdates) {
-        bool found = false;
+void DataManager::processScopeUpdates(PilotSnapshotStore::Pilots& pilots) {
+    // take the pending updates, the updates are already reduced to the latest one per pilot
+    this->takeScopeUpdates();
+    decltype(this->m_pendingScopeUpdates) flightplanUpdates;
+    flightplanUpdates.swap(this->m_pendingScopeUpdates);
 
-        const auto pilot = update.data;
+    const auto activeAirports = this->m_activeAirports.load();
+    for (auto& [callsign, update] : flightplanUpdates) {
+        const auto& pilot = update.data;
 
-        // find pilot in list
-        for (auto& pair : pilots) {
-            if (pilot.callsign == pair.first) {
-                if (vacdmLogger_)
-                    vacdmLogger_->log(Logger::LogSender::DataManager, "Updated data of " + pilot.callsign,
-                                       Logger::LogLevel::Info);
+        // the airports may have changed since the update was queued
+        if (activeAirports->set.end() == activeAirports->set.find(pilot.origin.str())) continue;
 
-                pair.second[ScopeData] = pilot;
-                found = true;
-                break;
-            }
-        }
-
-        if (false == found) {
-        if (vacdmLogger_)
-            vacdmLogger_->log(Logger::LogSender::DataManager, "Added " + pilot.callsign, Logger::LogLevel::Info);
-                pilots.insert({pilot.callsign, {pilot, pilot, types::Pilot()}});
-        }
-    }
-}
-
-void DataManager::consolidateFlightplanUpdates(std::list<ScopeFlightplanUpdate>& inputList) {
-    std::list<DataManager::ScopeFlightplanUpdate> resultList;
-
-    for (const auto& currentUpdate : inputList) {
-        auto pilot = currentUpdate.data;
-
-        // only handle updates for active airports
-        {
-            std::lock_guard guard(this->m_airportLock);
-            bool flightDepartsFromActiveAirport = std::find(m_activeAirports.begin(), m_activeAirports.end(),
-                                                            std::string(pilot.origin)) != m_activeAirports.end();
-            if (false == flightDepartsFromActiveAirport) continue;
-        }
+        auto existing = pilots.find(callsign);
+        if (pilots.end() != existing) {
+            if (vacdmLogger_)
+                vacdmLogger_->log(Logger::LogSender::DataManager, "Updated data of " + pilot.callsign,
+                                   Logger::LogLevel::Info);
 
-        // Check if the flight plan already exists in the result list
-        auto it = std::find_if(resultList.begin(), resultList.end(),
-                               [&currentUpdate](const ScopeFlightplanUpdate& existingUpdate) {
-                                   return existingUpdate.data.callsign == currentUpdate.data.callsign;
-                               });
-
-        if (it != resultList.end()) {
-            // Flight plan with the same callsign exists
-            // Check if the timeIssued is newer
-            if (currentUpdate.timeIssued > it->timeIssued) {
-                // Update with the newer data
-                *it = currentUpdate;
-                if (vacdmLogger_)
-                    vacdmLogger_->log(Logger::LogSender::DataManager,
-                                       "Updated: " + std::string(currentUpdate.data.callsign), Logger::LogLevel::Info);
-            } else {
-                // Existing data is already newer, no update needed
-                if (vacdmLogger_)
-                    vacdmLogger_->log(Logger::LogSender::DataManager,
-                                       "Skipped old update for: " + std::string(currentUpdate.data.callsign),
-                                       Logger::LogLevel::Info);
-            }
+            PilotSnapshotStore::modify(existing->second)[ScopeData] = pilot;
         } else {
-            // Flight plan with the callsign doesn't exist, add it to the result list
-            resultList.push_back(currentUpdate);
             if (vacdmLogger_)
-                vacdmLogger_->log(Logger::LogSender::DataManager,
-                                   "Update added: " + std::string(currentUpdate.data.callsign), Logger::LogLevel::Info);
+                vacdmLogger_->log(Logger::LogSender::DataManager, "Added " + pilot.callsign, Logger::LogLevel::Info);
+            pilots.insert({callsign, PilotSnapshotStore::makeRecord({pilot, pilot, types::Pilot()})});
         }
     }
-
-    inputList = resultList;
 }
 
-types::Pilot DataManager::CFlightPlanToPilot(const PluginSDK::Flightplan::Flightplan flightplan, const PluginSDK::Aircraft::Aircraft aircraft, double distanceFromOrigin) {
+std::optional<types::Pilot> DataManager::CFlightPlanToPilot(const PluginSDK::Flightplan::Flightplan flightplan, const PluginSDK::Aircraft::Aircraft aircraft, double distanceFromOrigin) {
     types::Pilot pilot;
 
-    pilot.callsign = flightplan.callsign;
+    // flightplan & clearance data
+    const auto& runway =
+        flightplan.route.depRunway != "" ? flightplan.route.depRunway : flightplan.route.suggestedDepRunway;
+    const auto& sid = flightplan.route.sid != "" ? flightplan.route.sid : flightplan.route.suggestedSid;
+    if (false == pilot.callsign.assign(flightplan.callsign) || false == pilot.origin.assign(flightplan.origin) ||
+        false == pilot.destination.assign(flightplan.destination) || false == pilot.runway.assign(runway) ||
+        false == pilot.sid.assign(sid))
+        return std::nullopt;
+
     pilot.lastUpdate = std::chrono::system_clock::now();
 
     // position data
@@ -605,18 +933,6 @@ types::Pilot DataManager::CFlightPlanToPilot(const PluginSDK::Flightplan::Flight
     pilot.distanceFromOrigin = distanceFromOrigin;
     pilot.isSimulated = false;
 
-    // flightplan & clearance data
-    pilot.origin = flightplan.origin;
-    pilot.destination = flightplan.destination;
-    if (flightplan.route.depRunway != "")
-        pilot.runway = flightplan.route.depRunway;
-    else
-        pilot.runway = flightplan.route.suggestedDepRunway;
-    if (flightplan.route.sid != "")
-        pilot.sid = flightplan.route.sid;
-    else
-        pilot.sid = flightplan.route.suggestedSid;
-
     // acdm data
     pilot.eobt = utils::Date::convertDepartureTime(flightplan);
     pilot.tobt = pilot.eobt;
@@ -626,156 +942,86 @@ types::Pilot DataManager::CFlightPlanToPilot(const PluginSDK::Flightplan::Flight
 
 void DataManager::setPilotEobtCache(const std::string &callsign, const std::string &text, const std::optional<std::array<unsigned int, 3>> &colour)
 {
-    std::lock_guard guard(this->m_pilotLock);
-    auto it = this->m_pilots.find(callsign);
-    if (it != this->m_pilots.end())
-    {
-        auto &pilot = it->second[ConsolidatedData];
-        pilot.eobtCache.text = text;
-        pilot.eobtCache.colour = colour;
-    }
+    this->setTagCache(callsign, &types::TagCaches::eobtCache, text, colour);
 }
 
 void DataManager::setPilotAsatCache(const std::string &callsign, const std::string &text, const std::optional<std::array<unsigned int, 3>> &colour)
-{   
-    std::lock_guard guard(this->m_pilotLock);
-    auto it = this->m_pilots.find(callsign);
-    if (it != this->m_pilots.end())
-    {
-        auto &pilot = it->second[ConsolidatedData];
-        pilot.asatCache.text = text;
-        pilot.asatCache.colour = colour;
-    }
+{
+    this->setTagCache(callsign, &types::TagCaches::asatCache, text, colour);
 }
 
 void DataManager::setPilotAobtCache(const std::string &callsign, const std::string &text, const std::optional<std::array<unsigned int, 3>> &colour)
-{   
-    std::lock_guard guard(this->m_pilotLock);
-    auto it = this->m_pilots.find(callsign);
-    if (it != this->m_pilots.end())
-    {
-        auto &pilot = it->second[ConsolidatedData];
-        pilot.aobtCache.text = text;
-        pilot.aobtCache.colour = colour;
-    }
+{
+    this->setTagCache(callsign, &types::TagCaches::aobtCache, text, colour);
 }
 
 void DataManager::setPilotAtotCache(const std::string &callsign, const std::string &text, const std::optional<std::array<unsigned int, 3>> &colour)
-{   
-    std::lock_guard guard(this->m_pilotLock);
-    auto it = this->m_pilots.find(callsign);
-    if (it != this->m_pilots.end())
-    {
-        auto &pilot = it->second[ConsolidatedData];
-        pilot.atotCache.text = text;
-        pilot.atotCache.colour = colour;
-    }
+{
+    this->setTagCache(callsign, &types::TagCaches::atotCache, text, colour);
 }
 
 void DataManager::setPilotAsrtCache(const std::string &callsign, const std::string &text, const std::optional<std::array<unsigned int, 3>> &colour)
-{   
-    std::lock_guard guard(this->m_pilotLock);
-    auto it = this->m_pilots.find(callsign);
-    if (it != this->m_pilots.end())
-    {
-        auto &pilot = it->second[ConsolidatedData];
-        pilot.asrtCache.text = text;
-        pilot.asrtCache.colour = colour;
-    }
+{
+    this->setTagCache(callsign, &types::TagCaches::asrtCache, text, colour);
 }
 
 void DataManager::setPilotAortCache(const std::string &callsign, const std::string &text, const std::optional<std::array<unsigned int, 3>> &colour)
-{   
-    std::lock_guard guard(this->m_pilotLock);
-    auto it = this->m_pilots.find(callsign);
-    if (it != this->m_pilots.end())
-    {
-        auto &pilot = it->second[ConsolidatedData];
-        pilot.aortCache.text = text;
-        pilot.aortCache.colour = colour;
-    }
+{
+    this->setTagCache(callsign, &types::TagCaches::aortCache, text, colour);
 }
 
 void DataManager::setPilotTobtCache(const std::string &callsign, const std::string &text, const std::optional<std::array<unsigned int, 3>> &colour)
-{   
-    std::lock_guard guard(this->m_pilotLock);
-    auto it = this->m_pilots.find(callsign);
-    if (it != this->m_pilots.end())
-    {
-        auto &pilot = it->second[ConsolidatedData];
-        pilot.tobtCache.text = text;
-        pilot.tobtCache.colour = colour;
-    }
+{
+    this->setTagCache(callsign, &types::TagCaches::tobtCache, text, colour);
 }
 
 void DataManager::setPilotTsatCache(const std::string &callsign, const std::string &text, const std::optional<std::array<unsigned int, 3>> &colour)
-{   
-    std::lock_guard guard(this->m_pilotLock);
-    auto it = this->m_pilots.find(callsign);
-    if (it != this->m_pilots.end())
-    {
-        auto &pilot = it->second[ConsolidatedData];
-        pilot.tsatCache.text = text;
-        pilot.tsatCache.colour = colour;
-    }
+{
+    this->setTagCache(callsign, &types::TagCaches::tsatCache, text, colour);
 }
 
 void DataManager::setPilotTtotCache(const std::string &callsign, const std::string &text, const std::optional<std::array<unsigned int, 3>> &colour)
-{   
-    std::lock_guard guard(this->m_pilotLock);
-    auto it = this->m_pilots.find(callsign);
-    if (it != this->m_pilots.end())
-    {
-        auto &pilot = it->second[ConsolidatedData];
-        pilot.ttotCache.text = text;
-        pilot.ttotCache.colour = colour;
-    }
+{
+    this->setTagCache(callsign, &types::TagCaches::ttotCache, text, colour);
 }
 
 void DataManager::setPilotCtotCache(const std::string &callsign, const std::string &text, const std::optional<std::array<unsigned int, 3>> &colour)
-{   
-    std::lock_guard guard(this->m_pilotLock);
-    auto it = this->m_pilots.find(callsign);
-    if (it != this->m_pilots.end())
-    {
-        auto &pilot = it->second[ConsolidatedData];
-        pilot.ctotCache.text = text;
-        pilot.ctotCache.colour = colour;
-    }
+{
+    this->setTagCache(callsign, &types::TagCaches::ctotCache, text, colour);
 }
 
 void DataManager::setPilotExotCache(const std::string &callsign, const std::string &text, const std::optional<std::array<unsigned int, 3>> &colour)
-{   
-    std::lock_guard guard(this->m_pilotLock);
-    auto it = this->m_pilots.find(callsign);
-    if (it != this->m_pilots.end())
-    {
-        auto &pilot = it->second[ConsolidatedData];
-        pilot.exotCache.text = text;
-        pilot.exotCache.colour = colour;
-    }
+{
+    this->setTagCache(callsign, &types::TagCaches::exotCache, text, colour);
 }
 
 void DataManager::setPilotEventBookingCache(const std::string &callsign, const std::string &text, const std::optional<std::array<unsigned int, 3>> &colour)
-{   
-    std::lock_guard guard(this->m_pilotLock);
-    auto it = this->m_pilots.find(callsign);
-    if (it != this->m_pilots.end())
-    {
-        auto &pilot = it->second[ConsolidatedData];
-        pilot.eventBookingCache.text = text;
-        pilot.eventBookingCache.colour = colour;
-    }
+{
+    this->setTagCache(callsign, &types::TagCaches::eventBookingCache, text, colour);
 }
 
 void DataManager::setPilotEcfmpMeasuresCache(const std::string &callsign, const std::string &text, const std::optional<std::array<unsigned int, 3>> &colour)
-{   
-    std::lock_guard guard(this->m_pilotLock);
-    auto it = this->m_pilots.find(callsign);
-    if (it != this->m_pilots.end())
-    {
-        auto &pilot = it->second[ConsolidatedData];
-        pilot.ecfmpMeasuresCache.text = text;
-        pilot.ecfmpMeasuresCache.colour = colour;
+{
+    this->setTagCache(callsign, &types::TagCaches::ecfmpMeasuresCache, text, colour);
+}
+
+void DataManager::setTagCache(const std::string& callsign, types::TagCacheItem types::TagCaches::*item,
+                              const std::string& text, const std::optional<std::array<unsigned int, 3>>& colour) {
+    const auto snapshot = this->m_pilots.snapshot();
+    if (snapshot->pilots.cend() == snapshot->pilots.find(callsign)) return;
+
+    std::lock_guard guard(this->m_tagCacheLock);
+    auto& cache = this->m_tagCaches[callsign].*item;
+    cache.text = text;
+    cache.colour = colour;
+}
+
+void DataManager::removeStaleTagCaches(const PilotSnapshotStore::Snapshot& snapshot) {
+    std::lock_guard guard(this->m_tagCacheLock);
+    for (auto it = this->m_tagCaches.begin(); this->m_tagCaches.end() != it;) {
+        if (snapshot.pilots.cend() == snapshot.pilots.find(it->first))
+            it = this->m_tagCaches.erase(it);
+        else
+            ++it;
     }
-}
\ No newline at end of file
+}
@@ -1,10 +1,16 @@
 #pragma once
 
+#include <atomic>
+#include <condition_variable>
 #include <list>
 #include <map>
+#include <memory>
 #include <mutex>
+#include <optional>
 #include <string>
 #include <thread>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include <NeoRadarSDK/SDK.h>
@@ -12,8 +18,12 @@
 #include <nlohmann/json.hpp>
 
 #include "log/Logger.h"
+#include "OutboxJournal.h"
+#include "PilotSnapshotStore.h"
 #include "Server.h"
 #include "types/Pilot.h"
+#include "utils/AtomicSharedPtr.h"
+#include "utils/MpscQueue.h"
 
 using namespace vacdm;
 
@@ -21,6 +31,15 @@ namespace vacdm::core {
 
 constexpr int maxUpdateCycleSeconds = 10;
 constexpr int minUpdateCycleSeconds = 1;
+constexpr std::chrono::milliseconds outboxCoalescingDelay = std::chrono::milliseconds(200);
+/// @brief slots of the queue of the Scope flightplan updates, the queue is emptied by the worker every second
+constexpr std::size_t scopeUpdateQueueCapacity = 2048;
+/// @brief slots of the queue of the messages to the backend
+constexpr std::size_t outboxQueueCapacity = 2048;
+/// @brief controller actions which could not be delivered within this time are not replayed anymore
+constexpr std::chrono::minutes outboxJournalMaxAge = std::chrono::minutes(30);
+/// @brief interval of the pilot requests while the pilot events are received, catches events missed by the stream
+constexpr std::chrono::seconds pilotEventsPollInterval = std::chrono::seconds(60);
 class DataManager {
    public:
     DataManager(com::Server* server, logging::Logger* vacdmLogger);
@@ -48,10 +67,28 @@ class DataManager {
         ResetPilot
     };
 
+    struct OutboxStatistics {
+        std::size_t queueDepth = 0;
+        std::size_t sentMessages = 0;
+        std::size_t coalescedMessages = 0;
+        /// @brief messages which were rejected because the queue was full
+        std::size_t droppedMessages = 0;
+        /// @brief retries of the enqueues because another thread queued a message at the same time
+        std::size_t contendedEnqueues = 0;
+        /// @brief controller actions in the journal which are not confirmed by the backend
+        std::size_t journaledMessages = 0;
+        std::chrono::milliseconds lastSendLatency = std::chrono::milliseconds(0);
+        std::chrono::milliseconds averageSendLatency = std::chrono::milliseconds(0);
+        std::chrono::milliseconds maxSendLatency = std::chrono::milliseconds(0);
+    };
+
    private:
+    friend class DataManagerTest;
+
     std::thread m_worker;
-    bool m_pause;
-    bool m_stop;
+    /// @brief read by the worker and the sender, written under m_asyncMessagesLock when the sender has to wake up
+    std::atomic<bool> m_pause;
+    std::atomic<bool> m_stop;
 
     com::Server* server_ = nullptr;
     logging::Logger* vacdmLogger_ = nullptr;
@@ -59,30 +96,60 @@ class DataManager {
     void run();
     
     int updateCycleSeconds = 5;
-    std::mutex m_pilotLock;
-    std::map<std::string, std::array<types::Pilot, 3>> m_pilots;
-    std::mutex m_airportLock;
-    std::list<std::string> m_activeAirports;
+    PilotSnapshotStore m_pilots;
+
+    /// @brief texts and colours of the tag items which were last sent to Scope. They are kept apart from the pilot
+    /// snapshots because the tag updates change them far more often than the pilot data changes.
+    std::mutex m_tagCacheLock;
+    std::map<std::string, types::TagCaches> m_tagCaches;
+    /// @brief stores the tag item of an existing pilot
+    void setTagCache(const std::string &callsign, types::TagCacheItem types::TagCaches::*item, const std::string &text,
+                     const std::optional<std::array<unsigned int, 3>> &colour);
+    /// @brief removes the tag items of the pilots which are not part of the snapshot anymore
+    void removeStaleTagCaches(const PilotSnapshotStore::Snapshot &snapshot);
+
+    /// @brief supported airports which are active in Scope, the list is passed to the server, the set is used for
+    /// the lookups
+    struct ActiveAirports {
+        std::list<std::string> list;
+        std::unordered_set<std::string> set;
+    };
+    /// @brief replaced as a whole when the airports change, readers only lock to copy the pointer
+    utils::AtomicSharedPtr<const ActiveAirports> m_activeAirports;
+
+    /// @brief incremented when all pilot data is cleared, queued updates and messages of older generations are
+    /// discarded by the threads which take them from the queues
+    std::atomic<std::uint64_t> m_clearGeneration;
 
     struct ScopeFlightplanUpdate {
         std::chrono::system_clock::time_point timeIssued;
         types::Pilot data;
+        std::uint64_t generation = 0;
     };
 
-    std::mutex m_scopeUpdatesLock;
-    std::list<ScopeFlightplanUpdate> m_scopeFlightplanUpdates;
-
-    /// @brief consolidates all flightplan updates by throwing out old updates and keeping the most current ones
-    /// @param list of flightplans to consolidate
-    void consolidateFlightplanUpdates(std::list<ScopeFlightplanUpdate> &list);
+    /// @brief flightplan updates queued by the Scope timer, queueing does not block
+    utils::MpscQueue<ScopeFlightplanUpdate> m_scopeFlightplanUpdates;
+    /// @brief latest taken flightplan update per callsign, only used by the worker
+    std::unordered_map<std::string, ScopeFlightplanUpdate> m_pendingScopeUpdates;
+    std::uint64_t m_pendingScopeUpdatesGeneration = 0;
+    std::uint64_t m_reportedScopeUpdateDrops = 0;
+    /// @brief moves the queued flightplan updates into the pending updates, a newer update replaces the pending one
+    void takeScopeUpdates();
     /// @brief updates the pilots with the saved Scope flightplan updates
-    /// @param pilots to update
-    void processScopeUpdates(std::map<std::string, std::array<types::Pilot, 3U>> &pilots);
+    /// @param pilots working copy of the pilots
+    void processScopeUpdates(PilotSnapshotStore::Pilots &pilots);
     /// @brief gathers all information from Flightplan and Aircraft and converts it to type Pilot
-    types::Pilot CFlightPlanToPilot(const PluginSDK::Flightplan::Flightplan flightplan, const PluginSDK::Aircraft::Aircraft aircraft, double distanceFromOrigin);
-    /// @brief updates the local data with the data from the backend
-    /// @param pilots to update
-    void consolidateWithBackend(std::map<std::string, std::array<types::Pilot, 3U>> &pilots);
+    /// @return nullopt if a string of the flightplan does not fit into the pilot data
+    std::optional<types::Pilot> CFlightPlanToPilot(const PluginSDK::Flightplan::Flightplan flightplan, const PluginSDK::Aircraft::Aircraft aircraft, double distanceFromOrigin);
+    /// @brief updates the local data with the data from the backend, the pilots are requested outside the transaction
+    void consolidateWithBackend();
+    /// @brief updates the pilot data with the changes received by the pilot event subscription
+    /// @param backendPilots changed pilots
+    void applyPilotEvents(std::list<types::Pilot> backendPilots);
+    /// @brief stores the backend pilots as server data and consolidates them, removes the pilots flagged as inactive
+    /// @param pilots working copy of the pilots
+    /// @param backendPilots pilots received from the backend
+    void mergeBackendPilots(PilotSnapshotStore::Pilots &pilots, std::list<types::Pilot> backendPilots);
     /// @brief consolidates Scope and backend data
     /// @param pilot
     void consolidateData(std::array<types::Pilot, 3> &pilot);
@@ -90,27 +157,76 @@ class DataManager {
     MessageType deltaScopeToBackend(const std::array<types::Pilot, 3> &data, nlohmann::json &message);
 
     struct AsynchronousMessage {
-        const MessageType type;
-        const std::string callsign;
-        const std::chrono::system_clock::time_point value;
+        MessageType type;
+        std::string callsign;
+        std::chrono::system_clock::time_point value;
+        /// @brief local pilot data at the time the message was queued
+        types::Pilot pilot;
+        /// @brief content of patch messages
+        nlohmann::json message;
+        std::chrono::steady_clock::time_point queuedAt;
+        std::string description;
+        /// @brief journal entries of the controller actions in this message
+        std::vector<std::uint64_t> journalIds = {};
+        /// @brief set by queueMessage
+        std::uint64_t generation = 0;
     };
 
+    std::thread m_sender;
     std::mutex m_asyncMessagesLock;
-    std::list<struct AsynchronousMessage> m_asynchronousMessages;
-    void processAsynchronousMessages(std::map<std::string, std::array<types::Pilot, 3U>> &pilots);
+    std::condition_variable m_asyncMessagesCondition;
+    /// @brief messages for the sender, the lock and the condition are only used to wake up the sender
+    utils::MpscQueue<AsynchronousMessage> m_asynchronousMessages;
+    OutboxStatistics m_outboxStatistics;
+    OutboxJournal m_outboxJournal;
+
+    /// @brief sends the queued messages to the backend, runs independently of the update cycle
+    void runSender();
+    /// @brief queues a message for the sender, the journaled actions of a dropped message are replayed later
+    /// @param message to queue
+    void queueMessage(AsynchronousMessage &&message);
+    /// @brief takes the queued messages, a scope delta replaces the earlier delta of the same pilot
+    /// @param messages the taken messages are appended to
+    void takeAsynchronousMessages(std::list<AsynchronousMessage> &messages);
+    void processAsynchronousMessages(std::list<AsynchronousMessage> &messages);
+    /// @brief sends the messages in their order, creations and updates are batched if the server uses bulk requests
+    /// @return per message true if the backend received it
+    std::vector<bool> sendMessages(std::list<AsynchronousMessage> &messages);
+    /// @brief merges all patches of a pilot into one patch, keeps the order of posts, patches and deletes
+    /// @param messages to coalesce, merged messages are removed
+    void coalesceMessages(std::list<AsynchronousMessage> &messages);
+    /// @brief creates the patch content of a tag function
+    nlohmann::json createUpdateMessage(MessageType type, const std::string &callsign,
+                                       const std::chrono::system_clock::time_point &value, const types::Pilot &pilot);
+    static std::string messageTypeDescription(MessageType type);
+    /// @brief queues the controller actions of the journal which were not delivered
+    void replayOutboxJournal();
 
    public:
     void setActiveAirports(const std::list<std::string> activeAirports);
+    /// @brief Checks if the airport is supported by the backend and active in Scope
+    bool isActiveAirport(const std::string &icao);
     void queueFlightplanUpdate(PluginSDK::Flightplan::Flightplan flightplan, PluginSDK::Aircraft::Aircraft aircraft, double distanceFromOrigin);
     void handleTagFunction(MessageType message, const std::string callsign,
                            const std::chrono::system_clock::time_point value);
 
     bool checkPilotExists(const std::string &callsign);
+    /// @brief Returns a copy of the consolidated data, a default pilot if it does not exist
     const types::Pilot getPilot(const std::string &callsign);
+    /// @brief Returns a copy of the tag items which were last sent to Scope, empty items if there are none
+    const types::TagCaches getTagCaches(const std::string &callsign);
     std::vector<std::string> getPilots();
+    /// @brief Returns the current pilot data without copying it, the snapshot does not change while it is used
+    std::shared_ptr<const PilotSnapshotStore::Snapshot> pilotSnapshot();
     void pause();
     void resume();
     void clearAllPilotData();
+    OutboxStatistics outboxStatistics();
+    /// @brief Opens the journal of the controller actions, actions which were not delivered in the previous session
+    /// are sent again once the client is master
+    /// @param path of the journal file
+    /// @return true if the journal could be opened
+    bool openOutboxJournal(const std::string &path);
 
     void setPilotEobtCache(const std::string &callsign, const std::string &text, const std::optional<std::array<unsigned int, 3>> &colour);
     void setPilotTobtCache(const std::string &callsign, const std::string &text, const std::optional<std::array<unsigned int, 3>> &colour);
@@ -0,0 +1,7 @@
+#pragma once
+
+// cpp-httplib changes its classes with the feature macros, every translation unit includes it with the same features.
+// The unit tests link the plugin and the mock backend into one binary.
+#define CPPHTTPLIB_OPENSSL_SUPPORT
+#define CPPHTTPLIB_ZLIB_SUPPORT
+#include <httplib.h>
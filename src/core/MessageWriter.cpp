@@ -0,0 +1,129 @@
+#include "MessageWriter.h"
+
+#include <cmath>
+
+#include <nlohmann/json.hpp>
+
+#include "utils/Date.h"
+
+using namespace vacdm;
+using namespace vacdm::com;
+
+namespace {
+// constant parts of the messages, the keys are in the sorted order of nlohmann::json objects
+constexpr std::string_view callsignPrefix = "{\"callsign\":";
+constexpr std::string_view messageEnd = "}}";
+
+constexpr std::string_view creationRunway = ",\"clearance\":{\"dep_rwy\":";
+constexpr std::string_view creationSid = ",\"sid\":";
+constexpr std::string_view creationArrival = "},\"flightplan\":{\"arrival\":";
+constexpr std::string_view creationDeparture = ",\"departure\":";
+constexpr std::string_view creationLatitude = "},\"inactive\":false,\"position\":{\"lat\":";
+constexpr std::string_view creationLongitude = ",\"lon\":";
+constexpr std::string_view creationEobt = "},\"vacdm\":{\"eobt\":";
+constexpr std::string_view creationTobt = ",\"tobt\":";
+}  // namespace
+
+MessageWriter::MessageWriter() : m_buffer() {
+    // large enough for the biggest message, the buffer only grows for unusually long strings
+    this->m_buffer.reserve(512);
+}
+
+const std::string &MessageWriter::pilotCreation(const types::Pilot &pilot) {
+    this->begin(pilot.callsign);
+    this->m_buffer.append(creationRunway);
+    this->string(pilot.runway);
+    this->m_buffer.append(creationSid);
+    this->string(pilot.sid);
+    this->m_buffer.append(creationArrival);
+    this->string(pilot.destination);
+    this->m_buffer.append(creationDeparture);
+    this->string(pilot.origin);
+    this->m_buffer.append(creationLatitude);
+    this->number(pilot.latitude);
+    this->m_buffer.append(creationLongitude);
+    this->number(pilot.longitude);
+    this->m_buffer.append(creationEobt);
+    this->timestamp(pilot.eobt);
+    this->m_buffer.append(creationTobt);
+    this->timestamp(pilot.tobt);
+    this->m_buffer.append(messageEnd);
+
+    return this->m_buffer;
+}
+
+void MessageWriter::begin(std::string_view callsign) {
+    this->m_buffer.clear();
+    this->m_buffer.append(callsignPrefix);
+    this->string(callsign);
+}
+
+void MessageWriter::string(std::string_view value) {
+    static constexpr char hexDigits[] = "0123456789abcdef";
+
+    this->m_buffer.push_back('"');
+
+    // copy the runs of characters which do not need an escape sequence at once
+    std::size_t run = 0;
+    for (std::size_t i = 0; i < value.size(); ++i) {
+        const auto character = static_cast<unsigned char>(value[i]);
+        if ('"' != character && '\\' != character && 0x20 <= character) continue;
+
+        this->m_buffer.append(value.data() + run, i - run);
+        run = i + 1;
+
+        // same escape sequences as the nlohmann serializer, valid UTF-8 is copied unchanged like with dump()
+        this->m_buffer.push_back('\\');
+        switch (character) {
+            case '"':
+                this->m_buffer.push_back('"');
+                break;
+            case '\\':
+                this->m_buffer.push_back('\\');
+                break;
+            case '\b':
+                this->m_buffer.push_back('b');
+                break;
+            case '\f':
+                this->m_buffer.push_back('f');
+                break;
+            case '\n':
+                this->m_buffer.push_back('n');
+                break;
+            case '\r':
+                this->m_buffer.push_back('r');
+                break;
+            case '\t':
+                this->m_buffer.push_back('t');
+                break;
+            default:
+                this->m_buffer.append("u00");
+                this->m_buffer.push_back(hexDigits[character >> 4]);
+                this->m_buffer.push_back(hexDigits[character & 0x0f]);
+                break;
+        }
+    }
+    this->m_buffer.append(value.data() + run, value.size() - run);
+
+    this->m_buffer.push_back('"');
+}
+
+void MessageWriter::timestamp(const std::chrono::system_clock::time_point &timepoint) {
+    // ISO timestamps do not contain characters which need to be escaped
+    const auto offset = this->m_buffer.size() + 1;
+    this->m_buffer.resize(offset + utils::Date::isoStringLength + 1, '"');
+    utils::Date::writeIsoString(timepoint, this->m_buffer.data() + offset);
+}
+
+void MessageWriter::number(double value) {
+    if (false == std::isfinite(value)) {
+        this->m_buffer.append("null");
+        return;
+    }
+
+    // the shortest round-trip representation of the nlohmann serializer, dump() uses the same function
+    char buffer[64];
+    const auto* end = nlohmann::detail::to_chars(buffer, buffer + sizeof(buffer), value);
+    this->m_buffer.append(buffer, static_cast<std::size_t>(end - buffer));
+}
+
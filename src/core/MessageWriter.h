@@ -0,0 +1,32 @@
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <string_view>
+
+#include "types/Pilot.h"
+
+namespace vacdm::com {
+/// @brief Direct writer of the pilot creations which are sent to the backend
+///
+/// The writer serialises the fields of the messages into a reused buffer, no JSON document is built. The output is
+/// byte-identical to dump() of the equivalent JSON document: the keys are written in the sorted order of
+/// nlohmann::json objects and strings and numbers are formatted like the nlohmann serializer. The patches are not
+/// written here, they stay documents because they are merged and journaled before they are sent.
+/// The returned content stays valid until the next message is written.
+class MessageWriter {
+   public:
+    MessageWriter();
+
+    const std::string &pilotCreation(const types::Pilot &pilot);
+
+   private:
+    /// @brief starts a message with the callsign, which is the first key of every message
+    void begin(std::string_view callsign);
+    void string(std::string_view value);
+    void timestamp(const std::chrono::system_clock::time_point &timepoint);
+    void number(double value);
+
+    std::string m_buffer;
+};
+}  // namespace vacdm::com
@@ -0,0 +1,281 @@
+#include "OutboxJournal.h"
+
+#include <algorithm>
+#include <fstream>
+#include <set>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+using namespace vacdm::core;
+
+/// @brief size of the journal file in bytes after which it is truncated once all entries are acknowledged
+static constexpr std::size_t journalCompactionSize = 64 * 1024;
+
+OutboxJournal::OutboxJournal()
+    : m_lock(),
+      m_condition(),
+      m_writer(),
+      m_stop(false),
+      m_path(),
+      m_file(nullptr),
+      m_fileSize(0),
+      m_pendingLines(),
+      m_nextId(1),
+      m_maxAge(0),
+      m_entries() {}
+
+OutboxJournal::~OutboxJournal() {
+    {
+        std::lock_guard guard(this->m_lock);
+        this->m_stop = true;
+    }
+    this->m_condition.notify_all();
+
+    // the writer flushes the remaining lines before it stops
+    if (true == this->m_writer.joinable()) this->m_writer.join();
+    if (nullptr != this->m_file) std::fclose(this->m_file);
+}
+
+bool OutboxJournal::open(const std::string &path, std::chrono::minutes maxAge) {
+    std::lock_guard guard(this->m_lock);
+    if (nullptr != this->m_file) return true;
+
+    this->m_path = path;
+    this->m_maxAge = maxAge;
+
+    // restore the entries of the previous session which were not acknowledged
+    const auto now = std::chrono::system_clock::now();
+    std::ifstream stream(path);
+    std::string line;
+    while (std::getline(stream, line)) {
+        try {
+            const auto root = nlohmann::json::parse(line);
+            if (true == root.contains("ack")) {
+                for (const auto &id : root["ack"]) this->m_entries.erase(id.get<std::uint64_t>());
+                continue;
+            }
+
+            auto entry = OutboxJournal::deserialize(root);
+            this->m_nextId = std::max(this->m_nextId, entry.id + 1);
+            if (now - entry.journaledAt <= maxAge) this->m_entries.insert({entry.id, {std::move(entry), true}});
+        } catch (const std::exception &) {
+            // the last line is incomplete if the plugin stopped while it was written
+        }
+    }
+    stream.close();
+
+    // rewrite the journal with the restored entries only
+    this->m_file = std::fopen(path.c_str(), "wb");
+    if (nullptr == this->m_file) return false;
+
+    std::string lines;
+    for (const auto &entry : std::as_const(this->m_entries))
+        lines += OutboxJournal::serialize(entry.second.entry).dump() + "\n";
+    this->write(lines);
+
+    this->m_writer = std::thread(&OutboxJournal::run, this);
+    return true;
+}
+
+std::uint64_t OutboxJournal::append(int type, const std::string &callsign,
+                                    const std::chrono::system_clock::time_point &value,
+                                    const nlohmann::json &message) {
+    std::uint64_t id = 0;
+
+    {
+        std::lock_guard guard(this->m_lock);
+        if (nullptr == this->m_file) return 0;
+
+        id = this->m_nextId++;
+        Entry entry{id, type, callsign, value, std::chrono::system_clock::now(), message, {id}};
+
+        this->queueLine(OutboxJournal::serialize(entry));
+        this->m_entries.insert({id, {std::move(entry), false}});
+    }
+
+    this->m_condition.notify_one();
+    return id;
+}
+
+void OutboxJournal::acknowledge(const std::vector<std::uint64_t> &ids) {
+    if (true == ids.empty()) return;
+
+    {
+        std::lock_guard guard(this->m_lock);
+        if (nullptr == this->m_file) return;
+
+        for (const auto id : ids) this->m_entries.erase(id);
+        this->queueLine({{"ack", ids}});
+    }
+
+    this->m_condition.notify_one();
+}
+
+void OutboxJournal::discard() {
+    {
+        std::lock_guard guard(this->m_lock);
+        if (nullptr == this->m_file || true == this->m_entries.empty()) return;
+
+        std::vector<std::uint64_t> ids;
+        ids.reserve(this->m_entries.size());
+        for (const auto &entry : std::as_const(this->m_entries)) ids.push_back(entry.first);
+
+        this->m_entries.clear();
+        this->queueLine({{"ack", ids}});
+    }
+
+    this->m_condition.notify_one();
+}
+
+void OutboxJournal::reject(const std::vector<std::uint64_t> &ids) {
+    std::lock_guard guard(this->m_lock);
+
+    for (const auto id : ids) {
+        auto it = this->m_entries.find(id);
+        if (this->m_entries.end() != it) it->second.rejected = true;
+    }
+}
+
+std::list<OutboxJournal::Entry> OutboxJournal::takeReplayEntries() {
+    std::list<Entry> entries;
+
+    {
+        std::lock_guard guard(this->m_lock);
+
+        // drop the entries which are too old to be relevant
+        const auto now = std::chrono::system_clock::now();
+        std::vector<std::uint64_t> staleIds;
+        std::set<std::string> callsigns;
+        for (const auto &entry : std::as_const(this->m_entries)) {
+            if (now - entry.second.entry.journaledAt > this->m_maxAge)
+                staleIds.push_back(entry.first);
+            else if (true == entry.second.rejected)
+                callsigns.insert(entry.second.entry.callsign);
+        }
+        if (false == staleIds.empty()) {
+            for (const auto id : staleIds) this->m_entries.erase(id);
+            this->queueLine({{"ack", staleIds}});
+        }
+
+        // the entries are ordered by their ids, later entries overwrite the fields of earlier entries
+        std::map<std::string, std::list<Entry>::iterator> patches;
+        for (auto &journalEntry : this->m_entries) {
+            const auto &entry = journalEntry.second.entry;
+            if (false == callsigns.contains(entry.callsign)) continue;
+            journalEntry.second.rejected = false;
+
+            if (true == entry.message.is_null()) {
+                // the pilot is deleted, the earlier actions are acknowledged together with the delete
+                Entry deletion = entry;
+                deletion.ids.clear();
+                for (auto it = entries.begin(); it != entries.end();) {
+                    if (it->callsign == entry.callsign) {
+                        deletion.ids.insert(deletion.ids.end(), it->ids.begin(), it->ids.end());
+                        it = entries.erase(it);
+                    } else {
+                        ++it;
+                    }
+                }
+                deletion.ids.push_back(entry.id);
+                patches.erase(entry.callsign);
+                entries.push_back(std::move(deletion));
+                continue;
+            }
+
+            auto patch = patches.find(entry.callsign);
+            if (patches.end() == patch) {
+                entries.push_back(entry);
+                patches.insert({entry.callsign, std::prev(entries.end())});
+            } else {
+                patch->second->type = entry.type;
+                patch->second->value = entry.value;
+                patch->second->message.merge_patch(entry.message);
+                patch->second->ids.push_back(entry.id);
+            }
+        }
+    }
+
+    this->m_condition.notify_one();
+    return entries;
+}
+
+std::size_t OutboxJournal::pendingEntries() {
+    std::lock_guard guard(this->m_lock);
+    return this->m_entries.size();
+}
+
+void OutboxJournal::run() {
+    while (true) {
+        std::unique_lock lock(this->m_lock);
+        this->m_condition.wait(lock, [this]() { return true == this->m_stop || false == this->m_pendingLines.empty(); });
+        if (true == this->m_pendingLines.empty()) return;
+
+        // lines which are queued while the file is synced are written with the next batch
+        auto lines = std::move(this->m_pendingLines);
+        this->m_pendingLines.clear();
+        lock.unlock();
+
+        this->write(lines);
+
+        lock.lock();
+        if (true == this->m_entries.empty() && true == this->m_pendingLines.empty() &&
+            this->m_fileSize > journalCompactionSize) {
+            std::fclose(this->m_file);
+            this->m_file = std::fopen(this->m_path.c_str(), "wb");
+            this->m_fileSize = 0;
+            if (nullptr == this->m_file) return;
+        }
+    }
+}
+
+void OutboxJournal::queueLine(const nlohmann::json &line) {
+    this->m_pendingLines += line.dump();
+    this->m_pendingLines += '\n';
+}
+
+void OutboxJournal::write(const std::string &lines) {
+    if (true == lines.empty()) return;
+
+    std::fwrite(lines.data(), 1, lines.size(), this->m_file);
+    std::fflush(this->m_file);
+#ifdef _WIN32
+    _commit(_fileno(this->m_file));
+#else
+    fsync(fileno(this->m_file));
+#endif
+    this->m_fileSize += lines.size();
+}
+
+nlohmann::json OutboxJournal::serialize(const Entry &entry) {
+    nlohmann::json root;
+
+    root["id"] = entry.id;
+    root["type"] = entry.type;
+    root["callsign"] = entry.callsign;
+    root["value"] =
+        std::chrono::duration_cast<std::chrono::milliseconds>(entry.value.time_since_epoch()).count();
+    root["journaledAt"] =
+        std::chrono::duration_cast<std::chrono::milliseconds>(entry.journaledAt.time_since_epoch()).count();
+    root["message"] = entry.message;
+
+    return root;
+}
+
+OutboxJournal::Entry OutboxJournal::deserialize(const nlohmann::json &line) {
+    Entry entry;
+
+    entry.id = line["id"].get<std::uint64_t>();
+    entry.type = line["type"].get<int>();
+    entry.callsign = line["callsign"].get<std::string>();
+    entry.value = std::chrono::system_clock::time_point(std::chrono::milliseconds(line["value"].get<long long>()));
+    entry.journaledAt =
+        std::chrono::system_clock::time_point(std::chrono::milliseconds(line["journaledAt"].get<long long>()));
+    entry.message = line["message"];
+    entry.ids.push_back(entry.id);
+
+    return entry;
+}
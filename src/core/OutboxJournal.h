@@ -0,0 +1,89 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <list>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+namespace vacdm::core {
+/// @brief Append-only journal of the controller actions which have not been confirmed by the backend
+///
+/// Every action is appended as one JSON line, delivered actions are acknowledged by a later line. The lines are
+/// written and synced to disk by a writer thread in batches, appending only serializes the line and queues it.
+/// Actions which were not acknowledged are loaded again when the journal is opened and can be replayed.
+class OutboxJournal {
+   public:
+    struct Entry {
+        std::uint64_t id = 0;
+        /// @brief DataManager::MessageType of the action
+        int type = 0;
+        std::string callsign;
+        std::chrono::system_clock::time_point value;
+        std::chrono::system_clock::time_point journaledAt;
+        /// @brief patch content of the action, null if the action deletes the pilot
+        nlohmann::json message;
+        /// @brief ids of the entries which were merged into this entry
+        std::vector<std::uint64_t> ids;
+    };
+
+    OutboxJournal();
+    ~OutboxJournal();
+
+    /// @brief Opens the journal file, loads the entries which were not acknowledged and rewrites the file with them
+    /// @param path of the journal file, it is created if it does not exist
+    /// @param maxAge entries which are older are dropped, the pilot is most likely gone
+    /// @return true if the journal is writable
+    bool open(const std::string &path, std::chrono::minutes maxAge);
+    /// @brief Appends an action to the journal
+    /// @return the id of the entry, 0 if the journal is not open
+    std::uint64_t append(int type, const std::string &callsign, const std::chrono::system_clock::time_point &value,
+                         const nlohmann::json &message);
+    /// @brief Marks the entries as delivered, they are not replayed anymore
+    void acknowledge(const std::vector<std::uint64_t> &ids);
+    /// @brief Acknowledges all entries without sending them, used when the pilot data is cleared
+    void discard();
+    /// @brief Marks the entries as not delivered, they are returned by the next takeReplayEntries
+    void reject(const std::vector<std::uint64_t> &ids);
+    /// @brief Returns the entries which have to be sent again.
+    /// All entries of a pilot with a rejected entry are returned, deduplicated into a delete and one patch which
+    /// contains the latest value of every field. The returned entries count as sent until they are acknowledged or
+    /// rejected.
+    std::list<Entry> takeReplayEntries();
+    std::size_t pendingEntries();
+
+   private:
+    struct JournalEntry {
+        Entry entry;
+        bool rejected = false;
+    };
+
+    void run();
+    /// @brief queues a line for the writer thread, requires m_lock
+    void queueLine(const nlohmann::json &line);
+    /// @brief writes the lines and syncs the file, called by the writer thread
+    void write(const std::string &lines);
+    static nlohmann::json serialize(const Entry &entry);
+    static Entry deserialize(const nlohmann::json &line);
+
+    std::mutex m_lock;
+    std::condition_variable m_condition;
+    std::thread m_writer;
+    bool m_stop;
+
+    std::string m_path;
+    std::FILE *m_file;
+    std::size_t m_fileSize;
+    std::string m_pendingLines;
+    std::uint64_t m_nextId;
+    std::chrono::minutes m_maxAge;
+    std::map<std::uint64_t, JournalEntry> m_entries;
+};
+}  // namespace vacdm::core
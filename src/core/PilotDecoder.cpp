@@ -0,0 +1,365 @@
+#include "PilotDecoder.h"
+
+#include <algorithm>
+#include <string_view>
+#include <unordered_map>
+
+#include "utils/Date.h"
+
+using namespace vacdm::com;
+
+PilotDecoder::PilotDecoder()
+    : m_contexts(), m_key(Key::Unknown), m_pilotIsValid(false), m_pilotHasCallsign(false), m_pilots(),
+      m_skippedPilots(0), m_errorMessage() {
+    this->m_contexts.reserve(4);
+}
+
+bool PilotDecoder::decode(const std::string &body) {
+    this->m_contexts.clear();
+    this->m_key = Key::Unknown;
+    this->m_pilots.clear();
+    this->m_skippedPilots = 0;
+    this->m_errorMessage.clear();
+
+    return nlohmann::json::sax_parse(body, this);
+}
+
+PilotDecoder::Key PilotDecoder::keyFromName(const std::string &name) {
+    static const std::unordered_map<std::string_view, Key> keys = {
+        {"callsign", Key::Callsign},
+        {"updatedAt", Key::UpdatedAt},
+        {"inactive", Key::Inactive},
+        {"position", Key::Position},
+        {"lat", Key::Lat},
+        {"lon", Key::Lon},
+        {"vacdm", Key::Vacdm},
+        {"taxizoneIsTaxiout", Key::TaxizoneIsTaxiout},
+        {"eobt", Key::Eobt},
+        {"tobt", Key::Tobt},
+        {"tobt_state", Key::TobtState},
+        {"ctot", Key::Ctot},
+        {"ttot", Key::Ttot},
+        {"tsat", Key::Tsat},
+        {"exot", Key::Exot},
+        {"asat", Key::Asat},
+        {"aobt", Key::Aobt},
+        {"atot", Key::Atot},
+        {"asrt", Key::Asrt},
+        {"aort", Key::Aort},
+        {"flightplan", Key::Flightplan},
+        {"departure", Key::Departure},
+        {"arrival", Key::Arrival},
+        {"clearance", Key::Clearance},
+        {"dep_rwy", Key::DepRwy},
+        {"sid", Key::Sid},
+        {"measures", Key::Measures},
+        {"ident", Key::Ident},
+        {"value", Key::Value},
+        {"hasBooking", Key::HasBooking},
+    };
+
+    const auto it = keys.find(name);
+    return keys.cend() != it ? it->second : Key::Unknown;
+}
+
+PilotDecoder::Context PilotDecoder::contextOf(Key key) {
+    switch (key) {
+        case Key::Callsign:
+        case Key::UpdatedAt:
+        case Key::Inactive:
+        case Key::Position:
+        case Key::Vacdm:
+        case Key::Flightplan:
+        case Key::Clearance:
+        case Key::Measures:
+        case Key::HasBooking:
+            return Context::Pilot;
+        case Key::Lat:
+        case Key::Lon:
+            return Context::Position;
+        case Key::TaxizoneIsTaxiout:
+        case Key::Eobt:
+        case Key::Tobt:
+        case Key::TobtState:
+        case Key::Ctot:
+        case Key::Ttot:
+        case Key::Tsat:
+        case Key::Exot:
+        case Key::Asat:
+        case Key::Aobt:
+        case Key::Atot:
+        case Key::Asrt:
+        case Key::Aort:
+            return Context::Vacdm;
+        case Key::Departure:
+        case Key::Arrival:
+            return Context::Flightplan;
+        case Key::DepRwy:
+        case Key::Sid:
+            return Context::Clearance;
+        case Key::Ident:
+        case Key::Value:
+            return Context::Measure;
+        default:
+            return Context::Skip;
+    }
+}
+
+bool PilotDecoder::isInPilot() const {
+    return std::find(this->m_contexts.cbegin(), this->m_contexts.cend(), Context::Pilot) != this->m_contexts.cend();
+}
+
+bool PilotDecoder::hasValueContext() const {
+    if (true == this->m_contexts.empty()) return false;
+
+    switch (this->m_contexts.back()) {
+        case Context::Pilot:
+        case Context::Position:
+        case Context::Vacdm:
+        case Context::Flightplan:
+        case Context::Clearance:
+        case Context::Measure:
+            return true;
+        default:
+            return false;
+    }
+}
+
+vacdm::types::CompactTime *PilotDecoder::timeField() {
+    auto &pilot = this->m_pilots.back();
+
+    switch (this->m_key) {
+        case Key::UpdatedAt:
+            return &pilot.lastUpdate;
+        case Key::Eobt:
+            return &pilot.eobt;
+        case Key::Tobt:
+            return &pilot.tobt;
+        case Key::Ctot:
+            return &pilot.ctot;
+        case Key::Ttot:
+            return &pilot.ttot;
+        case Key::Tsat:
+            return &pilot.tsat;
+        case Key::Asat:
+            return &pilot.asat;
+        case Key::Aobt:
+            return &pilot.aobt;
+        case Key::Atot:
+            return &pilot.atot;
+        case Key::Asrt:
+            return &pilot.asrt;
+        case Key::Aort:
+            return &pilot.aort;
+        default:
+            return nullptr;
+    }
+}
+
+bool PilotDecoder::malformed() {
+    this->m_pilotIsValid = false;
+    return true;
+}
+
+bool PilotDecoder::number(double value) {
+    if (false == this->hasValueContext() || Key::Unknown == this->m_key) return true;
+
+    auto &pilot = this->m_pilots.back();
+    switch (this->m_key) {
+        case Key::Lat:
+            pilot.latitude = value;
+            return true;
+        case Key::Lon:
+            pilot.longitude = value;
+            return true;
+        case Key::Exot:
+            pilot.exot = std::chrono::system_clock::time_point(std::chrono::minutes(static_cast<long int>(value)));
+            return true;
+        case Key::Value:
+            pilot.measures.back().value = static_cast<int>(value);
+            return true;
+        default:
+            return this->malformed();
+    }
+}
+
+bool PilotDecoder::null() {
+    // missing values keep their defaults, a pilot without a callsign is dropped at the end of the object
+    return true;
+}
+
+bool PilotDecoder::boolean(bool val) {
+    if (false == this->hasValueContext() || Key::Unknown == this->m_key) return true;
+
+    auto &pilot = this->m_pilots.back();
+    switch (this->m_key) {
+        case Key::Inactive:
+            pilot.inactive = val;
+            return true;
+        case Key::TaxizoneIsTaxiout:
+            pilot.taxizoneIsTaxiout = val;
+            return true;
+        case Key::HasBooking:
+            pilot.hasBooking = val;
+            return true;
+        default:
+            return this->malformed();
+    }
+}
+
+bool PilotDecoder::number_integer(number_integer_t val) { return this->number(static_cast<double>(val)); }
+
+bool PilotDecoder::number_unsigned(number_unsigned_t val) { return this->number(static_cast<double>(val)); }
+
+bool PilotDecoder::number_float(number_float_t val, const string_t &s) {
+    std::ignore = s;
+    return this->number(val);
+}
+
+bool PilotDecoder::string(string_t &val) {
+    if (false == this->hasValueContext() || Key::Unknown == this->m_key) return true;
+
+    auto &pilot = this->m_pilots.back();
+    auto timepoint = this->timeField();
+    if (nullptr != timepoint) {
+        *timepoint = utils::Date::isoStringToTimestamp(val);
+        return true;
+    }
+
+    switch (this->m_key) {
+        case Key::Callsign:
+            if (false == pilot.callsign.assign(val)) return this->malformed();
+            this->m_pilotHasCallsign = false == pilot.callsign.empty();
+            return true;
+        case Key::TobtState:
+            pilot.tobt_state = types::tobtStateFromString(val);
+            return true;
+        case Key::Departure:
+            if (false == pilot.origin.assign(val)) return this->malformed();
+            return true;
+        case Key::Arrival:
+            if (false == pilot.destination.assign(val)) return this->malformed();
+            return true;
+        case Key::DepRwy:
+            if (false == pilot.runway.assign(val)) return this->malformed();
+            return true;
+        case Key::Sid:
+            if (false == pilot.sid.assign(val)) return this->malformed();
+            return true;
+        case Key::Ident:
+            pilot.measures.back().ident = std::move(val);
+            return true;
+        default:
+            return this->malformed();
+    }
+}
+
+bool PilotDecoder::binary(binary_t &val) {
+    std::ignore = val;
+    return true;
+}
+
+bool PilotDecoder::start_object(std::size_t elements) {
+    std::ignore = elements;
+
+    if (true == this->m_contexts.empty()) {
+        // the response is not a list of pilots
+        this->m_contexts.push_back(Context::Skip);
+        return true;
+    }
+
+    switch (this->m_contexts.back()) {
+        case Context::Root:
+            this->m_pilots.emplace_back();
+            this->m_pilotIsValid = true;
+            this->m_pilotHasCallsign = false;
+            this->m_contexts.push_back(Context::Pilot);
+            return true;
+        case Context::Measures:
+            this->m_pilots.back().measures.emplace_back();
+            this->m_contexts.push_back(Context::Measure);
+            return true;
+        case Context::Pilot:
+            switch (this->m_key) {
+                case Key::Position:
+                    this->m_contexts.push_back(Context::Position);
+                    return true;
+                case Key::Vacdm:
+                    this->m_contexts.push_back(Context::Vacdm);
+                    return true;
+                case Key::Flightplan:
+                    this->m_contexts.push_back(Context::Flightplan);
+                    return true;
+                case Key::Clearance:
+                    this->m_contexts.push_back(Context::Clearance);
+                    return true;
+                default:
+                    break;
+            }
+            break;
+        default:
+            break;
+    }
+
+    if (true == this->hasValueContext() && Key::Unknown != this->m_key) this->malformed();
+    this->m_contexts.push_back(Context::Skip);
+    return true;
+}
+
+bool PilotDecoder::end_object() {
+    const auto context = this->m_contexts.back();
+    this->m_contexts.pop_back();
+
+    if (Context::Pilot == context && (false == this->m_pilotIsValid || false == this->m_pilotHasCallsign)) {
+        this->m_pilots.pop_back();
+        this->m_skippedPilots += 1;
+    }
+
+    return true;
+}
+
+bool PilotDecoder::start_array(std::size_t elements) {
+    std::ignore = elements;
+
+    if (true == this->m_contexts.empty()) {
+        this->m_contexts.push_back(Context::Root);
+        return true;
+    }
+
+    if (Context::Pilot == this->m_contexts.back() && Key::Measures == this->m_key) {
+        this->m_contexts.push_back(Context::Measures);
+        return true;
+    }
+
+    if (true == this->hasValueContext() && Key::Unknown != this->m_key) this->malformed();
+    this->m_contexts.push_back(Context::Skip);
+    return true;
+}
+
+bool PilotDecoder::end_array() {
+    this->m_contexts.pop_back();
+    return true;
+}
+
+bool PilotDecoder::key(string_t &val) {
+    if (false == this->hasValueContext()) return true;
+
+    const auto key = PilotDecoder::keyFromName(val);
+    this->m_key = PilotDecoder::contextOf(key) == this->m_contexts.back() ? key : Key::Unknown;
+    return true;
+}
+
+bool PilotDecoder::parse_error(std::size_t position, const std::string &last_token,
+                               const nlohmann::detail::exception &ex) {
+    std::ignore = position;
+    std::ignore = last_token;
+
+    // the pilots which were completed before the error are kept
+    if (true == this->isInPilot()) {
+        this->m_pilots.pop_back();
+        this->m_skippedPilots += 1;
+    }
+    this->m_errorMessage = ex.what();
+
+    return false;
+}
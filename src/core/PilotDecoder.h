@@ -0,0 +1,119 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <list>
+#include <string>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include "types/Pilot.h"
+
+namespace vacdm::com {
+/// @brief Streaming decoder of the pilots response of the backend
+///
+/// The decoder receives the SAX events of the JSON parser and fills the pilots directly, no JSON document is built.
+/// Unknown fields are skipped. A pilot with a wrongly typed or missing callsign is dropped while all other pilots of
+/// the response are kept.
+class PilotDecoder : public nlohmann::json_sax<nlohmann::json> {
+   public:
+    PilotDecoder();
+
+    /// @brief Decodes the content of a pilots response
+    /// @param body JSON content of the response
+    /// @return true if the complete content was valid JSON
+    bool decode(const std::string &body);
+
+    std::list<types::Pilot> &pilots() { return m_pilots; }
+    /// @brief number of pilots which were dropped because of malformed values
+    std::size_t skippedPilots() const { return m_skippedPilots; }
+    const std::string &errorMessage() const { return m_errorMessage; }
+
+    bool null() override;
+    bool boolean(bool val) override;
+    bool number_integer(number_integer_t val) override;
+    bool number_unsigned(number_unsigned_t val) override;
+    bool number_float(number_float_t val, const string_t &s) override;
+    bool string(string_t &val) override;
+    bool binary(binary_t &val) override;
+    bool start_object(std::size_t elements) override;
+    bool end_object() override;
+    bool start_array(std::size_t elements) override;
+    bool end_array() override;
+    bool key(string_t &val) override;
+    bool parse_error(std::size_t position, const std::string &last_token,
+                     const nlohmann::detail::exception &ex) override;
+
+   private:
+    /// @brief the container the parser is currently in
+    enum class Context : std::uint8_t {
+        Root,
+        Pilot,
+        Position,
+        Vacdm,
+        Flightplan,
+        Clearance,
+        Measures,
+        Measure,
+        Skip,
+    };
+
+    /// @brief the known keys of the pilot schema
+    enum class Key : std::uint8_t {
+        Unknown,
+        Callsign,
+        UpdatedAt,
+        Inactive,
+        Position,
+        Lat,
+        Lon,
+        Vacdm,
+        TaxizoneIsTaxiout,
+        Eobt,
+        Tobt,
+        TobtState,
+        Ctot,
+        Ttot,
+        Tsat,
+        Exot,
+        Asat,
+        Aobt,
+        Atot,
+        Asrt,
+        Aort,
+        Flightplan,
+        Departure,
+        Arrival,
+        Clearance,
+        DepRwy,
+        Sid,
+        Measures,
+        Ident,
+        Value,
+        HasBooking,
+    };
+
+    static Key keyFromName(const std::string &name);
+    /// @brief returns the object in which the key is part of the schema
+    static Context contextOf(Key key);
+    /// @brief checks if the parser is inside of a pilot object
+    bool isInPilot() const;
+    /// @brief checks if the current container is an object of the schema which has values
+    bool hasValueContext() const;
+    /// @brief returns the time point field of the current pilot which belongs to the current key
+    types::CompactTime *timeField();
+    /// @brief handles a number of the current key
+    bool number(double value);
+    /// @brief marks the current pilot as malformed, it is dropped at the end of the object
+    bool malformed();
+
+    std::vector<Context> m_contexts;
+    Key m_key;
+    bool m_pilotIsValid;
+    bool m_pilotHasCallsign;
+    std::list<types::Pilot> m_pilots;
+    std::size_t m_skippedPilots;
+    std::string m_errorMessage;
+};
+}  // namespace vacdm::com
@@ -0,0 +1,218 @@
+#include "PilotEventStream.h"
+
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+
+#include "PilotDecoder.h"
+#include "Version.h"
+
+using namespace vacdm;
+using namespace vacdm::com;
+using namespace vacdm::logging;
+
+PilotEventStream::PilotEventStream(logging::Logger *vacdmLogger)
+    : m_lock(),
+      m_condition(),
+      m_worker(),
+      m_stop(false),
+      m_subscriptionChanged(false),
+      m_connected(false),
+      m_client(nullptr),
+      m_baseUrl(),
+      m_authToken(),
+      m_airports(),
+      m_changedPilots(),
+      vacdmLogger_(vacdmLogger) {
+    this->m_worker = std::thread(&PilotEventStream::run, this);
+}
+
+PilotEventStream::~PilotEventStream() {
+    {
+        std::lock_guard guard(this->m_lock);
+        this->m_stop = true;
+        if (nullptr != this->m_client) this->m_client->stop();
+    }
+    this->m_condition.notify_all();
+    this->m_worker.join();
+}
+
+void PilotEventStream::subscribe(const std::string &baseUrl, const std::string &authToken,
+                                 const std::list<std::string> &airports) {
+    {
+        std::lock_guard guard(this->m_lock);
+        if (this->m_baseUrl == baseUrl && this->m_authToken == authToken && this->m_airports == airports) return;
+
+        this->m_baseUrl = baseUrl;
+        this->m_authToken = authToken;
+        this->m_airports = airports;
+        this->m_subscriptionChanged = true;
+        this->m_changedPilots.clear();
+
+        // interrupt the running subscription, it is opened again with the new airports
+        if (nullptr != this->m_client) this->m_client->stop();
+    }
+    this->m_condition.notify_all();
+}
+
+bool PilotEventStream::connected() const { return this->m_connected; }
+
+std::list<types::Pilot> PilotEventStream::takePilots() {
+    std::lock_guard guard(this->m_lock);
+
+    std::list<types::Pilot> pilots;
+    for (auto &pilot : this->m_changedPilots) pilots.push_back(std::move(pilot.second));
+    this->m_changedPilots.clear();
+
+    return pilots;
+}
+
+void PilotEventStream::run() {
+    std::unique_lock lock(this->m_lock);
+    auto reconnectDelay = std::chrono::duration_cast<std::chrono::milliseconds>(eventStreamReconnectDelay);
+
+    while (true) {
+        this->m_condition.wait(lock, [this]() { return true == this->m_stop || false == this->m_airports.empty(); });
+        if (true == this->m_stop) return;
+        this->m_subscriptionChanged = false;
+
+        const std::string url = "/api/v1/pilots/events?adep=" +
+                                std::accumulate(std::next(this->m_airports.begin()), this->m_airports.end(),
+                                                this->m_airports.front(), [](const std::string &acc, const std::string &airport) {
+                                                    return acc + "," + airport;
+                                                });
+
+        httplib::Client client(this->m_baseUrl);
+        client.set_connection_timeout(2);
+        // the backend sends a keep-alive comment in between the events
+        client.set_read_timeout(60);
+        client.enable_server_certificate_verification(false);
+        client.enable_server_hostname_verification(false);
+        // a compressed stream is buffered by the compressor, the events would arrive late
+        client.set_default_headers({{"Accept", "text/event-stream"},
+                                    {"Accept-Encoding", "identity"},
+                                    {"User-Agent", "VACDM Plugin Neo/" + std::string(PLUGIN_VERSION)}});
+        if (false == this->m_authToken.empty()) client.set_bearer_token_auth(this->m_authToken);
+        this->m_client = &client;
+
+        lock.unlock();
+        const bool accepted = this->receive(client, url);
+        lock.lock();
+
+        this->m_client = nullptr;
+        this->m_connected = false;
+        if (true == this->m_stop) return;
+        if (true == this->m_subscriptionChanged) {
+            reconnectDelay = std::chrono::duration_cast<std::chrono::milliseconds>(eventStreamReconnectDelay);
+            continue;
+        }
+
+        // the pilots are polled until the subscription is established again
+        if (vacdmLogger_)
+            vacdmLogger_->log(Logger::LogSender::Server,
+                               "Pilot event subscription closed, polling the pilots, reconnecting in " +
+                                   std::to_string(reconnectDelay.count()) + "ms",
+                               Logger::LogLevel::Info);
+        this->m_condition.wait_for(lock, reconnectDelay,
+                                   [this]() { return true == this->m_stop || true == this->m_subscriptionChanged; });
+
+        if (true == accepted)
+            reconnectDelay = std::chrono::duration_cast<std::chrono::milliseconds>(eventStreamReconnectDelay);
+        else
+            reconnectDelay = std::min(reconnectDelay * 2,
+                                      std::chrono::duration_cast<std::chrono::milliseconds>(eventStreamMaxReconnectDelay));
+    }
+}
+
+bool PilotEventStream::receive(httplib::Client &client, const std::string &url) {
+    std::string buffer;
+    bool accepted = false;
+
+    client.Get(
+        url, httplib::Headers(),
+        [this, &accepted](const httplib::Response &response) {
+            accepted = 200 == response.status;
+            this->m_connected = accepted;
+
+            if (vacdmLogger_)
+                vacdmLogger_->log(Logger::LogSender::Server,
+                                   true == accepted ? "Subscribed to the pilot events"
+                                                    : "Pilot events not available: " + std::to_string(response.status),
+                                   Logger::LogLevel::Info);
+            return accepted;
+        },
+        [this, &buffer](const char *data, std::size_t length) {
+            buffer.append(data, length);
+            this->processEvents(buffer);
+            return false == this->subscriptionOutdated();
+        });
+
+    return accepted;
+}
+
+void PilotEventStream::processEvents(std::string &buffer) {
+    // events are separated by an empty line, the lines may end with CRLF
+    std::erase(buffer, '\r');
+
+    std::size_t end;
+    while (std::string::npos != (end = buffer.find("\n\n"))) {
+        std::string event = "message";
+        std::string data;
+
+        std::size_t start = 0;
+        while (start < end) {
+            auto lineEnd = buffer.find('\n', start);
+            if (std::string::npos == lineEnd || lineEnd > end) lineEnd = end;
+            const std::string_view line(buffer.data() + start, lineEnd - start);
+            start = lineEnd + 1;
+
+            // comments keep the connection alive
+            if (true == line.empty() || ':' == line.front()) continue;
+
+            const auto separator = line.find(':');
+            const auto field = line.substr(0, separator);
+            auto value = std::string_view::npos != separator ? line.substr(separator + 1) : std::string_view();
+            if (false == value.empty() && ' ' == value.front()) value.remove_prefix(1);
+
+            if ("event" == field) {
+                event = value;
+            } else if ("data" == field) {
+                if (false == data.empty()) data += '\n';
+                data += value;
+            }
+        }
+
+        buffer.erase(0, end + 2);
+        if (false == data.empty()) this->handleEvent(event, data);
+    }
+}
+
+void PilotEventStream::handleEvent(const std::string &event, const std::string &data) {
+    std::list<types::Pilot> pilots;
+
+    if ("pilot" == event) {
+        PilotDecoder decoder;
+        decoder.decode("[" + data + "]");
+        pilots = std::move(decoder.pilots());
+    } else if ("delete" == event) {
+        try {
+            types::Pilot pilot;
+            if (false == pilot.callsign.assign(nlohmann::json::parse(data)["callsign"].get<std::string>()))
+                throw std::length_error("the callsign is too long");
+            pilot.inactive = true;
+            pilots.push_back(std::move(pilot));
+        } catch (const std::exception &e) {
+            if (vacdmLogger_)
+                vacdmLogger_->log(Logger::LogSender::Server, "Failed to parse pilot event: " + std::string(e.what()),
+                                   Logger::LogLevel::Info);
+        }
+    }
+
+    std::lock_guard guard(this->m_lock);
+    for (auto &pilot : pilots) this->m_changedPilots[pilot.callsign.str()] = std::move(pilot);
+}
+
+bool PilotEventStream::subscriptionOutdated() {
+    std::lock_guard guard(this->m_lock);
+    return true == this->m_stop || true == this->m_subscriptionChanged;
+}
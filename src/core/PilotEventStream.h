@@ -0,0 +1,70 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <list>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "core/Http.h"
+#include "log/Logger.h"
+#include "types/Pilot.h"
+
+namespace vacdm::com {
+/// @brief time after which a closed or refused subscription is opened again, doubled on every failed attempt
+constexpr std::chrono::seconds eventStreamReconnectDelay = std::chrono::seconds(5);
+constexpr std::chrono::seconds eventStreamMaxReconnectDelay = std::chrono::seconds(120);
+
+/// @brief Subscription to the pilot change events of the backend
+///
+/// The events are received as server-sent events on /api/v1/pilots/events. A "pilot" event contains a pilot in the
+/// format of the pilots endpoint, a "delete" event the callsign of a removed pilot. The subscription runs in its own
+/// thread and reconnects with an increasing delay if the backend closes or refuses it.
+class PilotEventStream {
+   public:
+    PilotEventStream(logging::Logger *vacdmLogger);
+    ~PilotEventStream();
+
+    /// @brief Subscribes to the events of the airports, replaces the previous subscription
+    /// @param baseUrl address of the backend
+    /// @param authToken token of the backend, empty if not required
+    /// @param airports ICAO codes of the airports, an empty list closes the subscription
+    void subscribe(const std::string &baseUrl, const std::string &authToken, const std::list<std::string> &airports);
+    /// @brief Checks if the subscription is established and delivers events
+    bool connected() const;
+    /// @brief Returns the pilots which changed since the last call, only the latest change of a pilot is returned.
+    /// Removed pilots are returned as inactive pilots.
+    std::list<types::Pilot> takePilots();
+
+   private:
+    /// @brief the fixture of the unit tests feeds the event parser
+    friend class PilotEventStreamTest;
+
+    void run();
+    /// @brief receives the events until the backend closes the stream or the subscription changes
+    /// @return true if the backend accepted the subscription
+    bool receive(httplib::Client &client, const std::string &url);
+    /// @brief handles all complete events of the buffer and removes them
+    void processEvents(std::string &buffer);
+    void handleEvent(const std::string &event, const std::string &data);
+    bool subscriptionOutdated();
+
+    mutable std::mutex m_lock;
+    std::condition_variable m_condition;
+    std::thread m_worker;
+    bool m_stop;
+    bool m_subscriptionChanged;
+    std::atomic<bool> m_connected;
+    httplib::Client *m_client;
+
+    std::string m_baseUrl;
+    std::string m_authToken;
+    std::list<std::string> m_airports;
+    std::map<std::string, types::Pilot> m_changedPilots;
+
+    logging::Logger *vacdmLogger_ = nullptr;
+};
+}  // namespace vacdm::com
@@ -0,0 +1,31 @@
+#include "PilotSnapshotStore.h"
+
+using namespace vacdm;
+using namespace vacdm::core;
+
+PilotSnapshotStore::PilotSnapshotStore() : m_writeLock(), m_snapshot(std::make_shared<const Snapshot>()) {}
+
+std::shared_ptr<const PilotSnapshotStore::Snapshot> PilotSnapshotStore::snapshot() const {
+    return this->m_snapshot.load();
+}
+
+void PilotSnapshotStore::clear() {
+    std::lock_guard guard(this->m_writeLock);
+
+    auto next = std::make_shared<Snapshot>();
+    next->version = this->m_snapshot.load()->version + 1;
+    this->m_snapshot.store(std::move(next));
+}
+
+PilotRecord &PilotSnapshotStore::modify(std::shared_ptr<const PilotRecord> &record) {
+    // a record which is only referenced by the working copy is not visible to readers, it was created or copied by
+    // the running transaction and can be changed in place
+    if (1 != record.use_count()) record = PilotSnapshotStore::makeRecord(*record);
+
+    // all records are created by makeRecord as non-const objects
+    return const_cast<PilotRecord &>(*record);
+}
+
+std::shared_ptr<const PilotRecord> PilotSnapshotStore::makeRecord(PilotRecord record) {
+    return std::make_shared<PilotRecord>(std::move(record));
+}
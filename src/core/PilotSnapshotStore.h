@@ -0,0 +1,63 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "types/Pilot.h"
+#include "utils/AtomicSharedPtr.h"
+
+namespace vacdm::core {
+/// @brief consolidated, Scope and backend data of a pilot
+using PilotRecord = std::array<types::Pilot, 3>;
+
+/// @brief Versioned, copy-on-write store of the pilots
+///
+/// Readers copy the pointer to the current snapshot and keep it alive as long as they use it, a snapshot is never
+/// changed after it has been published. Writers run transactions on a working copy of the snapshot which shares the
+/// records of all pilots, only the records which are changed by the transaction are copied. The working copy is
+/// published atomically as the next version once the transaction is done.
+class PilotSnapshotStore {
+   public:
+    using Pilots = std::map<std::string, std::shared_ptr<const PilotRecord>>;
+
+    struct Snapshot {
+        std::uint64_t version = 0;
+        Pilots pilots;
+    };
+
+    PilotSnapshotStore();
+
+    /// @brief Returns the current snapshot, does not wait for running transactions
+    std::shared_ptr<const Snapshot> snapshot() const;
+
+    /// @brief Runs a write transaction, the transactions are serialised
+    /// @param transaction called with the working copy of the pilots, changes records through modify()
+    template <typename Transaction>
+    void update(Transaction &&transaction) {
+        std::lock_guard guard(this->m_writeLock);
+
+        const auto current = this->m_snapshot.load();
+        auto next = std::make_shared<Snapshot>();
+        next->version = current->version + 1;
+        next->pilots = current->pilots;
+
+        transaction(next->pilots);
+        this->m_snapshot.store(std::move(next));
+    }
+
+    /// @brief Publishes an empty snapshot
+    void clear();
+
+    /// @brief Returns the record for changes in a transaction, copies it if it is shared with a published snapshot
+    static PilotRecord &modify(std::shared_ptr<const PilotRecord> &record);
+    static std::shared_ptr<const PilotRecord> makeRecord(PilotRecord record);
+
+   private:
+    std::mutex m_writeLock;
+    utils::AtomicSharedPtr<const Snapshot> m_snapshot;
+};
+}  // namespace vacdm::core
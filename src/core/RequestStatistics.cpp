@@ -0,0 +1,121 @@
+#include "RequestStatistics.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <limits>
+
+using namespace vacdm::com;
+
+LatencyHistogram::LatencyHistogram() : m_count(0), m_total(0), m_max(0), m_buckets() {
+    for (auto &bucket : m_buckets) bucket.store(0, std::memory_order_relaxed);
+}
+
+std::size_t LatencyHistogram::bucketOf(std::uint64_t microseconds) {
+    // the smallest durations have a bucket of their own
+    if (microseconds < subBuckets) return static_cast<std::size_t>(microseconds);
+
+    const std::size_t exponent = std::min<std::size_t>(std::bit_width(microseconds) - 1, maxExponent);
+    if (exponent == maxExponent && microseconds >= (std::uint64_t(1) << (maxExponent + 1))) return bucketCount - 1;
+
+    // the bits after the leading one select the bucket within the power of two
+    const std::size_t subBucket = (microseconds >> (exponent - subBucketBits)) & (subBuckets - 1);
+    return subBuckets + (exponent - subBucketBits) * subBuckets + subBucket;
+}
+
+std::uint64_t LatencyHistogram::bucketLimit(std::size_t bucket) {
+    if (bucket < subBuckets) return bucket + 1;
+    // the last bucket contains all longer durations as well, the percentiles of it are limited by the maximum
+    if (bucketCount - 1 <= bucket) return std::numeric_limits<std::uint64_t>::max();
+
+    const std::size_t exponent = (bucket - subBuckets) / subBuckets + subBucketBits;
+    const std::uint64_t subBucket = (bucket - subBuckets) % subBuckets;
+    return (subBuckets + subBucket + 1) << (exponent - subBucketBits);
+}
+
+void LatencyHistogram::record(std::chrono::microseconds duration) {
+    const auto microseconds = static_cast<std::uint64_t>(std::max<std::int64_t>(duration.count(), 0));
+
+    m_buckets[LatencyHistogram::bucketOf(microseconds)].fetch_add(1, std::memory_order_relaxed);
+    m_count.fetch_add(1, std::memory_order_relaxed);
+    m_total.fetch_add(microseconds, std::memory_order_relaxed);
+
+    auto max = m_max.load(std::memory_order_relaxed);
+    while (max < microseconds && false == m_max.compare_exchange_weak(max, microseconds, std::memory_order_relaxed)) {
+    }
+}
+
+LatencyHistogram::Snapshot LatencyHistogram::snapshot() const {
+    Snapshot snapshot;
+
+    // the counters are read one after another, concurrent recordings may be missing in some of them
+    for (std::size_t i = 0; i < bucketCount; ++i) {
+        snapshot.buckets[i] = m_buckets[i].load(std::memory_order_relaxed);
+        snapshot.count += snapshot.buckets[i];
+    }
+    snapshot.total = std::chrono::microseconds(m_total.load(std::memory_order_relaxed));
+    snapshot.max = std::chrono::microseconds(m_max.load(std::memory_order_relaxed));
+
+    return snapshot;
+}
+
+std::chrono::microseconds LatencyHistogram::Snapshot::percentile(double percentile) const {
+    if (0 == this->count) return std::chrono::microseconds(0);
+
+    const auto rank = static_cast<std::uint64_t>(std::ceil(std::clamp(percentile, 0.0, 100.0) / 100.0 *
+                                                           static_cast<double>(this->count)));
+    std::uint64_t cumulative = 0;
+    for (std::size_t i = 0; i < bucketCount; ++i) {
+        cumulative += this->buckets[i];
+        if (cumulative >= std::max<std::uint64_t>(rank, 1)) {
+            // compared before the conversion, the limit of the last bucket does not fit into the duration
+            const auto limit = LatencyHistogram::bucketLimit(i) - 1;
+            return std::chrono::microseconds(std::min(limit, static_cast<std::uint64_t>(this->max.count())));
+        }
+    }
+
+    return this->max;
+}
+
+std::chrono::microseconds LatencyHistogram::Snapshot::mean() const {
+    if (0 == this->count) return std::chrono::microseconds(0);
+    return this->total / this->count;
+}
+
+RequestStatistics::RequestStatistics()
+    : m_latency(), m_failures(0), m_bytesSent(0), m_bytesReceived(0), m_errorStatuses() {
+    for (auto &counter : m_errorStatuses) counter.store(0, std::memory_order_relaxed);
+}
+
+void RequestStatistics::record(std::chrono::microseconds duration, int status, std::size_t bytesSent,
+                               std::size_t bytesReceived) {
+    m_latency.record(duration);
+    m_bytesSent.fetch_add(bytesSent, std::memory_order_relaxed);
+    m_bytesReceived.fetch_add(bytesReceived, std::memory_order_relaxed);
+
+    if (minErrorStatus <= status && maxErrorStatus >= status)
+        m_errorStatuses[static_cast<std::size_t>(status - minErrorStatus)].fetch_add(1, std::memory_order_relaxed);
+}
+
+void RequestStatistics::recordFailure(std::chrono::microseconds duration, std::size_t bytesSent) {
+    m_latency.record(duration);
+    m_bytesSent.fetch_add(bytesSent, std::memory_order_relaxed);
+    m_failures.fetch_add(1, std::memory_order_relaxed);
+}
+
+RequestStatistics::Snapshot RequestStatistics::snapshot() const {
+    Snapshot snapshot;
+
+    snapshot.latency = m_latency.snapshot();
+    snapshot.requests = snapshot.latency.count;
+    snapshot.failures = m_failures.load(std::memory_order_relaxed);
+    snapshot.bytesSent = m_bytesSent.load(std::memory_order_relaxed);
+    snapshot.bytesReceived = m_bytesReceived.load(std::memory_order_relaxed);
+
+    for (std::size_t i = 0; i < m_errorStatuses.size(); ++i) {
+        const auto count = m_errorStatuses[i].load(std::memory_order_relaxed);
+        if (0 != count) snapshot.errorStatuses[minErrorStatus + static_cast<int>(i)] = count;
+    }
+
+    return snapshot;
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+
+namespace vacdm::com {
+/// @brief Histogram of durations with logarithmic buckets
+///
+/// Every power of two is divided into eight buckets, the percentiles are accurate to 12.5 percent. Durations are
+/// recorded with relaxed atomic counters, the recording threads never block each other.
+class LatencyHistogram {
+   public:
+    static constexpr std::size_t subBucketBits = 3;
+    static constexpr std::size_t subBuckets = std::size_t(1) << subBucketBits;
+    /// @brief durations up to 2^27 microseconds (134 seconds) are distinguished, longer ones share the last bucket
+    static constexpr std::size_t maxExponent = 27;
+    static constexpr std::size_t bucketCount = subBuckets + (maxExponent - subBucketBits + 1) * subBuckets;
+
+    struct Snapshot {
+        std::uint64_t count = 0;
+        std::chrono::microseconds total = std::chrono::microseconds(0);
+        std::chrono::microseconds max = std::chrono::microseconds(0);
+        std::array<std::uint64_t, bucketCount> buckets = {};
+
+        /// @brief Returns the upper bound of the bucket which contains the percentile
+        /// @param percentile between 0 and 100
+        std::chrono::microseconds percentile(double percentile) const;
+        std::chrono::microseconds mean() const;
+    };
+
+    LatencyHistogram();
+
+    void record(std::chrono::microseconds duration);
+    Snapshot snapshot() const;
+
+    static std::size_t bucketOf(std::uint64_t microseconds);
+    /// @brief first duration which is not part of the bucket anymore, the last bucket has no limit
+    static std::uint64_t bucketLimit(std::size_t bucket);
+
+   private:
+    std::atomic<std::uint64_t> m_count;
+    std::atomic<std::uint64_t> m_total;
+    std::atomic<std::uint64_t> m_max;
+    std::array<std::atomic<std::uint64_t>, bucketCount> m_buckets;
+};
+
+/// @brief Latency, error and traffic counters of the requests to one endpoint with one method
+class RequestStatistics {
+   public:
+    /// @brief lowest and highest HTTP status which is counted as an error
+    static constexpr int minErrorStatus = 400;
+    static constexpr int maxErrorStatus = 599;
+
+    struct Snapshot {
+        std::uint64_t requests = 0;
+        /// @brief requests without a response, e.g. timeouts or refused connections
+        std::uint64_t failures = 0;
+        /// @brief number of responses per HTTP error status
+        std::map<int, std::uint64_t> errorStatuses;
+        std::uint64_t bytesSent = 0;
+        std::uint64_t bytesReceived = 0;
+        LatencyHistogram::Snapshot latency;
+    };
+
+    RequestStatistics();
+
+    /// @brief Records a request with a response
+    /// @param duration time until the response was received
+    /// @param status HTTP status of the response
+    /// @param bytesSent size of the request content
+    /// @param bytesReceived size of the response content as transferred
+    void record(std::chrono::microseconds duration, int status, std::size_t bytesSent, std::size_t bytesReceived);
+    /// @brief Records a request which did not receive a response
+    void recordFailure(std::chrono::microseconds duration, std::size_t bytesSent);
+    Snapshot snapshot() const;
+
+   private:
+    LatencyHistogram m_latency;
+    std::atomic<std::uint64_t> m_failures;
+    std::atomic<std::uint64_t> m_bytesSent;
+    std::atomic<std::uint64_t> m_bytesReceived;
+    std::array<std::atomic<std::uint64_t>, maxErrorStatus - minErrorStatus + 1> m_errorStatuses;
+};
+}  // namespace vacdm::com
@@ -1,84 +1,133 @@
 #include "Server.h"
 
+#include <algorithm>
 #include <numeric>
-
+#include <optional>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "MessageWriter.h"
+#include "PilotDecoder.h"
 #include "Version.h"
+#include "utils/Compression.h"
 #include "utils/Date.h"
 
 using namespace vacdm;
 using namespace vacdm::com;
 using namespace vacdm::logging;
 
+namespace {
+/// @brief writer of the messages of the calling thread, the buffer is reused for all messages
+MessageWriter& messageWriter() {
+    thread_local MessageWriter writer;
+    return writer;
+}
+
+/// @brief returns the callsign of a message or a bulk response item, nullopt if it has none or it is no string
+std::optional<std::string> callsignOf(const nlohmann::json& message) {
+    if (false == message.is_object()) return std::nullopt;
+
+    const auto callsign = message.find("callsign");
+    if (message.end() == callsign || false == callsign->is_string()) return std::nullopt;
+    return callsign->get<std::string>();
+}
+}  // namespace
+
 Server::Server(logging::Logger* vacdmLogger)
     : m_authToken(),
-      m_clientMutex(),
-      m_client(nullptr),
+      m_connectionPool(5, std::chrono::seconds(30)),
+      m_parallelRequests(4),
+      m_incrementalSync(false),
+      m_multiAirportCache(),
+      m_multiAirportRejected(false),
+      m_batchRequests(false),
+      m_bulkRejectedUntil(std::chrono::steady_clock::time_point()),
+      m_compressResponses(true),
+      m_compressRequests(false),
+      m_compressionThreshold(defaultCompressionThreshold),
+      m_compressionStatistics(),
+      m_circuitBreaker(circuitBreakerThreshold, circuitBreakerOpenDuration, circuitBreakerMaxOpenDuration),
+      m_requestStatistics(),
+      m_parsingStatistics(),
+      m_serverConfiguration(),
+      m_addressGeneration(0),
+      m_configRefreshRequested(false),
+      m_stop(false),
+      m_pilotEventsLock(),
+      m_pushUpdates(false),
+      m_pilotEventAirports(),
+      m_pilotEvents(vacdmLogger),
       m_apiIsChecked(false),
       m_apiIsValid(false),
+      m_addressLock(),
       m_baseUrl("https://app.vacdm.net"),
       m_clientIsMaster(false),
       m_errorCode(),
       vacdmLogger_(vacdmLogger) {
     initClient();
+    this->m_configRefresher = std::thread(&Server::runConfigRefresh, this);
 }
 
 Server::~Server() {
-    std::lock_guard guard(m_clientMutex);
-    m_client.reset();
+    {
+        std::lock_guard guard(this->m_configRefreshLock);
+        this->m_stop = true;
+    }
+    this->m_configRefreshCondition.notify_all();
+    this->m_configRefresher.join();
 }
 
 void Server::initClient() {
-    std::lock_guard guard(m_clientMutex);
-
-    // Create a new client with the current base URL
-    m_client = std::make_unique<httplib::Client>(m_baseUrl);
-
-    // Configure client settings similar to curl options
-    m_client->set_connection_timeout(2);
-    m_client->set_read_timeout(5);
-    m_client->set_write_timeout(5);
-
-    m_client->enable_server_certificate_verification(false);
-    m_client->enable_server_hostname_verification(false);
-
-    // Set default headers
-    m_client->set_default_headers({{"Accept", "application/json"}, {"Content-Type", "application/json"},
-                                        {"User-Agent", "VACDM Plugin Neo/" + std::string(PLUGIN_VERSION)}});
-
-    // Add authorization if token is available
-    if (!m_authToken.empty()) {
-        m_client->set_bearer_token_auth(m_authToken);
-    }
+    // drop all pooled connections, new connections use the current base URL
+    m_connectionPool.reset(this->baseUrl(), m_authToken);
+    m_circuitBreaker.reset();
+    m_multiAirportRejected = false;
+    m_bulkRejectedUntil = std::chrono::steady_clock::time_point();
+
+    std::lock_guard guard(m_airportCacheLock);
+    m_airportCache.clear();
+    m_multiAirportCache = MultiAirportCache();
 }
 
 void Server::changeServerAddress(const std::string& url) {
-    this->m_baseUrl = url;
-    this->m_apiIsChecked = false;
-    this->m_apiIsValid = false;
+    {
+        std::lock_guard guard(this->m_addressLock);
+        this->m_baseUrl = url;
+        this->m_errorCode.clear();
+        this->m_apiIsChecked = false;
+        this->m_apiIsValid = false;
+        // running checks and configuration requests of the previous backend are discarded
+        this->m_addressGeneration += 1;
+    }
+
+    // the configuration of the previous backend is not valid anymore
+    this->m_serverConfiguration.store(nullptr);
 
     // Re-initialize client with new URL
     initClient();
+    this->updatePilotEventSubscription();
 }
 
 bool Server::checkWebApi() {
     if (this->m_apiIsChecked == true) return this->m_apiIsValid;
 
-    std::lock_guard guard(m_clientMutex);
-    if (!m_client) {
-        this->m_apiIsValid = false;
-        return m_apiIsValid;
-    }
-
+    // taken before the connection, a connection to the previous address belongs to an outdated generation
+    const auto generation = this->m_addressGeneration.load();
     std::string url = "/api/v1/version";
 
     // Send GET request
-    auto result = m_client->Get(url);
+    auto result = this->request(*m_connectionPool.acquire(), Method::Get, url);
     if (!result || result->status != 200) {
+        const std::string reason = result ? std::to_string(result->status) : "connection error";
         if (vacdmLogger_)
-            vacdmLogger_->log(
-                Logger::LogSender::Server,
-                "Failed to connect to API: " + (result ? std::to_string(result->status) : "connection error"),
-                Logger::LogLevel::Info);
+            vacdmLogger_->log(Logger::LogSender::Server, "Failed to connect to API: " + reason,
+                              Logger::LogLevel::Info);
+
+        std::lock_guard guard(this->m_addressLock);
+        if (generation != this->m_addressGeneration) return false;
+        this->m_errorCode = "Failed to connect to the backend: " + reason;
         this->m_apiIsValid = false;
         return m_apiIsValid;
     }
@@ -87,22 +136,33 @@ bool Server::checkWebApi() {
     if (vacdmLogger_)
         vacdmLogger_->log(Logger::LogSender::Server, "Received API-version-message: " + response,
                            Logger::LogLevel::Info);
+    bool valid = false;
+    std::string errorCode;
     try {
         auto root = nlohmann::json::parse(response);
         if (PLUGIN_VERSION_MAJOR != root["major"].get<int>()) {
-            this->m_errorCode = "Backend-version is incompatible. Please update the plugin.";
-            this->m_apiIsValid = false;
+            errorCode = "Backend-version is incompatible. Please update the plugin.";
         } else {
-            this->m_apiIsValid = true;
+            valid = true;
         }
     } catch (const std::exception& e) {
         if (vacdmLogger_)
             vacdmLogger_->log(Logger::LogSender::Server, "Failed to parse response JSON: " + std::string(e.what()),
                                Logger::LogLevel::Info);
-        this->m_errorCode = "Invalid backend-version response: " + response;
-        this->m_apiIsValid = false;
+        errorCode = "Invalid backend-version response: " + response;
+    }
+
+    std::lock_guard guard(this->m_addressLock);
+    // the address changed while the version was requested, the result belongs to the previous backend
+    if (generation != this->m_addressGeneration) {
+        if (vacdmLogger_)
+            vacdmLogger_->log(Logger::LogSender::Server, "Discarded the API check of the previous address",
+                              Logger::LogLevel::Info);
+        return false;
     }
 
+    this->m_errorCode = errorCode;
+    this->m_apiIsValid = valid;
     m_apiIsChecked = true;
     return this->m_apiIsValid;
 }
@@ -110,145 +170,472 @@ bool Server::checkWebApi() {
 Server::ServerConfiguration Server::getServerConfig() {
     if (false == this->m_apiIsChecked || false == this->m_apiIsValid) return Server::ServerConfiguration();
 
-    std::lock_guard guard(m_clientMutex);
-    if (m_client) {
-        std::string url = "/api/v1/config";
-        auto result = m_client->Get(url);
+    auto cached = this->m_serverConfiguration.load();
+    if (nullptr == cached) {
+        cached = this->refreshServerConfig();
+        return nullptr != cached ? cached->config : Server::ServerConfiguration();
+    }
 
-        if (result && result->status == 200) {
-            nlohmann::json root;
+    if (std::chrono::steady_clock::now() - cached->fetchedAt > serverConfigTtl) {
+        {
+            std::lock_guard guard(this->m_configRefreshLock);
+            this->m_configRefreshRequested = true;
+        }
+        this->m_configRefreshCondition.notify_one();
+    }
 
-            if (vacdmLogger_)
-                vacdmLogger_->log(Logger::LogSender::Server, "Received configuration: " + result->body,
-                                   Logger::LogLevel::Info);
+    return cached->config;
+}
+
+std::shared_ptr<const Server::CachedServerConfiguration> Server::refreshServerConfig() {
+    const auto generation = this->m_addressGeneration.load();
+
+    const auto config = this->fetchServerConfig();
+    if (false == config.has_value()) return nullptr;
+
+    auto cached = std::make_shared<const CachedServerConfiguration>(
+        CachedServerConfiguration{*config, std::chrono::steady_clock::now()});
+    // the address changed while the configuration was requested
+    if (generation != this->m_addressGeneration) return nullptr;
+
+    this->m_serverConfiguration.store(cached);
+    return cached;
+}
+
+void Server::runConfigRefresh() {
+    std::unique_lock lock(this->m_configRefreshLock);
+
+    while (true) {
+        this->m_configRefreshCondition.wait_for(
+            lock, serverConfigTtl, [this]() { return true == this->m_stop || true == this->m_configRefreshRequested; });
+        if (true == this->m_stop) return;
+        this->m_configRefreshRequested = false;
+
+        lock.unlock();
+        if (true == this->m_apiIsChecked && true == this->m_apiIsValid) this->refreshServerConfig();
+        lock.lock();
+    }
+}
+
+std::optional<Server::ServerConfiguration> Server::fetchServerConfig() {
+    std::string url = "/api/v1/config";
+    auto result = this->request(*m_connectionPool.acquire(), Method::Get, url);
+
+    if (result && result->status == 200) {
+        nlohmann::json root;
+
+        if (vacdmLogger_)
+            vacdmLogger_->log(Logger::LogSender::Server, "Received configuration: " + result->body,
+                               Logger::LogLevel::Info);
 
-            try {
-                root = nlohmann::json::parse(result->body);
-                ServerConfiguration_t config;
-                config.name = root["serverName"].get<std::string>();
-                config.allowMasterInSweatbox = root["allowSimSession"].get<bool>();
-                config.allowMasterAsObserver = root["allowObsMaster"].get<bool>();
-                return config;
-            } catch (const std::exception& e) {
-                if (vacdmLogger_)
-                    vacdmLogger_->log(Logger::LogSender::Server,
-                                       "Failed to parse response JSON: " + std::string(e.what()),
-                                       Logger::LogLevel::Info);
+        try {
+            root = nlohmann::json::parse(result->body);
+            ServerConfiguration_t config;
+            config.name = root["serverName"].get<std::string>();
+            config.allowMasterInSweatbox = root["allowSimSession"].get<bool>();
+            config.allowMasterAsObserver = root["allowObsMaster"].get<bool>();
+            // optional list of the capabilities of newer backends
+            if (true == root.contains("features") && true == root["features"].is_array()) {
+                const auto& features = root["features"];
+                config.multiAirportPilots =
+                    features.end() != std::find(features.begin(), features.end(), "multiAirportPilots");
             }
+            return config;
+        } catch (const std::exception& e) {
+            if (vacdmLogger_)
+                vacdmLogger_->log(Logger::LogSender::Server,
+                                   "Failed to parse response JSON: " + std::string(e.what()),
+                                   Logger::LogLevel::Info);
         }
     }
 
-    return ServerConfiguration();
+    return std::nullopt;
 }
 
 void Server::retrieveSupportedAirports() {
     if (false == this->m_apiIsChecked || false == this->m_apiIsValid) { return; }
 
-    std::lock_guard guard(m_clientMutex);
-    if (m_client) {
-        std::string url = "/api/v1/airports";
-        auto result = m_client->Get(url);
-
-        if (result && result->status == 200) {
-            nlohmann::json root;
-
-            try {
-                root = nlohmann::json::parse(result->body);
-                std::list<std::string> airports;
-                for (const auto& airport : std::as_const(root)) {
-                    airports.push_back(airport["icao"].get<std::string>());
-                }
-                m_supportedAirports = airports;
-            } catch (const std::exception& e) {
-                if (vacdmLogger_)
-                    vacdmLogger_->log(Logger::LogSender::Server,
-                                       "Failed to parse response JSON: " + std::string(e.what()),
-                                       Logger::LogLevel::Info);
+    std::string url = "/api/v1/airports";
+    auto result = this->request(*m_connectionPool.acquire(), Method::Get, url);
+
+    if (result && result->status == 200) {
+        nlohmann::json root;
+
+        try {
+            root = nlohmann::json::parse(result->body);
+            std::list<std::string> airports;
+            for (const auto& airport : std::as_const(root)) {
+                airports.push_back(airport["icao"].get<std::string>());
             }
+            std::lock_guard guard(m_supportedAirportsLock);
+            m_supportedAirports = airports;
+        } catch (const std::exception& e) {
+            if (vacdmLogger_)
+                vacdmLogger_->log(Logger::LogSender::Server,
+                                   "Failed to parse response JSON: " + std::string(e.what()),
+                                   Logger::LogLevel::Info);
         }
     }
 }
 
-std::list<std::string> Server::getSupportedAirports() { return m_supportedAirports; };
+std::list<std::string> Server::getSupportedAirports() {
+    std::lock_guard guard(m_supportedAirportsLock);
+    return m_supportedAirports;
+};
 
-std::list<types::Pilot> Server::getPilots(const std::list<std::string> airports) {
-    std::lock_guard guard(m_clientMutex);
-    if (!m_client) {
-        return {};
+void Server::setIncrementalSync(bool incrementalSync) { this->m_incrementalSync = incrementalSync; }
+
+void Server::setPushUpdates(bool pushUpdates) {
+    {
+        std::lock_guard guard(this->m_pilotEventsLock);
+        this->m_pushUpdates = pushUpdates;
     }
+    this->updatePilotEventSubscription();
+}
 
-    std::list<types::Pilot> pilots;
-    std::string baseUrl = "/api/v1/pilots?adep=";
+void Server::subscribePilotEvents(const std::list<std::string>& airports) {
+    {
+        std::lock_guard guard(this->m_pilotEventsLock);
+        this->m_pilotEventAirports = airports;
+    }
+    this->updatePilotEventSubscription();
+}
+
+bool Server::pilotEventsConnected() { return this->m_pilotEvents.connected(); }
+
+std::list<types::Pilot> Server::takePilotEvents() { return this->m_pilotEvents.takePilots(); }
+
+void Server::updatePilotEventSubscription() {
+    std::lock_guard guard(this->m_pilotEventsLock);
+    this->m_pilotEvents.subscribe(this->baseUrl(), this->m_authToken,
+                                  true == this->m_pushUpdates ? this->m_pilotEventAirports : std::list<std::string>());
+}
+
+void Server::setParallelRequests(int parallelRequests) {
+    this->m_parallelRequests = std::clamp(parallelRequests, minParallelRequests, maxParallelRequests);
+    // keep one connection alive per worker and one for the outgoing messages
+    m_connectionPool.setMaxIdleConnections(static_cast<std::size_t>(this->m_parallelRequests.load()) + 1);
+}
+
+void Server::setResponseCompression(bool compressResponses) { this->m_compressResponses = compressResponses; }
+
+void Server::setRequestCompression(bool compressRequests, std::size_t threshold) {
+    this->m_compressRequests = compressRequests;
+    this->m_compressionThreshold = threshold;
+}
+
+Server::CompressionStatisticsList Server::compressionStatistics() {
+    std::lock_guard guard(m_statisticsLock);
+    return m_compressionStatistics;
+}
+
+std::string Server::endpointName(Endpoint endpoint) {
+    switch (endpoint) {
+        case Endpoint::Version:
+            return "version";
+        case Endpoint::Config:
+            return "config";
+        case Endpoint::Airports:
+            return "airports";
+        case Endpoint::Pilots:
+            return "pilots";
+        case Endpoint::Pilot:
+            return "pilot";
+        case Endpoint::Bulk:
+            return "bulk";
+        default:
+            return "unknown";
+    }
+}
+
+std::string Server::methodName(Method method) {
+    switch (method) {
+        case Method::Get:
+            return "GET";
+        case Method::Post:
+            return "POST";
+        case Method::Patch:
+            return "PATCH";
+        case Method::Delete:
+            return "DELETE";
+        default:
+            return "UNKNOWN";
+    }
+}
 
-    for (const auto& airport : airports) {
-        std::string url = baseUrl + airport;
+std::vector<Server::EndpointRequestStatistics> Server::requestStatistics() {
+    std::vector<EndpointRequestStatistics> statistics;
 
+    for (std::size_t endpoint = 0; endpoint < m_requestStatistics.size(); ++endpoint) {
+        for (std::size_t method = 0; method < m_requestStatistics[endpoint].size(); ++method) {
+            auto snapshot = m_requestStatistics[endpoint][method].snapshot();
+            if (0 == snapshot.requests) continue;
+
+            statistics.push_back({Server::methodName(static_cast<Method>(method)), static_cast<Endpoint>(endpoint),
+                                  std::move(snapshot)});
+        }
+    }
+
+    return statistics;
+}
+
+LatencyHistogram::Snapshot Server::parsingStatistics() { return m_parsingStatistics.snapshot(); }
+
+nlohmann::json Server::statisticsDump() {
+    const auto latencyDump = [](const LatencyHistogram::Snapshot& latency) {
+        return nlohmann::json{{"count", latency.count},
+                              {"meanUs", latency.mean().count()},
+                              {"p50Us", latency.percentile(50.0).count()},
+                              {"p95Us", latency.percentile(95.0).count()},
+                              {"p99Us", latency.percentile(99.0).count()},
+                              {"maxUs", latency.max.count()}};
+    };
+
+    nlohmann::json requests = nlohmann::json::array();
+    for (const auto& entry : this->requestStatistics()) {
+        nlohmann::json errors = nlohmann::json::object();
+        for (const auto& [status, count] : entry.statistics.errorStatuses) errors[std::to_string(status)] = count;
+
+        requests.push_back({{"endpoint", Server::endpointName(entry.endpoint)},
+                            {"method", entry.method},
+                            {"requests", entry.statistics.requests},
+                            {"failures", entry.statistics.failures},
+                            {"errors", errors},
+                            {"bytesSent", entry.statistics.bytesSent},
+                            {"bytesReceived", entry.statistics.bytesReceived},
+                            {"latency", latencyDump(entry.statistics.latency)}});
+    }
+
+    nlohmann::json compression = nlohmann::json::object();
+    const auto compressionStatistics = this->compressionStatistics();
+    for (std::size_t endpoint = 0; endpoint < compressionStatistics.size(); ++endpoint) {
+        const auto& statistics = compressionStatistics[endpoint];
+        if (0 == statistics.requests.messages && 0 == statistics.responses.messages) continue;
+
+        const auto compressionDump = [](const CompressionStatistics& entry) {
+            return nlohmann::json{{"messages", entry.messages},
+                                  {"uncompressedBytes", entry.uncompressedBytes},
+                                  {"compressedBytes", entry.compressedBytes},
+                                  {"processingTimeUs", entry.processingTime.count()}};
+        };
+        compression[Server::endpointName(static_cast<Endpoint>(endpoint))] = {
+            {"requests", compressionDump(statistics.requests)}, {"responses", compressionDump(statistics.responses)}};
+    }
+
+    return {{"createdAt", utils::Date::timestampToIsoString(std::chrono::system_clock::now())},
+            {"requests", requests},
+            {"parsing", latencyDump(this->parsingStatistics())},
+            {"compression", compression}};
+}
+
+Server::Endpoint Server::endpointOf(const std::string& url) {
+    if (url.starts_with("/api/v1/pilots/bulk")) return Endpoint::Bulk;
+    if (url.starts_with("/api/v1/pilots/")) return Endpoint::Pilot;
+    if (url.starts_with("/api/v1/pilots")) return Endpoint::Pilots;
+    if (url.starts_with("/api/v1/airports")) return Endpoint::Airports;
+    if (url.starts_with("/api/v1/config")) return Endpoint::Config;
+    return Endpoint::Version;
+}
+
+httplib::Result Server::request(httplib::Client& client, Method method, const std::string& url,
+                                httplib::Headers headers, const std::string& content) {
+    const auto endpoint = Server::endpointOf(url);
+
+    // cpp-httplib asks for compressed responses unless the encoding is given
+    headers.emplace("Accept-Encoding", true == this->m_compressResponses ? "gzip, deflate" : "identity");
+
+    std::string compressed;
+    const bool compress = (Method::Post == method || Method::Patch == method) &&
+                          true == this->m_compressRequests && content.size() >= this->m_compressionThreshold &&
+                          true == this->compressContent(endpoint, content, compressed);
+    if (true == compress) headers.emplace("Content-Encoding", "gzip");
+    const auto& body = true == compress ? compressed : content;
+
+    // posts create the pilot and are not repeated, patches set absolute values and can be sent again
+    const int attempts = Method::Post == method ? 1 : maxRequestAttempts;
+
+    httplib::Result result;
+    for (int attempt = 0; attempt < attempts; ++attempt) {
+        if (0 != attempt) std::this_thread::sleep_for(Server::retryDelay(attempt));
+
+        if (false == this->passCircuitBreaker(client)) return httplib::Result(nullptr, httplib::Error::Connection);
+
+        const auto start = std::chrono::steady_clock::now();
+        result = Server::send(client, method, url, headers, body);
+        const auto duration =
+            std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+
+        auto& statistics =
+            m_requestStatistics[static_cast<std::size_t>(endpoint)][static_cast<std::size_t>(method)];
+        if (result)
+            statistics.record(duration, result->status, body.size(), result->body.size());
+        else
+            statistics.recordFailure(duration, body.size());
+
+        if (false == Server::isBackendFailure(result)) {
+            m_circuitBreaker.recordSuccess();
+            break;
+        }
+
+        if (true == m_circuitBreaker.recordFailure() && vacdmLogger_)
+            vacdmLogger_->log(Logger::LogSender::Server, "Backend unreachable, pausing the requests",
+                               Logger::LogLevel::Info);
         if (vacdmLogger_)
-            vacdmLogger_->log(Logger::LogSender::Server, url, Logger::LogLevel::Info);
-
-        auto result = m_client->Get(url);
-        if (result && result->status == 200) {
-            nlohmann::json root;
-
-            try {
-                root = nlohmann::json::parse(result->body);
-
-                for (const auto& pilot : std::as_const(root)) {
-                    pilots.push_back(types::Pilot());
-
-                    pilots.back().callsign = pilot["callsign"].get<std::string>();
-                    pilots.back().lastUpdate = utils::Date::isoStringToTimestamp(pilot["updatedAt"].get<std::string>());
-                    pilots.back().inactive = pilot["inactive"].get<bool>();
-
-                    // position data
-                    pilots.back().latitude = pilot["position"]["lat"].get<double>();
-                    pilots.back().longitude = pilot["position"]["lon"].get<double>();
-                    pilots.back().taxizoneIsTaxiout = pilot["vacdm"]["taxizoneIsTaxiout"].get<bool>();
-
-                    // flightplan & clearance data
-                    pilots.back().origin = pilot["flightplan"]["departure"].get<std::string>();
-                    pilots.back().destination = pilot["flightplan"]["arrival"].get<std::string>();
-                    pilots.back().runway = pilot["clearance"]["dep_rwy"].get<std::string>();
-                    pilots.back().sid = pilot["clearance"]["sid"].get<std::string>();
-
-                    // ACDM procedure data
-                    pilots.back().eobt = utils::Date::isoStringToTimestamp(pilot["vacdm"]["eobt"].get<std::string>());
-                    pilots.back().tobt = utils::Date::isoStringToTimestamp(pilot["vacdm"]["tobt"].get<std::string>());
-                    pilots.back().tobt_state = pilot["vacdm"]["tobt_state"].get<std::string>();
-                    pilots.back().ctot = utils::Date::isoStringToTimestamp(pilot["vacdm"]["ctot"].get<std::string>());
-                    pilots.back().ttot = utils::Date::isoStringToTimestamp(pilot["vacdm"]["ttot"].get<std::string>());
-                    pilots.back().tsat = utils::Date::isoStringToTimestamp(pilot["vacdm"]["tsat"].get<std::string>());
-                    pilots.back().exot =
-                        std::chrono::system_clock::time_point(std::chrono::minutes(pilot["vacdm"]["exot"].get<long int>()));
-                    pilots.back().asat = utils::Date::isoStringToTimestamp(pilot["vacdm"]["asat"].get<std::string>());
-                    pilots.back().aobt = utils::Date::isoStringToTimestamp(pilot["vacdm"]["aobt"].get<std::string>());
-                    pilots.back().atot = utils::Date::isoStringToTimestamp(pilot["vacdm"]["atot"].get<std::string>());
-                    pilots.back().asrt = utils::Date::isoStringToTimestamp(pilot["vacdm"]["asrt"].get<std::string>());
-                    pilots.back().aort = utils::Date::isoStringToTimestamp(pilot["vacdm"]["aort"].get<std::string>());
-
-                    // ECFMP measures
-                    nlohmann::json measuresArray = pilot["measures"];
-                    std::vector<types::EcfmpMeasure> parsedMeasures;
-                    for (const auto& measureObject : std::as_const(measuresArray)) {
-                        vacdm::types::EcfmpMeasure measure;
-
-                        measure.ident = measureObject["ident"].get<std::string>();
-                        measure.value = measureObject["value"].get<int>();
-
-                        parsedMeasures.push_back(measure);
-                    }
-                    pilots.back().measures = parsedMeasures;
-
-                    // event booking data
-                    pilots.back().hasBooking = pilot["hasBooking"].get<bool>();
-                }
-            } catch (const std::exception& e) {
-                if (vacdmLogger_)
-                    vacdmLogger_->log(Logger::LogSender::Server, "Failed to parse response JSON: " + std::string(e.what()),
-                                    Logger::LogLevel::Info);
+            vacdmLogger_->log(Logger::LogSender::Server,
+                               "Request " + url + " failed (attempt " + std::to_string(attempt + 1) + " of " +
+                                   std::to_string(attempts) + "): " +
+                                   (result ? std::to_string(result->status) : httplib::to_string(result.error())),
+                               Logger::LogLevel::Debug);
+    }
+
+    if (result && false == this->decompressResponse(endpoint, *result))
+        return httplib::Result(nullptr, httplib::Error::Compression);
+    return result;
+}
+
+httplib::Result Server::send(httplib::Client& client, Method method, const std::string& url,
+                             const httplib::Headers& headers, const std::string& content) {
+    switch (method) {
+        case Method::Post:
+            return client.Post(url, headers, content, "application/json");
+        case Method::Patch:
+            return client.Patch(url, headers, content, "application/json");
+        case Method::Delete:
+            return client.Delete(url, headers);
+        default:
+            return client.Get(url, headers);
+    }
+}
+
+bool Server::passCircuitBreaker(httplib::Client& client) {
+    switch (m_circuitBreaker.acquire()) {
+        case CircuitBreaker::Decision::Send:
+            return true;
+        case CircuitBreaker::Decision::Probe: {
+            // check with the lightweight version endpoint if the backend is back before the request is sent
+            const auto probe = client.Get("/api/v1/version");
+            if (true == Server::isBackendFailure(probe)) {
+                m_circuitBreaker.recordFailure();
+                return false;
             }
+
+            m_circuitBreaker.recordSuccess();
+            if (vacdmLogger_)
+                vacdmLogger_->log(Logger::LogSender::Server, "Backend reachable again, resuming the requests",
+                                   Logger::LogLevel::Info);
+            return true;
         }
+        default:
+            return false;
     }
+}
+
+bool Server::isBackendFailure(const httplib::Result& result) {
+    return !result || 429 == result->status || 500 <= result->status;
+}
+
+std::chrono::milliseconds Server::retryDelay(int attempt) {
+    thread_local std::mt19937 generator(std::random_device{}());
+
+    // exponential backoff with full jitter, spreads the retries of concurrent requests
+    const auto maxDelay = std::min(retryBaseDelay * (1 << (attempt - 1)), retryMaxDelay);
+    std::uniform_int_distribution<std::chrono::milliseconds::rep> distribution(0, maxDelay.count());
+    return std::chrono::milliseconds(distribution(generator));
+}
+
+bool Server::compressContent(Endpoint endpoint, const std::string& content, std::string& compressed) {
+    const auto start = std::chrono::steady_clock::now();
+    if (false == utils::Compression::gzip(content, compressed)) return false;
+    const auto duration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+
+    std::lock_guard guard(m_statisticsLock);
+    auto& statistics = m_compressionStatistics[static_cast<std::size_t>(endpoint)].requests;
+    statistics.messages += 1;
+    statistics.uncompressedBytes += content.size();
+    statistics.compressedBytes += compressed.size();
+    statistics.processingTime += duration;
+
+    return true;
+}
+
+bool Server::decompressResponse(Endpoint endpoint, httplib::Response& response) {
+    const auto encoding = response.get_header_value("Content-Encoding");
+    if ("gzip" != encoding && "deflate" != encoding) return true;
+
+    const auto start = std::chrono::steady_clock::now();
+    std::string content;
+    if (false == utils::Compression::inflate(response.body, content)) {
+        if (vacdmLogger_)
+            vacdmLogger_->log(Logger::LogSender::Server,
+                               "Failed to decompress " + encoding + " response of " + Server::endpointName(endpoint),
+                               Logger::LogLevel::Info);
+        return false;
+    }
+    const auto duration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+
+    {
+        std::lock_guard guard(m_statisticsLock);
+        auto& statistics = m_compressionStatistics[static_cast<std::size_t>(endpoint)].responses;
+        statistics.messages += 1;
+        statistics.uncompressedBytes += content.size();
+        statistics.compressedBytes += response.body.size();
+        statistics.processingTime += duration;
+    }
+
+    if (vacdmLogger_)
+        vacdmLogger_->log(Logger::LogSender::Server,
+                           "Decompressed response of " + Server::endpointName(endpoint) + ": " +
+                               std::to_string(response.body.size()) + " -> " + std::to_string(content.size()) +
+                               " bytes in " + std::to_string(duration.count()) + "us",
+                           Logger::LogLevel::Debug);
+
+    response.body = std::move(content);
+    response.headers.erase("Content-Encoding");
+    return true;
+}
+
+std::list<types::Pilot> Server::getPilots(const std::list<std::string> airports) {
+    // forget the responses of airports which are not active anymore
+    {
+        std::lock_guard guard(m_airportCacheLock);
+        std::erase_if(m_airportCache, [&airports](const auto& entry) {
+            return std::find(airports.begin(), airports.end(), entry.first) == airports.end();
+        });
+    }
+
+    const std::vector<std::string> airportList(airports.begin(), airports.end());
+    std::vector<std::list<types::Pilot>> airportPilots(airportList.size());
+
+    // request all airports at once if the backend supports it, fall back to one request per airport otherwise
+    std::optional<std::vector<std::list<types::Pilot>>> multiAirportPilots;
+    if (1 < airportList.size() && true == this->multiAirportRequestsSupported())
+        multiAirportPilots = this->fetchMultiAirportPilots(*m_connectionPool.acquire(), airportList);
+
+    if (multiAirportPilots) {
+        airportPilots = std::move(*multiAirportPilots);
+    } else {
+        std::atomic<std::size_t> nextAirport = 0;
+
+        // every worker checks out its own connection and picks the next pending airport until all airports are
+        // handled
+        const auto worker = [&]() {
+            auto client = m_connectionPool.acquire();
+
+            for (std::size_t idx = nextAirport++; idx < airportList.size(); idx = nextAirport++)
+                airportPilots[idx] = this->fetchPilots(*client, airportList[idx]);
+        };
+
+        const std::size_t workerCount =
+            std::min(airportList.size(), static_cast<std::size_t>(this->m_parallelRequests.load()));
+
+        std::vector<std::thread> workers;
+        for (std::size_t i = 1; i < workerCount; ++i) workers.emplace_back(worker);
+        if (workerCount != 0) worker();
+        for (auto& thread : workers) thread.join();
+    }
+
+    std::list<types::Pilot> pilots;
+    for (auto& entry : airportPilots) pilots.splice(pilots.end(), entry);
 
     if (vacdmLogger_)
         vacdmLogger_->log(Logger::LogSender::Server, "Pilots size: " + std::to_string(pilots.size()),
@@ -256,92 +643,499 @@ std::list<types::Pilot> Server::getPilots(const std::list<std::string> airports)
     return pilots;
 }
 
-void Server::sendPostMessage(const std::string& endpointUrl, const nlohmann::json& root) {
-    if (this->m_apiIsChecked == false || this->m_apiIsValid == false || this->m_clientIsMaster == false) return;
-
-    const auto message = root.dump();
+std::list<types::Pilot> Server::fetchPilots(httplib::Client& client, const std::string& airport) {
+    httplib::Headers headers;
+    std::optional<std::chrono::system_clock::time_point> since;
+    {
+        std::lock_guard guard(m_airportCacheLock);
+        const auto cache = m_airportCache.find(airport);
+        if (m_airportCache.end() != cache) {
+            // request only the changes since the last update, a full request is needed from time to time to get
+            // the removed pilots
+            if (true == this->m_incrementalSync &&
+                std::chrono::steady_clock::now() - cache->second.lastFullSync < fullSyncInterval) {
+                since = cache->second.lastUpdate;
+            }
 
-    if (root.contains("callsign")) {
-        if (vacdmLogger_)
-            vacdmLogger_->log(Logger::LogSender::Server,
-                               "Posting " + root["callsign"].get<std::string>() + " with message: " + message,
-                               Logger::LogLevel::Debug);
+            if (false == cache->second.etag.empty()) headers.emplace("If-None-Match", cache->second.etag);
+            if (false == cache->second.lastModified.empty())
+                headers.emplace("If-Modified-Since", cache->second.lastModified);
+        }
     }
 
-    std::lock_guard guard(m_clientMutex);
-    if (m_client) {
-        auto result = m_client->Post(endpointUrl, message, "application/json");
+    if (since) return this->fetchPilotChanges(client, airport, *since);
+
+    std::string url = "/api/v1/pilots?adep=" + airport;
 
-        if (result && root.contains("callsign")) {
+    if (vacdmLogger_)
+        vacdmLogger_->log(Logger::LogSender::Server, url, Logger::LogLevel::Info);
+
+    auto result = this->request(client, Method::Get, url, headers);
+    if (!result) return {};
+
+    if (result->status == 304) {
+        std::lock_guard guard(m_airportCacheLock);
+        const auto cache = m_airportCache.find(airport);
+        if (m_airportCache.end() != cache) {
             if (vacdmLogger_)
-                vacdmLogger_->log(Logger::LogSender::Server,
-                                   "Posted " + root["callsign"].get<std::string>() + " response: " + result->body,
+                vacdmLogger_->log(Logger::LogSender::Server, "Pilots of " + airport + " not modified",
                                    Logger::LogLevel::Debug);
+            cache->second.lastFullSync = std::chrono::steady_clock::now();
+            return cache->second.pilots;
+        }
+        return {};
+    }
+    if (result->status != 200) return {};
+
+    const auto etag = result->get_header_value("ETag");
+    const auto lastModified = result->get_header_value("Last-Modified");
+
+    // the backend does not support conditional requests, skip the parsing if the content did not change
+    {
+        std::lock_guard guard(m_airportCacheLock);
+        auto cache = m_airportCache.find(airport);
+        if (m_airportCache.end() != cache && cache->second.body == result->body) {
+            cache->second.etag = etag;
+            cache->second.lastModified = lastModified;
+            cache->second.lastFullSync = std::chrono::steady_clock::now();
+            return cache->second.pilots;
         }
     }
+
+    auto pilots = this->parsePilots(result->body);
+
+    auto lastUpdate = types::defaultTime;
+    for (const auto& pilot : std::as_const(pilots)) lastUpdate = std::max(lastUpdate, pilot.lastUpdate.timePoint());
+
+    std::lock_guard guard(m_airportCacheLock);
+    m_airportCache[airport] = {etag,     lastModified, std::move(result->body), pilots, lastUpdate,
+                               std::chrono::steady_clock::now()};
+
+    return pilots;
 }
 
-void Server::sendPatchMessage(const std::string& endpointUrl, const nlohmann::json& root) {
-    if (this->m_apiIsChecked == false || this->m_apiIsValid == false || this->m_clientIsMaster == false) return;
+std::list<types::Pilot> Server::fetchPilotChanges(httplib::Client& client, const std::string& airport,
+                                                  const std::chrono::system_clock::time_point& since) {
+    std::string url = "/api/v1/pilots?adep=" + airport + "&since=" + utils::Date::timestampToIsoString(since);
+
+    if (vacdmLogger_)
+        vacdmLogger_->log(Logger::LogSender::Server, url, Logger::LogLevel::Info);
+
+    auto result = this->request(client, Method::Get, url);
+    if (!result || result->status != 200) return {};
+
+    const auto changes = this->parsePilots(result->body);
+
+    if (vacdmLogger_)
+        vacdmLogger_->log(Logger::LogSender::Server,
+                           "Received " + std::to_string(changes.size()) + " changed pilots of " + airport,
+                           Logger::LogLevel::Debug);
+
+    return this->mergePilotChanges(airport, changes);
+}
+
+std::list<types::Pilot> Server::mergePilotChanges(const std::string& airport,
+                                                  const std::list<types::Pilot>& changes) {
+    std::lock_guard guard(m_airportCacheLock);
+    auto cache = m_airportCache.find(airport);
+    if (m_airportCache.end() == cache) return {};
+
+    // replace the changed pilots in the cached list, add the new ones
+    auto& pilots = cache->second.pilots;
+    for (const auto& change : changes) {
+        cache->second.lastUpdate = std::max(cache->second.lastUpdate, change.lastUpdate.timePoint());
+
+        auto pilot = std::find_if(pilots.begin(), pilots.end(),
+                                  [&change](const types::Pilot& entry) { return entry.callsign == change.callsign; });
+        if (pilots.end() != pilot)
+            *pilot = change;
+        else
+            pilots.push_back(change);
+    }
+
+    return pilots;
+}
+
+bool Server::multiAirportRequestsSupported() {
+    if (true == this->m_multiAirportRejected) return false;
+
+    const auto cached = this->m_serverConfiguration.load();
+    return nullptr != cached && true == cached->config.multiAirportPilots;
+}
+
+std::optional<std::vector<std::list<types::Pilot>>> Server::fetchMultiAirportPilots(
+    httplib::Client& client, const std::vector<std::string>& airports) {
+    const auto airportsParameter = std::accumulate(
+        std::next(airports.begin()), airports.end(), airports.front(),
+        [](const std::string& acc, const std::string& airport) { return acc + "," + airport; });
+
+    httplib::Headers headers;
+    std::optional<std::chrono::system_clock::time_point> since;
+    {
+        std::lock_guard guard(m_airportCacheLock);
+
+        // the changes are only requested if every airport is known and none of them needs a full request
+        bool incremental = this->m_incrementalSync;
+        for (const auto& airport : airports) {
+            const auto cache = m_airportCache.find(airport);
+            if (m_airportCache.end() == cache ||
+                std::chrono::steady_clock::now() - cache->second.lastFullSync >= fullSyncInterval) {
+                incremental = false;
+                break;
+            }
+            since = since ? std::min(*since, cache->second.lastUpdate) : cache->second.lastUpdate;
+        }
+        if (false == incremental) since.reset();
+
+        if (false == since.has_value() && m_multiAirportCache.airports == airportsParameter) {
+            if (false == m_multiAirportCache.etag.empty()) headers.emplace("If-None-Match", m_multiAirportCache.etag);
+            if (false == m_multiAirportCache.lastModified.empty())
+                headers.emplace("If-Modified-Since", m_multiAirportCache.lastModified);
+        }
+    }
+
+    std::string url = "/api/v1/pilots?adep=" + airportsParameter;
+    if (since) url += "&since=" + utils::Date::timestampToIsoString(*since);
+
+    if (vacdmLogger_)
+        vacdmLogger_->log(Logger::LogSender::Server, url, Logger::LogLevel::Info);
+
+    auto result = this->request(client, Method::Get, url, headers);
+    std::vector<std::list<types::Pilot>> airportPilots(airports.size());
+    if (!result) return airportPilots;
+
+    // the backend does not understand the airport list, use one request per airport from now on
+    if (400 == result->status || 404 == result->status || 422 == result->status || 501 == result->status) {
+        this->m_multiAirportRejected = true;
+        if (vacdmLogger_)
+            vacdmLogger_->log(Logger::LogSender::Server,
+                               "Multi-airport request rejected (" + std::to_string(result->status) +
+                                   "), requesting the airports separately",
+                               Logger::LogLevel::Info);
+        return std::nullopt;
+    }
+
+    if (since) {
+        if (200 != result->status) return airportPilots;
+
+        auto changes = Server::splitByAirport(this->parsePilots(result->body), airports);
+        for (std::size_t i = 0; i < airports.size(); ++i)
+            airportPilots[i] = this->mergePilotChanges(airports[i], changes[i]);
+        return airportPilots;
+    }
+
+    if (304 != result->status && 200 != result->status) return airportPilots;
+
+    const auto etag = result->get_header_value("ETag");
+    const auto lastModified = result->get_header_value("Last-Modified");
+
+    std::lock_guard guard(m_airportCacheLock);
 
-    const auto message = root.dump();
+    // nothing changed, the cached pilots of the airports are still valid
+    if (304 == result->status ||
+        (m_multiAirportCache.airports == airportsParameter && m_multiAirportCache.body == result->body)) {
+        for (std::size_t i = 0; i < airports.size(); ++i) {
+            auto cache = m_airportCache.find(airports[i]);
+            if (m_airportCache.end() == cache) continue;
+
+            cache->second.lastFullSync = std::chrono::steady_clock::now();
+            airportPilots[i] = cache->second.pilots;
+        }
+
+        if (200 == result->status) {
+            m_multiAirportCache.etag = etag;
+            m_multiAirportCache.lastModified = lastModified;
+        }
+        return airportPilots;
+    }
+
+    airportPilots = Server::splitByAirport(this->parsePilots(result->body), airports);
+    for (std::size_t i = 0; i < airports.size(); ++i) {
+        auto lastUpdate = types::defaultTime;
+        for (const auto& pilot : airportPilots[i]) lastUpdate = std::max(lastUpdate, pilot.lastUpdate.timePoint());
+
+        // the conditional request information belongs to the multi-airport request
+        m_airportCache[airports[i]] = {"", "", "", airportPilots[i], lastUpdate, std::chrono::steady_clock::now()};
 
-    if (root.contains("callsign")) {
         if (vacdmLogger_)
             vacdmLogger_->log(Logger::LogSender::Server,
-                               "Patching " + root["callsign"].get<std::string>() + " with message: " + message,
+                               "Pilots of " + airports[i] + ": " + std::to_string(airportPilots[i].size()),
                                Logger::LogLevel::Debug);
     }
+    m_multiAirportCache = {airportsParameter, etag, lastModified, std::move(result->body)};
 
-    std::lock_guard guard(m_clientMutex);
-    if (m_client) {
-        auto result = m_client->Patch(endpointUrl, message, "application/json");
+    return airportPilots;
+}
 
-        if (result && root.contains("callsign")) {
-            if (vacdmLogger_)
-                vacdmLogger_->log(Logger::LogSender::Server,
-                                   "Patched " + root["callsign"].get<std::string>() + " response: " + result->body,
-                                   Logger::LogLevel::Debug);
+std::vector<std::list<types::Pilot>> Server::splitByAirport(std::list<types::Pilot> pilots,
+                                                            const std::vector<std::string>& airports) {
+    std::vector<std::list<types::Pilot>> airportPilots(airports.size());
+
+    while (false == pilots.empty()) {
+        const auto airport = std::find(airports.begin(), airports.end(), pilots.front().origin);
+        if (airports.end() == airport) {
+            pilots.pop_front();
+            continue;
         }
+
+        auto& bucket = airportPilots[static_cast<std::size_t>(airport - airports.begin())];
+        bucket.splice(bucket.end(), pilots, pilots.begin());
     }
+
+    return airportPilots;
+}
+
+std::list<types::Pilot> Server::parsePilots(const std::string& body) {
+    PilotDecoder decoder;
+
+    const auto start = std::chrono::steady_clock::now();
+    const bool decoded = decoder.decode(body);
+    m_parsingStatistics.record(
+        std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start));
+
+    if (false == decoded && vacdmLogger_)
+        vacdmLogger_->log(Logger::LogSender::Server, "Failed to parse response JSON: " + decoder.errorMessage(),
+                          Logger::LogLevel::Info);
+    if (0 != decoder.skippedPilots() && vacdmLogger_)
+        vacdmLogger_->log(Logger::LogSender::Server,
+                          "Skipped " + std::to_string(decoder.skippedPilots()) + " malformed pilots",
+                          Logger::LogLevel::Info);
+
+    return std::move(decoder.pilots());
 }
 
-void Server::sendDeleteMessage(const std::string& endpointUrl) {
+bool Server::sendPostMessage(const std::string& endpointUrl, const nlohmann::json& root) {
+    return this->sendPostContent(endpointUrl, callsignOf(root).value_or(""), root.dump());
+}
+
+bool Server::sendPostContent(const std::string& endpointUrl, const std::string& callsign, const std::string& message) {
+    if (this->m_apiIsChecked == false || this->m_apiIsValid == false || this->m_clientIsMaster == false) return false;
+
+    if (false == callsign.empty()) {
+        if (vacdmLogger_)
+            vacdmLogger_->log(Logger::LogSender::Server, "Posting " + callsign + " with message: " + message,
+                               Logger::LogLevel::Debug);
+    }
+
+    auto result = this->request(*m_connectionPool.acquire(), Method::Post, endpointUrl, {}, message);
+
+    if (result && false == callsign.empty()) {
+        if (vacdmLogger_)
+            vacdmLogger_->log(Logger::LogSender::Server, "Posted " + callsign + " response: " + result->body,
+                               Logger::LogLevel::Debug);
+    }
+
+    return false == Server::isBackendFailure(result);
+}
+
+bool Server::sendPatchMessage(const std::string& endpointUrl, const nlohmann::json& root) {
+    return this->sendPatchContent(endpointUrl, callsignOf(root).value_or(""), root.dump());
+}
+
+bool Server::sendPatchContent(const std::string& endpointUrl, const std::string& callsign,
+                              const std::string& message) {
+    if (this->m_apiIsChecked == false || this->m_apiIsValid == false || this->m_clientIsMaster == false) return false;
+
+    if (false == callsign.empty()) {
+        if (vacdmLogger_)
+            vacdmLogger_->log(Logger::LogSender::Server, "Patching " + callsign + " with message: " + message,
+                               Logger::LogLevel::Debug);
+    }
+
+    auto result = this->request(*m_connectionPool.acquire(), Method::Patch, endpointUrl, {}, message);
+
+    if (result && false == callsign.empty()) {
+        if (vacdmLogger_)
+            vacdmLogger_->log(Logger::LogSender::Server, "Patched " + callsign + " response: " + result->body,
+                               Logger::LogLevel::Debug);
+    }
+
+    return false == Server::isBackendFailure(result);
+}
+
+bool Server::sendDeleteMessage(const std::string& endpointUrl) {
     if (this->m_apiIsChecked == false || this->m_apiIsValid == false || this->m_clientIsMaster == false) {
-        return;
+        return false;
     }
-    std::lock_guard guard(m_clientMutex);
-    if (m_client) {
-        m_client->Delete(endpointUrl);
+    const auto result = this->request(*m_connectionPool.acquire(), Method::Delete, endpointUrl);
+    return false == Server::isBackendFailure(result);
+}
+
+bool Server::postPilot(types::Pilot pilot) {
+    return this->sendPostContent("/api/v1/pilots", pilot.callsign.str(), messageWriter().pilotCreation(pilot));
+}
+
+void Server::setBatchRequests(bool batchRequests) { this->m_batchRequests = batchRequests; }
+
+bool Server::batchRequests() {
+    return true == this->m_batchRequests && std::chrono::steady_clock::now() >= this->m_bulkRejectedUntil.load();
+}
+
+std::vector<bool> Server::postPilots(const std::vector<types::Pilot>& pilots) {
+    std::vector<OutboundMessage> messages;
+    messages.reserve(pilots.size());
+    for (const auto& pilot : pilots) messages.push_back({pilot.callsign.str(), messageWriter().pilotCreation(pilot)});
+
+    return this->sendBulkMessages(Method::Post, messages);
+}
+
+std::vector<bool> Server::patchPilots(const std::vector<nlohmann::json>& messages) {
+    std::vector<OutboundMessage> contents;
+    std::vector<std::size_t> indexes;
+    contents.reserve(messages.size());
+    indexes.reserve(messages.size());
+    for (std::size_t i = 0; i < messages.size(); ++i) {
+        auto callsign = callsignOf(messages[i]);
+        // a message without callsign has no endpoint, it is not delivered
+        if (!callsign) {
+            if (vacdmLogger_)
+                vacdmLogger_->log(Logger::LogSender::Server, "Dropped patch without callsign: " + messages[i].dump(),
+                                   Logger::LogLevel::Warning);
+            continue;
+        }
+
+        contents.push_back({std::move(*callsign), messages[i].dump()});
+        indexes.push_back(i);
     }
+
+    const auto results = this->sendBulkMessages(Method::Patch, contents);
+    std::vector<bool> sent(messages.size(), false);
+    for (std::size_t i = 0; i < indexes.size(); ++i) sent[indexes[i]] = results[i];
+    return sent;
 }
 
-void Server::postPilot(types::Pilot pilot) {
-    nlohmann::json root;
+std::vector<bool> Server::sendBulkMessages(Method method, const std::vector<OutboundMessage>& messages) {
+    std::vector<bool> sent(messages.size(), false);
+    if (this->m_apiIsChecked == false || this->m_apiIsValid == false || this->m_clientIsMaster == false) return sent;
+
+    const auto sendSeparately = [this, method, &messages, &sent](std::size_t first, std::size_t end) {
+        for (std::size_t i = first; i < end; ++i) {
+            const auto& message = messages[i];
+            sent[i] = Method::Post == method
+                          ? this->sendPostContent("/api/v1/pilots", message.callsign, message.content)
+                          : this->sendPatchContent("/api/v1/pilots/" + message.callsign, message.callsign,
+                                                   message.content);
+        }
+    };
 
-    root["callsign"] = pilot.callsign;
-    root["inactive"] = false;
+    // a single message does not profit from the bulk request
+    if (false == this->batchRequests() || 1 >= messages.size()) {
+        sendSeparately(0, messages.size());
+        return sent;
+    }
 
-    root["position"] = nlohmann::json();
-    root["position"]["lat"] = pilot.latitude;
-    root["position"]["lon"] = pilot.longitude;
+    auto client = m_connectionPool.acquire();
+    std::size_t first = 0;
+    while (first < messages.size()) {
+        // fill the batch until one of the limits is reached, a batch contains at least one message
+        std::vector<const OutboundMessage*> batch;
+        std::size_t batchBytes = 0;
+        std::size_t next = first;
+        for (; next < messages.size() && batch.size() < maxBulkItems; ++next) {
+            const auto size = messages[next].content.size() + 1;
+            if (false == batch.empty() && batchBytes + size > maxBulkBytes) break;
+
+            batch.push_back(&messages[next]);
+            batchBytes += size;
+        }
 
-    root["flightplan"] = nlohmann::json();
-    root["flightplan"]["departure"] = pilot.origin;
-    root["flightplan"]["arrival"] = pilot.destination;
+        const auto results = this->sendBulkRequest(*client, method, batch);
+        if (results) {
+            std::copy(results->begin(), results->end(), sent.begin() + static_cast<std::ptrdiff_t>(first));
+        } else {
+            // without the bulk endpoint all remaining messages are sent separately, a refused batch only its own
+            const bool bulkUnsupported = false == this->batchRequests();
+            sendSeparately(first, true == bulkUnsupported ? messages.size() : next);
+            if (true == bulkUnsupported) return sent;
+        }
+        first = next;
+    }
 
-    root["vacdm"] = nlohmann::json();
-    root["vacdm"]["eobt"] = utils::Date::timestampToIsoString(pilot.eobt);
-    root["vacdm"]["tobt"] = utils::Date::timestampToIsoString(pilot.tobt);
+    return sent;
+}
+
+std::optional<std::vector<bool>> Server::sendBulkRequest(httplib::Client& client, Method method,
+                                                         const std::vector<const OutboundMessage*>& batch) {
+    // the messages are serialised already, the array is the same as the dump of a JSON array of the messages
+    std::string content = "[";
+    for (const auto* message : batch) {
+        if (1 != content.size()) content.push_back(',');
+        content.append(message->content);
+    }
+    content.push_back(']');
+
+    if (vacdmLogger_)
+        vacdmLogger_->log(Logger::LogSender::Server,
+                           "Sending " + std::to_string(batch.size()) + " messages with " + Server::methodName(method) +
+                               " /api/v1/pilots/bulk",
+                           Logger::LogLevel::Debug);
+
+    const auto result = this->request(client, method, "/api/v1/pilots/bulk", {}, content);
+    std::vector<bool> sent(batch.size(), false);
+    if (true == Server::isBackendFailure(result)) return sent;
+
+    // the backend does not know the bulk endpoint, send the messages separately for a while
+    if (404 == result->status || 405 == result->status || 501 == result->status) {
+        this->m_bulkRejectedUntil = std::chrono::steady_clock::now() + bulkRetryCooldown;
+        if (vacdmLogger_)
+            vacdmLogger_->log(Logger::LogSender::Server,
+                               "Bulk request not supported (" + std::to_string(result->status) +
+                                   "), sending the messages separately",
+                               Logger::LogLevel::Info);
+        return std::nullopt;
+    }
+
+    // the backend refused this batch, every message of it gets its own answer
+    if (200 > result->status || 300 <= result->status) {
+        if (vacdmLogger_)
+            vacdmLogger_->log(Logger::LogSender::Server,
+                               "Bulk request rejected (" + std::to_string(result->status) +
+                                   "), sending the messages of the batch separately",
+                               Logger::LogLevel::Info);
+        return std::nullopt;
+    }
+
+    // the backend answers with the status of every message, identified by the callsign
+    try {
+        const auto response = nlohmann::json::parse(result->body);
+        if (false == response.is_array()) throw std::runtime_error("the response is no list");
+
+        // malformed items are skipped, their messages count as not delivered
+        std::map<std::string, int> statuses;
+        std::size_t malformedItems = 0;
+        for (const auto& item : response) {
+            const auto callsign = callsignOf(item);
+            const auto status = true == item.is_object() ? item.find("status") : item.end();
+            if (!callsign || item.end() == status || false == status->is_number_integer()) {
+                malformedItems += 1;
+                continue;
+            }
+            statuses[*callsign] = status->get<int>();
+        }
+        if (0 != malformedItems && vacdmLogger_)
+            vacdmLogger_->log(Logger::LogSender::Server,
+                               "Skipped " + std::to_string(malformedItems) + " malformed items of the bulk response",
+                               Logger::LogLevel::Info);
 
-    root["clearance"] = nlohmann::json();
-    root["clearance"]["dep_rwy"] = pilot.runway;
-    root["clearance"]["sid"] = pilot.sid;
+        for (std::size_t i = 0; i < batch.size(); ++i) {
+            const auto status = statuses.find(batch[i]->callsign);
+            // a message which is not part of the response is sent again, rejected messages are dropped like
+            // rejected single requests
+            sent[i] = statuses.end() != status && 429 != status->second && 500 > status->second;
+        }
+    } catch (const std::exception& e) {
+        // the backend accepted the batch, sending the messages again could create the pilots twice
+        std::fill(sent.begin(), sent.end(), true);
+        if (vacdmLogger_)
+            vacdmLogger_->log(Logger::LogSender::Server,
+                               "Failed to parse bulk response, counting the messages as sent: " + std::string(e.what()),
+                               Logger::LogLevel::Info);
+    }
 
-    this->sendPostMessage("/api/v1/pilots", root);
+    return sent;
 }
 
-void Server::updateExot(const std::string& callsign, const std::chrono::system_clock::time_point& exot) {
+nlohmann::json Server::exotUpdate(const std::string& callsign, const std::chrono::system_clock::time_point& exot) {
     nlohmann::json root;
 
     root["callsign"] = callsign;
@@ -353,16 +1147,14 @@ void Server::updateExot(const std::string& callsign, const std::chrono::system_c
     root["vacdm"]["aobt"] = utils::Date::timestampToIsoString(types::defaultTime);
     root["vacdm"]["atot"] = utils::Date::timestampToIsoString(types::defaultTime);
 
-    this->sendPatchMessage("/api/v1/pilots/" + callsign, root);
+    return root;
 }
 
-void Server::updateTobt(const types::Pilot& pilot, const std::chrono::system_clock::time_point& tobt, bool manualTobt) {
+nlohmann::json Server::tobtUpdate(const types::Pilot& pilot, const std::chrono::system_clock::time_point& tobt, bool manualTobt) {
     nlohmann::json root;
 
     bool resetTsat = (tobt == types::defaultTime && true == manualTobt) || tobt >= pilot.tsat;
     root["callsign"] = pilot.callsign;
-    root["vacdm"] = nlohmann::json();
-
     root["vacdm"] = nlohmann::json();
     root["vacdm"]["tobt"] = utils::Date::timestampToIsoString(tobt);
     if (true == resetTsat) root["vacdm"]["tsat"] = utils::Date::timestampToIsoString(types::defaultTime);
@@ -373,57 +1165,57 @@ void Server::updateTobt(const types::Pilot& pilot, const std::chrono::system_clo
     root["vacdm"]["aobt"] = utils::Date::timestampToIsoString(types::defaultTime);
     root["vacdm"]["atot"] = utils::Date::timestampToIsoString(types::defaultTime);
 
-    this->sendPatchMessage("/api/v1/pilots/" + pilot.callsign, root);
+    return root;
 }
 
-void Server::updateAsat(const std::string& callsign, const std::chrono::system_clock::time_point& asat) {
+nlohmann::json Server::asatUpdate(const std::string& callsign, const std::chrono::system_clock::time_point& asat) {
     nlohmann::json root;
 
     root["callsign"] = callsign;
     root["vacdm"] = nlohmann::json();
     root["vacdm"]["asat"] = utils::Date::timestampToIsoString(asat);
 
-    this->sendPatchMessage("/api/v1/pilots/" + callsign, root);
+    return root;
 }
 
-void Server::updateAsrt(const std::string& callsign, const std::chrono::system_clock::time_point& asrt) {
+nlohmann::json Server::asrtUpdate(const std::string& callsign, const std::chrono::system_clock::time_point& asrt) {
     nlohmann::json root;
 
     root["callsign"] = callsign;
     root["vacdm"] = nlohmann::json();
     root["vacdm"]["asrt"] = utils::Date::timestampToIsoString(asrt);
 
-    this->sendPatchMessage("/api/v1/pilots/" + callsign, root);
+    return root;
 }
 
-void Server::updateAobt(const std::string& callsign, const std::chrono::system_clock::time_point& aobt) {
+nlohmann::json Server::aobtUpdate(const std::string& callsign, const std::chrono::system_clock::time_point& aobt) {
     nlohmann::json root;
 
     root["callsign"] = callsign;
     root["vacdm"] = nlohmann::json();
     root["vacdm"]["aobt"] = utils::Date::timestampToIsoString(aobt);
 
-    this->sendPatchMessage("/api/v1/pilots/" + callsign, root);
+    return root;
 }
 
-void Server::updateAort(const std::string& callsign, const std::chrono::system_clock::time_point& aort) {
+nlohmann::json Server::aortUpdate(const std::string& callsign, const std::chrono::system_clock::time_point& aort) {
     nlohmann::json root;
 
     root["callsign"] = callsign;
     root["vacdm"] = nlohmann::json();
     root["vacdm"]["aort"] = utils::Date::timestampToIsoString(aort);
 
-    this->sendPatchMessage("/api/v1/pilots/" + callsign, root);
+    return root;
 }
 
-void Server::resetTobt(const std::string& callsign, const std::chrono::system_clock::time_point& tobt,
-                       const std::string& tobtState) {
+nlohmann::json Server::tobtReset(const std::string& callsign, const std::chrono::system_clock::time_point& tobt,
+                                 types::TobtState tobtState) {
     nlohmann::json root;
 
     root["callsign"] = callsign;
     root["vacdm"] = nlohmann::json();
     root["vacdm"]["tobt"] = utils::Date::timestampToIsoString(tobt);
-    root["vacdm"]["tobt_state"] = tobtState;
+    root["vacdm"]["tobt_state"] = std::string(types::tobtStateString(tobtState));
     root["vacdm"]["tsat"] = utils::Date::timestampToIsoString(types::defaultTime);
     root["vacdm"]["ttot"] = utils::Date::timestampToIsoString(types::defaultTime);
     root["vacdm"]["asat"] = utils::Date::timestampToIsoString(types::defaultTime);
@@ -432,13 +1224,33 @@ void Server::resetTobt(const std::string& callsign, const std::chrono::system_cl
     root["vacdm"]["atot"] = utils::Date::timestampToIsoString(types::defaultTime);
     root["vacdm"]["aort"] = utils::Date::timestampToIsoString(types::defaultTime);
 
-    sendPatchMessage("/api/v1/pilots/" + callsign, root);
+    return root;
 }
 
-void Server::deletePilot(const std::string& callsign) { this->sendDeleteMessage("/api/v1/pilots/" + callsign); }
+bool Server::patchPilot(const nlohmann::json& root) {
+    const auto callsign = callsignOf(root);
+    if (!callsign) {
+        if (vacdmLogger_)
+            vacdmLogger_->log(Logger::LogSender::Server, "Dropped patch without callsign: " + root.dump(),
+                               Logger::LogLevel::Warning);
+        return false;
+    }
+
+    return this->sendPatchMessage("/api/v1/pilots/" + *callsign, root);
+}
+
+bool Server::deletePilot(const std::string& callsign) { return this->sendDeleteMessage("/api/v1/pilots/" + callsign); }
 
 void Server::setMaster(bool master) { this->m_clientIsMaster = master; }
 
 bool Server::getMaster() { return this->m_clientIsMaster; }
 
-const std::string& Server::errorMessage() const { return this->m_errorCode; }
+std::string Server::errorMessage() const {
+    std::lock_guard guard(this->m_addressLock);
+    return this->m_errorCode;
+}
+
+std::string Server::baseUrl() const {
+    std::lock_guard guard(this->m_addressLock);
+    return this->m_baseUrl;
+}
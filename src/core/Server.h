@@ -1,60 +1,186 @@
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
 #include <list>
+#include <map>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <string>
-
-#define CPPHTTPLIB_OPENSSL_SUPPORT
-#include <httplib.h>
+#include <thread>
+#include <vector>
 
 #include <nlohmann/json.hpp>
 
+#include "CircuitBreaker.h"
+#include "ConnectionPool.h"
+#include "PilotEventStream.h"
+#include "RequestStatistics.h"
 #include "log/Logger.h"
 #include "types/Pilot.h"
+#include "utils/AtomicSharedPtr.h"
 
 namespace vacdm::com {
+
+constexpr int maxParallelRequests = 16;
+constexpr int minParallelRequests = 1;
+/// @brief interval of the full pilot requests if the incremental synchronization is active
+constexpr std::chrono::seconds fullSyncInterval = std::chrono::seconds(60);
+/// @brief minimum size of a request content in bytes which is compressed
+constexpr int defaultCompressionThreshold = 1024;
+/// @brief number of attempts of idempotent requests which fail because the backend is unreachable
+constexpr int maxRequestAttempts = 3;
+constexpr std::chrono::milliseconds retryBaseDelay = std::chrono::milliseconds(200);
+constexpr std::chrono::milliseconds retryMaxDelay = std::chrono::milliseconds(1000);
+/// @brief number of consecutive failed requests which open the circuit breaker
+constexpr std::size_t circuitBreakerThreshold = 5;
+constexpr std::chrono::milliseconds circuitBreakerOpenDuration = std::chrono::seconds(5);
+constexpr std::chrono::milliseconds circuitBreakerMaxOpenDuration = std::chrono::seconds(60);
+/// @brief age of the cached server configuration after which it is refreshed in the background
+constexpr std::chrono::minutes serverConfigTtl = std::chrono::minutes(5);
+/// @brief limits of a bulk request, larger batches are split into several requests
+constexpr std::size_t maxBulkItems = 50;
+constexpr std::size_t maxBulkBytes = 256 * 1024;
+/// @brief time after which the bulk requests are tried again once the backend did not know the bulk endpoint
+constexpr std::chrono::minutes bulkRetryCooldown = std::chrono::minutes(10);
 class Server {
    public:
     typedef struct ServerConfiguration_t {
         std::string name = "";
         bool allowMasterInSweatbox = false;
         bool allowMasterAsObserver = false;
+        /// @brief the backend returns the pilots of several airports in one request
+        bool multiAirportPilots = false;
     } ServerConfiguration;
 
+    /// @brief endpoints of the backend, the request statistics are collected per endpoint
+    enum class Endpoint : std::uint8_t { Version, Config, Airports, Pilots, Pilot, Bulk, Count };
+
+    struct CompressionStatistics {
+        std::uint64_t messages = 0;
+        std::uint64_t uncompressedBytes = 0;
+        std::uint64_t compressedBytes = 0;
+        std::chrono::microseconds processingTime = std::chrono::microseconds(0);
+    };
+
+    struct EndpointCompressionStatistics {
+        /// @brief compressed request contents
+        CompressionStatistics requests;
+        /// @brief decompressed response contents
+        CompressionStatistics responses;
+    };
+
+    typedef std::array<EndpointCompressionStatistics, static_cast<std::size_t>(Endpoint::Count)>
+        CompressionStatisticsList;
+
+    /// @brief statistics of the requests with one method to one endpoint
+    struct EndpointRequestStatistics {
+        std::string method;
+        Endpoint endpoint;
+        RequestStatistics::Snapshot statistics;
+    };
+
     Server(logging::Logger* vacdmLogger);
     ~Server();
 
     void changeServerAddress(const std::string& url);
     bool checkWebApi();
+    /// @brief Returns the cached server configuration without waiting for the backend.
+    /// An outdated configuration is refreshed in the background, the configuration is only requested directly if
+    /// none is cached yet.
     ServerConfiguration_t getServerConfig();
+    /// @brief Retrieves the pilots of all given airports, the airports are fetched and parsed concurrently
+    /// @param airports list of airport ICAO codes
+    /// @return pilots of all airports, in the order of the airports
     std::list<types::Pilot> getPilots(const std::list<std::string> airports);
-    void postPilot(types::Pilot);
-    void patchPilot(const nlohmann::json& root);
+    /// @brief Sets the number of airports which are fetched in parallel by getPilots
+    /// @param parallelRequests number of concurrent requests
+    void setParallelRequests(int parallelRequests);
+    /// @brief Activates the incremental synchronization, getPilots requests only the pilots which changed since the
+    /// last request and merges them into the previous pilots. All pilots are requested every fullSyncInterval.
+    /// @param incrementalSync true to request only the changes
+    void setIncrementalSync(bool incrementalSync);
+    /// @brief Activates the subscription to the pilot change events of the backend. The pilots still need to be polled
+    /// while the subscription is not connected.
+    /// @param pushUpdates true to subscribe to the pilot events
+    void setPushUpdates(bool pushUpdates);
+    /// @brief Subscribes to the pilot events of the airports, replaces the previous subscription
+    /// @param airports list of airport ICAO codes
+    void subscribePilotEvents(const std::list<std::string>& airports);
+    /// @brief Checks if the pilot event subscription is connected, the pilots do not need to be polled frequently
+    bool pilotEventsConnected();
+    /// @brief Returns the pilots which changed since the last call, removed pilots are returned as inactive pilots
+    std::list<types::Pilot> takePilotEvents();
+    /// @brief Advertises gzip and deflate support to the backend, compressed responses are decompressed by the plugin
+    /// @param compressResponses true to accept compressed responses
+    void setResponseCompression(bool compressResponses);
+    /// @brief Compresses the content of post and patch requests with gzip
+    /// @param compressRequests true to compress the requests
+    /// @param threshold minimum content size in bytes, smaller contents are sent uncompressed
+    void setRequestCompression(bool compressRequests, std::size_t threshold);
+    /// @brief Returns the transferred and uncompressed sizes and the time spent on the compression per endpoint
+    CompressionStatisticsList compressionStatistics();
+    static std::string endpointName(Endpoint endpoint);
+    /// @brief Returns the latencies, errors and transferred bytes of the requests per endpoint and method.
+    /// Only the endpoints which received requests are returned.
+    std::vector<EndpointRequestStatistics> requestStatistics();
+    /// @brief Returns the time spent on parsing the pilots responses
+    LatencyHistogram::Snapshot parsingStatistics();
+    /// @brief Returns the request, parsing and compression statistics in a machine-readable format
+    nlohmann::json statisticsDump();
+    /// @brief Sends the creation and update messages in bulk requests instead of one request per pilot.
+    /// The messages are sent separately if the backend rejects the bulk requests.
+    /// @param batchRequests true to send bulk requests
+    void setBatchRequests(bool batchRequests);
+    /// @brief Checks if the messages are sent in bulk requests
+    bool batchRequests();
+    /// @return true if the backend received the message
+    bool postPilot(types::Pilot);
+    /// @brief Creates the pilots with bulk requests, or with one request per pilot if bulk requests are not used
+    /// @return per pilot true if the backend received the message
+    std::vector<bool> postPilots(const std::vector<types::Pilot>& pilots);
+    /// @brief Sends the patch messages with bulk requests, or with one request per message if bulk requests are not
+    /// used
+    /// @param messages message contents, each must contain the callsign
+    /// @return per message true if the backend received the message
+    std::vector<bool> patchPilots(const std::vector<nlohmann::json>& messages);
+    /// @brief Sends a patch message to the endpoint of the pilot given by the callsign in root
+    /// @param root message content, must contain the callsign
+    /// @return true if the backend received the message
+    bool patchPilot(const nlohmann::json& root);
 
     /// @brief Sends a post message to the specififed endpoint url with the root as content
     /// @param endpointUrl endpoint url to send the request to
     /// @param root message content
-    void sendPostMessage(const std::string& endpointUrl, const nlohmann::json& root);
+    /// @return true if the backend received the message, false if it was not sent or the backend is unreachable
+    bool sendPostMessage(const std::string& endpointUrl, const nlohmann::json& root);
 
     /// @brief Sends a patch message to the specified endpoint url with the root as content
     /// @param endpointUrl endpoint url to send the request to
     /// @param root message content
-    void sendPatchMessage(const std::string& endpointUrl, const nlohmann::json& root);
-    void sendDeleteMessage(const std::string& endpointUrl);
+    /// @return true if the backend received the message, false if it was not sent or the backend is unreachable
+    bool sendPatchMessage(const std::string& endpointUrl, const nlohmann::json& root);
+    bool sendDeleteMessage(const std::string& endpointUrl);
 
-    void updateExot(const std::string& pilot, const std::chrono::system_clock::time_point& exot);
-    void updateTobt(const types::Pilot& pilot, const std::chrono::system_clock::time_point& tobt, bool manualTobt);
-    void updateAsat(const std::string& callsign, const std::chrono::system_clock::time_point& asat);
-    void updateAsrt(const std::string& callsign, const std::chrono::system_clock::time_point& asrt);
-    void updateAobt(const std::string& callsign, const std::chrono::system_clock::time_point& aobt);
-    void updateAort(const std::string& callsign, const std::chrono::system_clock::time_point& aort);
+    bool deletePilot(const std::string& callsign);
 
-    void resetTobt(const std::string& callsign, const std::chrono::system_clock::time_point& tobt,
-                   const std::string& tobtState);
-    void deletePilot(const std::string& callsign);
+    /// @brief Message builders, create the patch content of the controller actions which is sent by patchPilot.
+    /// Messages of the same pilot can be combined into one patch by merging them in the order of creation. The pilot
+    /// creations are written by the MessageWriter without building a document.
+    static nlohmann::json exotUpdate(const std::string& callsign, const std::chrono::system_clock::time_point& exot);
+    static nlohmann::json tobtUpdate(const types::Pilot& pilot, const std::chrono::system_clock::time_point& tobt,
+                                     bool manualTobt);
+    static nlohmann::json asatUpdate(const std::string& callsign, const std::chrono::system_clock::time_point& asat);
+    static nlohmann::json asrtUpdate(const std::string& callsign, const std::chrono::system_clock::time_point& asrt);
+    static nlohmann::json aobtUpdate(const std::string& callsign, const std::chrono::system_clock::time_point& aobt);
+    static nlohmann::json aortUpdate(const std::string& callsign, const std::chrono::system_clock::time_point& aort);
+    static nlohmann::json tobtReset(const std::string& callsign, const std::chrono::system_clock::time_point& tobt,
+                                    types::TobtState tobtState);
 
-    const std::string& errorMessage() const;
+    std::string errorMessage() const;
     void setMaster(bool master);
     bool getMaster();
 
@@ -62,20 +188,175 @@ class Server {
     std::list<std::string> getSupportedAirports();
 
    private:
-    // Helper method to initialize/reinitialize the HTTP client
+    /// @brief the fixture of the unit tests reaches the caches and the request helpers
+    friend class ServerTest;
+
+    /// @brief serialised content of a message and the callsign it belongs to
+    struct OutboundMessage {
+        std::string callsign;
+        std::string content;
+    };
+    /// @brief last response of an airport, used for conditional requests
+    struct AirportCache {
+        std::string etag;
+        std::string lastModified;
+        std::string body;
+        std::list<types::Pilot> pilots;
+        /// @brief latest update of the pilots, used as the start of the next incremental request
+        std::chrono::system_clock::time_point lastUpdate = types::defaultTime;
+        std::chrono::steady_clock::time_point lastFullSync;
+    };
+
+    /// @brief last response of a request for several airports, the pilots are cached per airport
+    struct MultiAirportCache {
+        /// @brief airports of the request, in the format of the adep parameter
+        std::string airports;
+        std::string etag;
+        std::string lastModified;
+        std::string body;
+    };
+
+    enum class Method { Get, Post, Patch, Delete, Count };
+
+    struct CachedServerConfiguration {
+        ServerConfiguration config;
+        std::chrono::steady_clock::time_point fetchedAt;
+    };
+
+    // Helper method to initialize/reinitialize the HTTP connections
     void initClient();
+    /// @brief Requests the server configuration and stores it in the cache
+    /// @return the new cache entry, nullptr if the request failed
+    std::shared_ptr<const CachedServerConfiguration> refreshServerConfig();
+    std::optional<ServerConfiguration> fetchServerConfig();
+    /// @brief refreshes the cached server configuration when it is requested or outdated
+    void runConfigRefresh();
+    /// @brief Sends a request to the backend, compresses the content and decompresses the response if configured.
+    /// Idempotent requests are repeated with a jittered exponential backoff if the backend is unreachable, all
+    /// requests fail immediately while the circuit breaker is open.
+    /// @param client client used to send the request
+    /// @param method HTTP method of the request
+    /// @param url endpoint url to send the request to
+    /// @param headers additional headers of the request
+    /// @param content content of post and patch requests
+    /// @return the response with the decompressed content
+    httplib::Result request(httplib::Client& client, Method method, const std::string& url,
+                            httplib::Headers headers = {}, const std::string& content = "");
+    static httplib::Result send(httplib::Client& client, Method method, const std::string& url,
+                                const httplib::Headers& headers, const std::string& content);
+    /// @brief Checks if a request can be sent, probes the backend if the circuit breaker is half-open
+    bool passCircuitBreaker(httplib::Client& client);
+    /// @brief Checks if the request failed because the backend is unreachable or overloaded
+    static bool isBackendFailure(const httplib::Result& result);
+    static std::chrono::milliseconds retryDelay(int attempt);
+    /// @brief Compresses the content of a request with gzip
+    bool compressContent(Endpoint endpoint, const std::string& content, std::string& compressed);
+    /// @brief Decompresses the content of a response if it is gzip or deflate encoded
+    /// @return false if the content is encoded but could not be decompressed
+    bool decompressResponse(Endpoint endpoint, httplib::Response& response);
+    static Endpoint endpointOf(const std::string& url);
+    static std::string methodName(Method method);
+    /// @brief Sends the serialised message with a post request, the callsign is only used for the logs
+    bool sendPostContent(const std::string& endpointUrl, const std::string& callsign, const std::string& message);
+    /// @brief Sends the serialised message with a patch request, the callsign is only used for the logs
+    bool sendPatchContent(const std::string& endpointUrl, const std::string& callsign, const std::string& message);
+    /// @brief Sends the messages in bulk requests of bounded size to /api/v1/pilots/bulk. The remaining messages are
+    /// sent separately if the backend rejects the bulk request.
+    /// @param method post to create the pilots, patch to update them
+    /// @param messages message contents, each must contain the callsign
+    /// @return per message true if the backend received the message
+    std::vector<bool> sendBulkMessages(Method method, const std::vector<OutboundMessage>& messages);
+    /// @brief Sends one bulk request and maps the per-item results of the backend to the messages
+    /// @return per message true if the backend received the message, nullopt if the backend rejected the request
+    std::optional<std::vector<bool>> sendBulkRequest(httplib::Client& client, Method method,
+                                                     const std::vector<const OutboundMessage*>& batch);
+    /// @brief subscribes to the events of the current backend, closes the subscription if it is deactivated
+    void updatePilotEventSubscription();
+    /// @brief Requests and parses the pilots of a single airport.
+    /// The request is conditional if the airport has been requested before, the cached pilots are returned if the
+    /// backend reports that nothing changed or sends the same content again.
+    /// @param client client used to send the request
+    /// @param airport ICAO code of the airport
+    std::list<types::Pilot> fetchPilots(httplib::Client& client, const std::string& airport);
+    /// @brief Requests the pilots of a single airport which changed since the given time and merges them into the
+    /// cached pilots of the airport
+    /// @param client client used to send the request
+    /// @param airport ICAO code of the airport
+    /// @param since time of the latest known update
+    /// @return the cached pilots including the changes
+    std::list<types::Pilot> fetchPilotChanges(httplib::Client& client, const std::string& airport,
+                                              const std::chrono::system_clock::time_point& since);
+    /// @brief Checks if the backend announced multi-airport requests and did not reject one
+    bool multiAirportRequestsSupported();
+    /// @brief Requests the pilots of all airports in one request and splits them by departure airport.
+    /// The pilots are cached per airport, the request is conditional and incremental like the airport requests.
+    /// @param client client used to send the request
+    /// @param airports ICAO codes of the airports
+    /// @return pilots per airport in the order of the airports, nullopt if the backend rejected the request
+    std::optional<std::vector<std::list<types::Pilot>>> fetchMultiAirportPilots(
+        httplib::Client& client, const std::vector<std::string>& airports);
+    /// @brief Replaces the changed pilots in the cached pilots of the airport and adds the new ones
+    /// @return the cached pilots including the changes, empty if the airport is not cached
+    std::list<types::Pilot> mergePilotChanges(const std::string& airport, const std::list<types::Pilot>& changes);
+    /// @brief Splits the pilots by their departure airport, pilots of other airports are dropped
+    static std::vector<std::list<types::Pilot>> splitByAirport(std::list<types::Pilot> pilots,
+                                                               const std::vector<std::string>& airports);
+    /// @brief Parses a pilots response body of the backend
+    /// @param body JSON content of the response
+    std::list<types::Pilot> parsePilots(const std::string& body);
 
     std::string m_authToken;
-    std::mutex m_clientMutex;
-    std::unique_ptr<httplib::Client> m_client;
+    ConnectionPool m_connectionPool;
+    std::atomic<int> m_parallelRequests;
+    std::atomic<bool> m_incrementalSync;
+    std::mutex m_airportCacheLock;
+    std::map<std::string, AirportCache> m_airportCache;
+    MultiAirportCache m_multiAirportCache;
+    /// @brief set if the backend rejected a multi-airport request, reset when the address changes
+    std::atomic<bool> m_multiAirportRejected;
+    std::atomic<bool> m_batchRequests;
+    /// @brief the messages are sent separately until then because the backend did not know the bulk endpoint,
+    /// reset when the address changes
+    std::atomic<std::chrono::steady_clock::time_point> m_bulkRejectedUntil;
+    std::atomic<bool> m_compressResponses;
+    std::atomic<bool> m_compressRequests;
+    std::atomic<std::size_t> m_compressionThreshold;
+    std::mutex m_statisticsLock;
+    CompressionStatisticsList m_compressionStatistics;
+    CircuitBreaker m_circuitBreaker;
+    /// @brief recorded by all request threads without locking
+    std::array<std::array<RequestStatistics, static_cast<std::size_t>(Method::Count)>,
+               static_cast<std::size_t>(Endpoint::Count)>
+        m_requestStatistics;
+    LatencyHistogram m_parsingStatistics;
+
+    /// @brief replaced as a whole by the refresh, readers keep the configuration they loaded
+    utils::AtomicSharedPtr<const CachedServerConfiguration> m_serverConfiguration;
+    /// @brief incremented when the address changes, API checks and refreshes of the previous address are discarded
+    std::atomic<std::uint64_t> m_addressGeneration;
+    std::mutex m_configRefreshLock;
+    std::condition_variable m_configRefreshCondition;
+    bool m_configRefreshRequested;
+    bool m_stop;
+    std::thread m_configRefresher;
+
+    std::mutex m_pilotEventsLock;
+    bool m_pushUpdates;
+    std::list<std::string> m_pilotEventAirports;
+    PilotEventStream m_pilotEvents;
 
-    bool m_apiIsChecked;
-    bool m_apiIsValid;
+    // the handshake runs in the background, the flags are read by the data manager
+    std::atomic<bool> m_apiIsChecked;
+    std::atomic<bool> m_apiIsValid;
+    /// @brief protects the address and the error, they are changed by the UI thread and read by the handshake
+    mutable std::mutex m_addressLock;
     std::string m_baseUrl;
-    bool m_clientIsMaster;
+    /// @brief changed by the UI thread, read by the sender of the data manager
+    std::atomic<bool> m_clientIsMaster;
     std::string m_errorCode;
-    ServerConfiguration m_serverConfiguration;
+    std::string baseUrl() const;
 
+    std::mutex m_supportedAirportsLock;
     std::list<std::string> m_supportedAirports;
 
     logging::Logger* vacdmLogger_ = nullptr;
@@ -250,14 +250,14 @@ void NeoVACDM::TagProcessing(const std::string &callsign, const std::string &act
         if (userInput && isNumber(*userInput)) {
             const auto exot = std::chrono::system_clock::time_point(std::chrono::minutes(std::atoi(userInput->c_str())));
             if (exot != pilot.exot)
-                dataManager_->handleTagFunction(DataManager::MessageType::UpdateEXOT, pilot.callsign,
+                dataManager_->handleTagFunction(DataManager::MessageType::UpdateEXOT, callsign,
                                                             exot);
         }
     }
     else if (actionId == "plugin:NeoVACDM:ACTION_TOBTNow")
     {
 
-            dataManager_->handleTagFunction(DataManager::MessageType::UpdateTOBT, pilot.callsign,
+            dataManager_->handleTagFunction(DataManager::MessageType::UpdateTOBT, callsign,
                                                       std::chrono::system_clock::now());
     }
     else if (actionId == "plugin:NeoVACDM:ACTION_TOBTManual") {
@@ -267,7 +267,7 @@ void NeoVACDM::TagProcessing(const std::string &callsign, const std::string &act
                 const auto hours = std::atoi(clock.substr(0, 2).c_str());
                 const auto minutes = std::atoi(clock.substr(2, 4).c_str());
                 if (hours >= 0 && hours < 24 && minutes >= 0 && minutes < 60)
-                    dataManager_->handleTagFunction(DataManager::MessageType::UpdateTOBT, pilot.callsign,
+                    dataManager_->handleTagFunction(DataManager::MessageType::UpdateTOBT, callsign,
                                                                 utils::Date::convertStringToTimePoint(clock));
                 else
                     DisplayMessage("Invalid time format. Expected: HHMM (24 hours)", false);
@@ -280,88 +280,88 @@ void NeoVACDM::TagProcessing(const std::string &callsign, const std::string &act
     }
     else if (actionId == "plugin:NeoVACDM:ACTION_ASATNow") {
 
-        dataManager_->handleTagFunction(DataManager::MessageType::UpdateASAT, pilot.callsign,
+        dataManager_->handleTagFunction(DataManager::MessageType::UpdateASAT, callsign,
                                                     std::chrono::system_clock::now());
         // if ASRT has not been set yet -> set ASRT
         if (pilot.asrt == types::defaultTime) {
-            dataManager_->handleTagFunction(DataManager::MessageType::UpdateASRT, pilot.callsign,
+            dataManager_->handleTagFunction(DataManager::MessageType::UpdateASRT, callsign,
                                                         std::chrono::system_clock::now());
         }
     }
     else if (actionId == "plugin:NeoVACDM:ACTION_ASATNowAndStartup") {
-        dataManager_->handleTagFunction(DataManager::MessageType::UpdateASAT, pilot.callsign,
+        dataManager_->handleTagFunction(DataManager::MessageType::UpdateASAT, callsign,
                                                     std::chrono::system_clock::now());
 
         // if ASRT has not been set yet -> set ASRT
         if (pilot.asrt == types::defaultTime) {
-            dataManager_->handleTagFunction(DataManager::MessageType::UpdateASRT, pilot.callsign,
+            dataManager_->handleTagFunction(DataManager::MessageType::UpdateASRT, callsign,
                                                         std::chrono::system_clock::now());
         }
 
-        controllerDataAPI_->setGroundStatus(pilot.callsign, ControllerData::GroundStatus::Start);
+        controllerDataAPI_->setGroundStatus(callsign, ControllerData::GroundStatus::Start);
     }
     else if (actionId == "plugin:NeoVACDM:ACTION_StartupRequest") {
-        dataManager_->handleTagFunction(DataManager::MessageType::UpdateASRT, pilot.callsign,
+        dataManager_->handleTagFunction(DataManager::MessageType::UpdateASRT, callsign,
                                                     std::chrono::system_clock::now());
         ;
     }
     else if (actionId == "plugin:NeoVACDM:ACTION_AOBTNowAndState") {
         // set AORT if AORT has not been set yet
         if (pilot.aort == types::defaultTime) {
-            dataManager_->handleTagFunction(DataManager::MessageType::UpdateAORT, pilot.callsign,
+            dataManager_->handleTagFunction(DataManager::MessageType::UpdateAORT, callsign,
                                                         std::chrono::system_clock::now());
         }
-        dataManager_->handleTagFunction(DataManager::MessageType::UpdateAOBT, pilot.callsign,
+        dataManager_->handleTagFunction(DataManager::MessageType::UpdateAOBT, callsign,
                                                     std::chrono::system_clock::now());
 
         // set status depending on if the aircraft is positioned at a taxi-out position
         if (pilot.taxizoneIsTaxiout) {
-            controllerDataAPI_->setGroundStatus(pilot.callsign, ControllerData::GroundStatus::Taxi);
+            controllerDataAPI_->setGroundStatus(callsign, ControllerData::GroundStatus::Taxi);
         } else {
-        controllerDataAPI_->setGroundStatus(pilot.callsign, ControllerData::GroundStatus::Push);
+        controllerDataAPI_->setGroundStatus(callsign, ControllerData::GroundStatus::Push);
         }
     }
     else if (actionId == "plugin:NeoVACDM:ACTION_TOBTConfirm") {
-        dataManager_->handleTagFunction(DataManager::MessageType::UpdateTOBTConfirmed, pilot.callsign,
+        dataManager_->handleTagFunction(DataManager::MessageType::UpdateTOBTConfirmed, callsign,
                                                     pilot.tobt);
     }
     else if (actionId == "plugin:NeoVACDM:ACTION_OffblockRequest") {
-        dataManager_->handleTagFunction(DataManager::MessageType::UpdateAORT, pilot.callsign,
+        dataManager_->handleTagFunction(DataManager::MessageType::UpdateAORT, callsign,
                                                     std::chrono::system_clock::now());
     }
     else if (actionId == "plugin:NeoVACDM:ACTION_ResetTOBT") {
-        dataManager_->handleTagFunction(DataManager::MessageType::ResetTOBT, pilot.callsign,
+        dataManager_->handleTagFunction(DataManager::MessageType::ResetTOBT, callsign,
                                                     types::defaultTime);
     }
     else if (actionId == "plugin:NeoVACDM:ACTION_ResetASAT") {
-            dataManager_->handleTagFunction(DataManager::MessageType::ResetASAT, pilot.callsign,
+            dataManager_->handleTagFunction(DataManager::MessageType::ResetASAT, callsign,
                                                       types::defaultTime);
-            controllerDataAPI_->setGroundStatus(pilot.callsign, ControllerData::GroundStatus::None);
+            controllerDataAPI_->setGroundStatus(callsign, ControllerData::GroundStatus::None);
     }
     else if (actionId == "plugin:NeoVACDM:ACTION_ResetASRT") {
-            dataManager_->handleTagFunction(DataManager::MessageType::ResetASRT, pilot.callsign,
+            dataManager_->handleTagFunction(DataManager::MessageType::ResetASRT, callsign,
                                                       types::defaultTime);
     }
     else if (actionId == "plugin:NeoVACDM:ACTION_ResetTOBTConfirmed") {
-            dataManager_->handleTagFunction(DataManager::MessageType::ResetTOBTConfirmed, pilot.callsign,
+            dataManager_->handleTagFunction(DataManager::MessageType::ResetTOBTConfirmed, callsign,
                                                       types::defaultTime);
     }
     else if (actionId == "plugin:NeoVACDM:ACTION_ResetAORT") {
-            dataManager_->handleTagFunction(DataManager::MessageType::ResetAORT, pilot.callsign,
+            dataManager_->handleTagFunction(DataManager::MessageType::ResetAORT, callsign,
                                                       types::defaultTime);
     }
     else if (actionId == "plugin:NeoVACDM:ACTION_ResetAOBT") {
-            dataManager_->handleTagFunction(DataManager::MessageType::ResetAOBT, pilot.callsign,
+            dataManager_->handleTagFunction(DataManager::MessageType::ResetAOBT, callsign,
                                                       types::defaultTime);
     }
     else if (actionId == "plugin:NeoVACDM:ACTION_ResetAOBTandState") {
-            dataManager_->handleTagFunction(DataManager::MessageType::ResetAOBT, pilot.callsign,
+            dataManager_->handleTagFunction(DataManager::MessageType::ResetAOBT, callsign,
                                                       types::defaultTime);
-            controllerDataAPI_->setGroundStatus(pilot.callsign, ControllerData::GroundStatus::None);
+            controllerDataAPI_->setGroundStatus(callsign, ControllerData::GroundStatus::None);
     }
     else if (actionId == "plugin:NeoVACDM:ACTION_ResetPilot") {
 
-            dataManager_->handleTagFunction(DataManager::MessageType::ResetPilot, pilot.callsign,
+            dataManager_->handleTagFunction(DataManager::MessageType::ResetPilot, callsign,
                                                       types::defaultTime);
     }
     else
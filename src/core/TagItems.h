@@ -116,13 +116,14 @@ void NeoVACDM::UpdateTagItems() {
     for (std::string callsign : callsigns) {
 
         auto pilot = dataManager_->getPilot(callsign);
+        const auto caches = dataManager_->getTagCaches(callsign);
         std::string text;
         Tag::TagContext context;
         context.callsign = callsign;
 
         text = formatTime(pilot.eobt);
         context.colour = Color::colorizeEobt(pilot);
-        if (pilot.eobtCache.text != text || pilot.eobtCache.colour != context.colour)
+        if (caches.eobtCache.text != text || caches.eobtCache.colour != context.colour)
         {
             tagInterface_->UpdateTagValue(EOBTTagID_, text, context);
             dataManager_->setPilotEobtCache(callsign, text, context.colour);
@@ -130,7 +131,7 @@ void NeoVACDM::UpdateTagItems() {
 
         text = formatTime(pilot.tobt);
         context.colour = Color::colorizeTobt(pilot);
-        if (pilot.tobtCache.text != text || pilot.tobtCache.colour != context.colour)
+        if (caches.tobtCache.text != text || caches.tobtCache.colour != context.colour)
         {
             tagInterface_->UpdateTagValue(TOBTTagID_, text, context);
             dataManager_->setPilotTobtCache(callsign, text, context.colour);
@@ -138,7 +139,7 @@ void NeoVACDM::UpdateTagItems() {
 
         text = formatTime(pilot.tsat);
         context.colour = Color::colorizeTsat(pilot);
-        if (pilot.tsatCache.text != text || pilot.tsatCache.colour != context.colour)
+        if (caches.tsatCache.text != text || caches.tsatCache.colour != context.colour)
         {
             tagInterface_->UpdateTagValue(TSATTagID_, text, context);
             dataManager_->setPilotTsatCache(callsign, text, context.colour);
@@ -146,16 +147,16 @@ void NeoVACDM::UpdateTagItems() {
 
         text = formatTime(pilot.ttot);
         context.colour = Color::colorizeTtot(pilot);
-        if (pilot.ttotCache.text != text || pilot.ttotCache.colour != context.colour)
+        if (caches.ttotCache.text != text || caches.ttotCache.colour != context.colour)
         {
             tagInterface_->UpdateTagValue(TTOTTagID_, text, context);
             dataManager_->setPilotTtotCache(callsign, text, context.colour);
         }
 
         if (pilot.exot.time_since_epoch().count() > 0) {
-            text = std::format("{:%M}", pilot.exot);
+            text = std::format("{:%M}", pilot.exot.timePoint());
             context.colour = std::nullopt;
-            if (pilot.exotCache.text != text || pilot.exotCache.colour != context.colour)
+            if (caches.exotCache.text != text || caches.exotCache.colour != context.colour)
             {
                 tagInterface_->UpdateTagValue(EXOTTagID_, text, context);
                 dataManager_->setPilotExotCache(callsign, text, context.colour);
@@ -164,7 +165,7 @@ void NeoVACDM::UpdateTagItems() {
 
         text = formatTime(pilot.asat);
         context.colour = Color::colorizeAsat(pilot);
-        if (pilot.asatCache.text != text || pilot.asatCache.colour != context.colour)
+        if (caches.asatCache.text != text || caches.asatCache.colour != context.colour)
         {
             tagInterface_->UpdateTagValue(ASATTagID_, text, context);
             dataManager_->setPilotAsatCache(callsign, text, context.colour);
@@ -172,7 +173,7 @@ void NeoVACDM::UpdateTagItems() {
 
         text = formatTime(pilot.aobt);
         context.colour = Color::colorizeAobt(pilot);
-        if (pilot.aobtCache.text != text || pilot.aobtCache.colour != context.colour)
+        if (caches.aobtCache.text != text || caches.aobtCache.colour != context.colour)
         {
             tagInterface_->UpdateTagValue(AOBTTagID_, text, context);
             dataManager_->setPilotAobtCache(callsign, text, context.colour);
@@ -180,7 +181,7 @@ void NeoVACDM::UpdateTagItems() {
 
         text = formatTime(pilot.atot);
         context.colour = Color::colorizeAtot(pilot);
-        if (pilot.atotCache.text != text || pilot.atotCache.colour != context.colour)
+        if (caches.atotCache.text != text || caches.atotCache.colour != context.colour)
         {
             tagInterface_->UpdateTagValue(ATOTTagID_, text, context);
             dataManager_->setPilotAtotCache(callsign, text, context.colour);
@@ -188,7 +189,7 @@ void NeoVACDM::UpdateTagItems() {
 
         text = formatTime(pilot.asrt);
         context.colour = Color::colorizeAsrt(pilot);
-        if (pilot.asrtCache.text != text || pilot.asrtCache.colour != context.colour)
+        if (caches.asrtCache.text != text || caches.asrtCache.colour != context.colour)
         {
             tagInterface_->UpdateTagValue(ASRTTagID_, text, context);
             dataManager_->setPilotAsrtCache(callsign, text, context.colour);
@@ -196,7 +197,7 @@ void NeoVACDM::UpdateTagItems() {
 
         text = formatTime(pilot.aort);
         context.colour = Color::colorizeAort(pilot);
-        if (pilot.aortCache.text != text || pilot.aortCache.colour != context.colour)
+        if (caches.aortCache.text != text || caches.aortCache.colour != context.colour)
         {
             tagInterface_->UpdateTagValue(AORTTagID_, text, context);
             dataManager_->setPilotAortCache(callsign, text, context.colour);
@@ -204,7 +205,7 @@ void NeoVACDM::UpdateTagItems() {
 
         text = formatTime(pilot.ctot);
         context.colour = Color::colorizeCtot(pilot);
-        if (pilot.ctotCache.text != text || pilot.ctotCache.colour != context.colour)
+        if (caches.ctotCache.text != text || caches.ctotCache.colour != context.colour)
         {
             tagInterface_->UpdateTagValue(CTOTTagID_, text, context);
             dataManager_->setPilotCtotCache(callsign, text, context.colour);
@@ -216,7 +217,7 @@ void NeoVACDM::UpdateTagItems() {
 
             text = std::format("{:02}:{:02}", measureMinutes, measureSeconds);
             context.colour = Color::colorizeEcfmpMeasure(pilot);
-            if (pilot.ecfmpMeasuresCache.text != text || pilot.ecfmpMeasuresCache.colour != context.colour)
+            if (caches.ecfmpMeasuresCache.text != text || caches.ecfmpMeasuresCache.colour != context.colour)
             {
                 tagInterface_->UpdateTagValue(ECFMPMeasuresTagID_, text, context);
                 dataManager_->setPilotEcfmpMeasuresCache(callsign, text, context.colour);
@@ -225,7 +226,7 @@ void NeoVACDM::UpdateTagItems() {
 
         text = (pilot.hasBooking ? "B" : "");
         context.colour = Color::colorizeEventBooking(pilot);
-        if (pilot.eventBookingCache.text != text || pilot.eventBookingCache.colour != context.colour)
+        if (caches.eventBookingCache.text != text || caches.eventBookingCache.colour != context.colour)
         {
             tagInterface_->UpdateTagValue(EventBookingTagID_, text, context);
             dataManager_->setPilotEventBookingCache(callsign, text, context.colour);
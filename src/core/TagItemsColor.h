@@ -70,7 +70,7 @@ class Color {
 
         // If the time point is already at a multiple of ten minutes, no rounding is needed
         if (remainingMinutes == 10) {
-            rounded = std::chrono::time_point_cast<std::chrono::minutes>(pilot.ttot);
+            rounded = std::chrono::time_point_cast<std::chrono::minutes>(pilot.ttot.timePoint());
         } else {
             // Add the remaining minutes to the time point
             auto roundedUpMinutes = minutesSinceEpoch + std::chrono::minutes(remainingMinutes);
@@ -264,19 +264,20 @@ class Color {
             return pluginConfig.orange;
         }
         // Diff TOBT TSAT >= 5min && unconfirmed
-        if (diffTsatTobt >= 5 * 60 && (pilot.tobt_state == "GUESS" || pilot.tobt_state == "FLIGHTPLAN")) {
+        if (diffTsatTobt >= 5 * 60 &&
+            (types::TobtState::Guess == pilot.tobt_state || types::TobtState::Flightplan == pilot.tobt_state)) {
             return pluginConfig.lightyellow;
         }
         // Diff TOBT TSAT >= 5min && confirmed
-        if (diffTsatTobt >= 5 * 60 && pilot.tobt_state == "CONFIRMED") {
+        if (diffTsatTobt >= 5 * 60 && types::TobtState::Confirmed == pilot.tobt_state) {
             return pluginConfig.yellow;
         }
         // Diff TOBT TSAT < 5min
-        if (diffTsatTobt < 5 * 60 && pilot.tobt_state == "CONFIRMED") {
+        if (diffTsatTobt < 5 * 60 && types::TobtState::Confirmed == pilot.tobt_state) {
             return pluginConfig.green;
         }
         // tobt is not confirmed
-        if (pilot.tobt_state != "CONFIRMED") {
+        if (types::TobtState::Confirmed != pilot.tobt_state) {
             return pluginConfig.lightgreen;
         }
         return pluginConfig.debug;
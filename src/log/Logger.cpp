@@ -17,7 +17,7 @@ static const char __loggingTable[] =
 );";
 static const std::string __insertMessage = "INSERT INTO messages VALUES (CURRENT_TIMESTAMP, @1, @2, @3)";
 
-Logger::Logger() {
+Logger::Logger() : m_asynchronousLogs(logQueueCapacity) {
 #ifdef DEV
     this->enableLogging();
 #endif
@@ -34,56 +34,71 @@ void Logger::run() {
         if (m_stop) return;
         std::this_thread::sleep_for(std::chrono::milliseconds(500));
 
-        // obtain a copy of the logs, clear the log list to minimize lock time
-        this->m_logLock.lock();
-        auto logs = m_asynchronousLogs;
-        m_asynchronousLogs.clear();
-        this->m_logLock.unlock();
-
-        auto it = logs.begin();
-        while (it != logs.end()) {
-            auto logsetting = std::find_if(logSettings.begin(), logSettings.end(),
-                                           [it](const LogSetting &setting) { return setting.sender == it->sender; });
-
-            if (logsetting != logSettings.end() && it->loglevel >= logsetting->minimumLevel &&
-                false == this->m_LogAll) {
-            
-                if (vacdmLogger_)
-                {
-                    switch (it->loglevel)
-                    {
-                        case Info:
-                            vacdmLogger_->info(it->message.c_str());
-                            break;
-                        case Debug:
-                            vacdmLogger_->debug(it->message.c_str());
-                            break;
-                        case Warning:
-                            vacdmLogger_->warning(it->message.c_str());
-                            break;
-                        case Error:
-                            vacdmLogger_->error(it->message.c_str());
-                            break;
-                        case Critical:
-                            vacdmLogger_->fatal(it->message.c_str());
-                            break;
-                        case System:
-                            vacdmLogger_->verbose(it->message.c_str());
-                            break;
-                    }
-                } 
+        // the logs stay queued until the logger of the SDK is set
+        if (nullptr == vacdmLogger_) continue;
+
+        const auto logs = this->takeLogs();
+        for (auto it = logs.begin(); it != logs.end(); ++it) {
+            switch (it->loglevel)
+            {
+                case Info:
+                    vacdmLogger_->info(it->message.c_str());
+                    break;
+                case Debug:
+                    vacdmLogger_->debug(it->message.c_str());
+                    break;
+                case Warning:
+                    vacdmLogger_->warning(it->message.c_str());
+                    break;
+                case Error:
+                    vacdmLogger_->error(it->message.c_str());
+                    break;
+                case Critical:
+                    vacdmLogger_->fatal(it->message.c_str());
+                    break;
+                case System:
+                    vacdmLogger_->verbose(it->message.c_str());
+                    break;
             }
-            it = logs.erase(it);
         }
     }
 }
 
-void Logger::log(const LogSender &sender, const std::string &message, const LogLevel loglevel) {
-    std::lock_guard guard(this->m_logLock);
+std::vector<Logger::AsynchronousLog> Logger::takeLogs() {
+    // take the queued logs, the loggers are not blocked while the logs are written
+    std::vector<AsynchronousLog> logs;
+    logs.reserve(m_asynchronousLogs.size() + 1);
+    {
+        std::lock_guard guard(this->m_logLock);
+        m_asynchronousLogs.drain([this, &logs](AsynchronousLog &&entry) {
+            auto logsetting = std::find_if(logSettings.begin(), logSettings.end(), [&entry](const LogSetting &setting) {
+                return setting.sender == entry.sender;
+            });
+
+            if (logsetting != logSettings.end() && entry.loglevel >= logsetting->minimumLevel &&
+                false == this->m_LogAll)
+                logs.push_back(std::move(entry));
+        });
+    }
+
+    // the lines were dropped while the queue was full, which is after the taken lines were queued
+    const auto statistics = m_asynchronousLogs.statistics();
+    if (statistics.dropped != m_reportedDrops) {
+        logs.push_back({vACDM,
+                        std::to_string(statistics.dropped - m_reportedDrops) +
+                            " log lines dropped, the log queue was full (contended enqueues " +
+                            std::to_string(statistics.contended) + ")",
+                        Warning});
+        m_reportedDrops = statistics.dropped;
+    }
 
+    return logs;
+}
+
+void Logger::log(const LogSender &sender, const std::string &message, const LogLevel loglevel) {
     if (true == this->loggingEnabled) 
     {
-        m_asynchronousLogs.push_back({sender, message, loglevel});
+        m_asynchronousLogs.push({sender, message, loglevel});
     }
 }
 
@@ -168,12 +183,6 @@ std::pair<std::string,bool> Logger::handleLogLevelCommand(const std::vector<std:
     return {"Changed sender " + logSettingRef.name + " to " + newLevel, true};
 }
 
-void Logger::enableLogging() {
-    std::lock_guard guard(this->m_logLock);
-    this->loggingEnabled = true;
-}
+void Logger::enableLogging() { this->loggingEnabled = true; }
 
-void Logger::disableLogging() {
-    std::lock_guard guard(this->m_logLock);
-    this->loggingEnabled = false;
-}
+void Logger::disableLogging() { this->loggingEnabled = false; }
@@ -1,6 +1,7 @@
 #pragma once
 
-#include <list>
+#include <atomic>
+#include <cstdint>
 #include <mutex>
 #include <string>
 #include <thread>
@@ -8,7 +9,12 @@
 
 #include <NeoRadarSDK/SDK.h>
 
+#include "utils/MpscQueue.h"
+
 namespace vacdm::logging {
+/// @brief slots of the queue of the log messages, the queue is emptied by the log writer twice a second
+constexpr std::size_t logQueueCapacity = 4096;
+
 class Logger {
    public:
     enum LogSender {
@@ -43,7 +49,8 @@ class Logger {
 
     Logger();
     ~Logger();
-    /// @brief queues a log message to be processed asynchronously
+    /// @brief queues a log message to be processed asynchronously, does not block, the message is dropped if the
+    /// queue is full
     /// @param sender the sender (e.g. class)
     /// @param message the message to be displayed
     /// @param loglevel the severity, must be greater than m_minimumLogLevel to be logged
@@ -53,6 +60,8 @@ class Logger {
     std::pair<std::string,bool> handleLogLevelCommand(const std::vector<std::string> &args);
     
    private:
+    friend class LoggerTest;
+
 #ifdef DEV
     std::vector<LogSetting> logSettings = {
         {vACDM, "vACDM", Debug},   {DataManager, "DataManager", Info},
@@ -69,15 +78,21 @@ class Logger {
 #endif
     bool m_LogAll = false;
 
+    /// @brief guards logSettings and m_LogAll, which are changed by the chat commands and read by the log writer,
+    /// the queue of the logs does not need it
     std::mutex m_logLock;
-    std::list<struct AsynchronousLog> m_asynchronousLogs;
+    utils::MpscQueue<AsynchronousLog> m_asynchronousLogs;
+    std::uint64_t m_reportedDrops = 0;
     std::thread m_logWriter;
-    bool m_stop = false;
+    std::atomic<bool> m_stop = false;
     void run();
+    /// @brief takes the queued logs which pass the settings of their sender, only called by the log writer
+    /// @return the logs in their order, followed by a marker of the lines which were dropped since the last call
+    std::vector<AsynchronousLog> takeLogs();
 
     void enableLogging();
     void disableLogging();
-    bool loggingEnabled = false;
+    std::atomic<bool> loggingEnabled = false;
 
     PluginSDK::Logger::LoggerAPI *vacdmLogger_ = nullptr;;
 
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <chrono>
+#include <compare>
+#include <cstdint>
+
+namespace vacdm::types {
+static constexpr std::chrono::system_clock::time_point defaultTime =
+    std::chrono::system_clock::time_point(std::chrono::milliseconds(-1));
+
+/// @brief Time of the pilot data, stored as 48-bit signed count of milliseconds from the Unix epoch
+///
+/// Converts implicitly from and to std::chrono::system_clock::time_point. The backend sends and receives the times
+/// with millisecond resolution, those times and defaultTime are stored exactly. Finer fractions of local clock
+/// readings are floored to the millisecond, the same as in the ISO timestamps which are sent. The count covers more
+/// than the range of the clock.
+class CompactTime {
+   public:
+    using time_point = std::chrono::system_clock::time_point;
+
+    constexpr CompactTime() : CompactTime(defaultTime) {}
+    template <class Duration>
+    constexpr CompactTime(const std::chrono::time_point<std::chrono::system_clock, Duration> &timepoint)
+        : m_parts{} {
+        const auto count = static_cast<std::uint64_t>(
+            std::chrono::floor<std::chrono::milliseconds>(timepoint.time_since_epoch()).count());
+        this->m_parts[0] = static_cast<std::uint16_t>(count);
+        this->m_parts[1] = static_cast<std::uint16_t>(count >> 16);
+        this->m_parts[2] = static_cast<std::uint16_t>(count >> 32);
+    }
+
+    constexpr operator time_point() const { return this->timePoint(); }
+    constexpr time_point timePoint() const { return time_point(std::chrono::milliseconds(this->milliseconds())); }
+    constexpr time_point::duration time_since_epoch() const { return this->timePoint().time_since_epoch(); }
+
+    friend constexpr bool operator==(const CompactTime &lhs, const CompactTime &rhs) = default;
+    friend constexpr bool operator==(const CompactTime &lhs, const time_point &rhs) { return lhs.timePoint() == rhs; }
+    friend constexpr std::strong_ordering operator<=>(const CompactTime &lhs, const CompactTime &rhs) {
+        return lhs.milliseconds() <=> rhs.milliseconds();
+    }
+    friend constexpr std::strong_ordering operator<=>(const CompactTime &lhs, const time_point &rhs) {
+        return lhs.timePoint() <=> rhs;
+    }
+
+    friend constexpr time_point::duration operator-(const CompactTime &lhs, const CompactTime &rhs) {
+        return lhs.timePoint() - rhs.timePoint();
+    }
+    friend constexpr time_point::duration operator-(const CompactTime &lhs, const time_point &rhs) {
+        return lhs.timePoint() - rhs;
+    }
+    friend constexpr time_point::duration operator-(const time_point &lhs, const CompactTime &rhs) {
+        return lhs - rhs.timePoint();
+    }
+    template <class Rep, class Period>
+    friend constexpr auto operator+(const CompactTime &lhs, const std::chrono::duration<Rep, Period> &rhs) {
+        return lhs.timePoint() + rhs;
+    }
+    template <class Rep, class Period>
+    friend constexpr auto operator-(const CompactTime &lhs, const std::chrono::duration<Rep, Period> &rhs) {
+        return lhs.timePoint() - rhs;
+    }
+
+   private:
+    constexpr std::int64_t milliseconds() const {
+        const auto count = static_cast<std::uint64_t>(this->m_parts[0]) |
+                           static_cast<std::uint64_t>(this->m_parts[1]) << 16 |
+                           static_cast<std::uint64_t>(this->m_parts[2]) << 32;
+        // extend the sign of the 48-bit count
+        return static_cast<std::int64_t>(count << 16) >> 16;
+    }
+
+    /// @brief 16-bit parts instead of one 64-bit count, the times are packed without padding
+    std::uint16_t m_parts[3];
+};
+}  // namespace vacdm::types
@@ -3,6 +3,7 @@
 #include <array>
 #include <chrono>
 #include <string>
+#include <vector>
 
 namespace vacdm::types {
 // defines the types returned by the ECFMP API
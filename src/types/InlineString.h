@@ -0,0 +1,68 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace vacdm::types {
+/// @brief String of at most N - 1 characters which is stored in the object itself
+///
+/// Used for the short strings of the pilot data, e.g. callsigns and ICAO codes, which keeps the pilot records free
+/// of heap allocations. Values which do not fit are rejected by assign(), string literals are checked when they are
+/// compiled. The string converts implicitly to std::string_view, std::string has to be created explicitly.
+template <std::size_t N>
+class InlineString {
+    static_assert(N >= 2, "the string needs space for a character and the terminator");
+
+   public:
+    static constexpr std::size_t maxSize = N - 1;
+
+    constexpr InlineString() : m_data{} {}
+    template <std::size_t M>
+    InlineString(const char (&literal)[M]) : m_data{} {
+        static_assert(M <= N, "the literal does not fit into the string");
+        std::copy_n(literal, std::char_traits<char>::length(literal), this->m_data);
+    }
+
+    template <std::size_t M>
+    InlineString &operator=(const char (&literal)[M]) {
+        return *this = InlineString(literal);
+    }
+
+    /// @brief Replaces the characters by the value
+    /// @return false if the value is longer than maxSize or contains a null character, the string is unchanged then
+    [[nodiscard]] bool assign(std::string_view value) {
+        if (value.size() > maxSize || std::string_view::npos != value.find('\0')) return false;
+
+        std::copy_n(value.data(), value.size(), this->m_data);
+        std::fill(this->m_data + value.size(), this->m_data + N, '\0');
+        return true;
+    }
+
+    operator std::string_view() const { return std::string_view(this->m_data, this->size()); }
+    std::string str() const { return std::string(this->m_data, this->size()); }
+    const char *c_str() const { return this->m_data; }
+
+    std::size_t size() const { return std::char_traits<char>::length(this->m_data); }
+    bool empty() const { return '\0' == this->m_data[0]; }
+
+    /// the unused characters are always null, equal strings have equal arrays
+    friend bool operator==(const InlineString &lhs, const InlineString &rhs) {
+        return std::equal(lhs.m_data, lhs.m_data + N, rhs.m_data);
+    }
+    friend bool operator==(const InlineString &lhs, std::string_view rhs) { return std::string_view(lhs) == rhs; }
+    friend bool operator==(const InlineString &lhs, const std::string &rhs) { return std::string_view(lhs) == rhs; }
+    friend bool operator==(const InlineString &lhs, const char *rhs) { return std::string_view(lhs) == rhs; }
+
+    friend std::string operator+(std::string lhs, const InlineString &rhs) {
+        return lhs.append(rhs.m_data, rhs.size());
+    }
+    friend std::string operator+(const char *lhs, const InlineString &rhs) { return std::string(lhs) + rhs; }
+    friend std::string operator+(const InlineString &lhs, std::string_view rhs) { return lhs.str().append(rhs); }
+    friend std::string operator+(const InlineString &lhs, const char *rhs) { return lhs.str().append(rhs); }
+
+   private:
+    char m_data[N];
+};
+}  // namespace vacdm::types
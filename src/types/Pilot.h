@@ -1,80 +1,128 @@
 #pragma once
 
+#include <array>
 #include <chrono>
+#include <cstdint>
+#include <optional>
 #include <string>
+#include <string_view>
+#include <vector>
 
+#include "CompactTime.h"
 #include "Ecfmp.h"
+#include "InlineString.h"
 
 namespace vacdm::types {
-static constexpr std::chrono::system_clock::time_point defaultTime =
-    std::chrono::system_clock::time_point(std::chrono::milliseconds(-1));
-
 struct TagCacheItem {
     std::string text;
     std::optional<std::array<unsigned int, 3>> colour;
 };
 
-typedef struct Pilot_t {
-    std::string callsign;
-    std::chrono::system_clock::time_point lastUpdate;
+/// @brief texts and colours of the tag items which were last sent to Scope, kept once per callsign apart from the
+/// pilot data
+struct TagCaches {
+    TagCacheItem eobtCache;
+    TagCacheItem tobtCache;
+    TagCacheItem tsatCache;
+    TagCacheItem ttotCache;
+    TagCacheItem exotCache;
+    TagCacheItem asatCache;
+    TagCacheItem aobtCache;
+    TagCacheItem atotCache;
+    TagCacheItem asrtCache;
+    TagCacheItem aortCache;
+    TagCacheItem ctotCache;
+    TagCacheItem eventBookingCache;
+    TagCacheItem ecfmpMeasuresCache;
+};
 
-    bool inactive = false;
+/// @brief TOBT states of the backend, None if the backend did not send a state
+enum class TobtState : std::uint8_t {
+    None,
+    Guess,
+    Flightplan,
+    Confirmed,
+};
 
-    // position data
+/// @brief Returns the backend value of the state
+constexpr std::string_view tobtStateString(TobtState state) {
+    switch (state) {
+        case TobtState::Guess:
+            return "GUESS";
+        case TobtState::Flightplan:
+            return "FLIGHTPLAN";
+        case TobtState::Confirmed:
+            return "CONFIRMED";
+        default:
+            return "";
+    }
+}
+
+/// @brief Returns the state of the backend value, None for values which are not known
+constexpr TobtState tobtStateFromString(std::string_view state) {
+    if ("GUESS" == state) return TobtState::Guess;
+    if ("FLIGHTPLAN" == state) return TobtState::Flightplan;
+    if ("CONFIRMED" == state) return TobtState::Confirmed;
+    return TobtState::None;
+}
+
+/// @brief callsigns have up to ten characters on the network, the rest is a margin
+using Callsign = InlineString<16>;
+/// @brief ICAO codes of the airports and runway designators
+using ShortCode = InlineString<8>;
+/// @brief names of the departure procedures
+using ProcedureName = InlineString<16>;
+
+/// @brief Data of a pilot, stored three times per callsign (consolidated, Scope and backend data).
+/// The fields which are read by every merge and tag update come first and the flags are packed behind them, the
+/// tag items are kept in TagCaches. The strings and times are stored inline, only the ECFMP measures allocate.
+typedef struct Pilot_t {
+    Callsign callsign;
+    CompactTime lastUpdate = std::chrono::system_clock::time_point();
 
-    double latitude = 0.0;
-    double longitude = 0.0;
+    // ACDM procedure data
 
-    double trueAltitude = 0.0;
-    double distanceFromOrigin = 0.0;
+    CompactTime eobt = defaultTime;
+    CompactTime tobt = defaultTime;
+    CompactTime ctot = defaultTime;
+    CompactTime ttot = defaultTime;
+    CompactTime tsat = defaultTime;
+    CompactTime exot = defaultTime;
+    CompactTime asat = defaultTime;
+    CompactTime aobt = defaultTime;
+    CompactTime atot = defaultTime;
+    CompactTime asrt = defaultTime;
+    CompactTime aort = defaultTime;
+    TobtState tobt_state = TobtState::None;
 
+    bool inactive = false;
     bool taxizoneIsTaxiout = false;
     bool isSimulated = false;
 
-    // flightplan & clearance data
-
-    std::string origin;
-    std::string destination;
-    std::string runway;
-    std::string sid;
+    // event booking data
 
-    // ACDM procedure data
+    bool hasBooking = false;
 
-    std::chrono::system_clock::time_point eobt = defaultTime;
-    std::chrono::system_clock::time_point tobt = defaultTime;
-    std::string tobt_state;
-    std::chrono::system_clock::time_point ctot = defaultTime;
-    std::chrono::system_clock::time_point ttot = defaultTime;
-    std::chrono::system_clock::time_point tsat = defaultTime;
-    std::chrono::system_clock::time_point exot = defaultTime;
-    std::chrono::system_clock::time_point asat = defaultTime;
-    std::chrono::system_clock::time_point aobt = defaultTime;
-    std::chrono::system_clock::time_point atot = defaultTime;
-    std::chrono::system_clock::time_point asrt = defaultTime;
-    std::chrono::system_clock::time_point aort = defaultTime;
+    // flightplan & clearance data
 
-    // ECFMP Measures
+    ShortCode origin;
+    ShortCode destination;
+    ShortCode runway;
+    ProcedureName sid;
 
-    std::vector<EcfmpMeasure> measures;
+    // position data
 
-    // event booking data
+    double latitude = 0.0;
+    double longitude = 0.0;
 
-    bool hasBooking = false;
+    double trueAltitude = 0.0;
+    double distanceFromOrigin = 0.0;
 
-    // cache for tag colors
-    TagCacheItem eobtCache;
-    TagCacheItem tobtCache;
-    TagCacheItem tsatCache;
-    TagCacheItem ttotCache; 
-    TagCacheItem exotCache;
-    TagCacheItem asatCache;
-    TagCacheItem aobtCache;
-    TagCacheItem atotCache;
-    TagCacheItem asrtCache;
-    TagCacheItem aortCache;
-    TagCacheItem ctotCache;
-    TagCacheItem eventBookingCache;
-    TagCacheItem ecfmpMeasuresCache;
+    // ECFMP Measures
 
+    std::vector<EcfmpMeasure> measures;
 } Pilot;
+
+/// @brief a record of the snapshot store holds three pilots, a pilot fits into three cache lines
+static_assert(sizeof(Pilot) <= 200, "the pilot data should stay compact");
 }  // namespace vacdm::types
\ No newline at end of file
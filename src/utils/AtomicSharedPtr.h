@@ -0,0 +1,38 @@
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <utility>
+
+namespace vacdm::utils {
+/// @brief Shared pointer which is replaced by one thread while other threads copy it
+///
+/// Portable replacement of std::atomic<std::shared_ptr<T>>, which is not provided by every standard library. The
+/// mutex is only held to copy or swap the pointer, the previous value is released after the mutex is unlocked.
+template <typename T>
+class AtomicSharedPtr {
+   public:
+    AtomicSharedPtr() : m_lock(), m_value() {}
+    explicit AtomicSharedPtr(std::shared_ptr<T> value) : m_lock(), m_value(std::move(value)) {}
+
+    AtomicSharedPtr(const AtomicSharedPtr &) = delete;
+    AtomicSharedPtr &operator=(const AtomicSharedPtr &) = delete;
+
+    std::shared_ptr<T> load() const {
+        std::lock_guard guard(this->m_lock);
+        return this->m_value;
+    }
+
+    void store(std::shared_ptr<T> value) {
+        {
+            std::lock_guard guard(this->m_lock);
+            this->m_value.swap(value);
+        }
+        // value holds the previous pointer now, it may be the last reference
+    }
+
+   private:
+    mutable std::mutex m_lock;
+    std::shared_ptr<T> m_value;
+};
+}  // namespace vacdm::utils
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <string>
+
+#include <zlib.h>
+
+namespace vacdm::utils {
+
+class Compression {
+   public:
+    Compression() = delete;
+    Compression(const Compression &) = delete;
+    Compression(Compression &&) = delete;
+    Compression &operator=(const Compression &) = delete;
+    Compression &operator=(Compression &&) = delete;
+
+    /// @brief Compresses the data into the gzip format
+    /// @param data to compress
+    /// @param compressed receives the gzip stream
+    /// @return true if the data was compressed
+    static bool gzip(const std::string &data, std::string &compressed) {
+        z_stream stream{};
+        // 15 window bits plus 16 to write a gzip header instead of a zlib header
+        if (Z_OK != deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY))
+            return false;
+
+        compressed.resize(deflateBound(&stream, static_cast<uLong>(data.size())) + 18);
+        stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(data.data()));
+        stream.avail_in = static_cast<uInt>(data.size());
+        stream.next_out = reinterpret_cast<Bytef *>(compressed.data());
+        stream.avail_out = static_cast<uInt>(compressed.size());
+
+        const auto result = deflate(&stream, Z_FINISH);
+        compressed.resize(stream.total_out);
+        deflateEnd(&stream);
+
+        return Z_STREAM_END == result;
+    }
+
+    /// @brief Decompresses gzip, zlib or raw deflate data
+    ///
+    /// HTTP "deflate" is defined as the zlib format, but some servers send raw deflate streams.
+    /// The format is detected by the header of the data, raw streams are tried if no header is found.
+    /// @param data to decompress
+    /// @param decompressed receives the decompressed data
+    /// @return true if the data was a complete compressed stream
+    static bool inflate(const std::string &data, std::string &decompressed) {
+        // 15 window bits plus 32 to detect the gzip or zlib header
+        if (true == Compression::inflate(data, decompressed, 15 + 32)) return true;
+        return Compression::inflate(data, decompressed, -15);
+    }
+
+   private:
+    static bool inflate(const std::string &data, std::string &decompressed, int windowBits) {
+        z_stream stream{};
+        if (Z_OK != inflateInit2(&stream, windowBits)) return false;
+
+        stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(data.data()));
+        stream.avail_in = static_cast<uInt>(data.size());
+
+        // JSON compresses well, start with a buffer which fits the usual ratio
+        decompressed.resize(data.size() * 8 + 1024);
+        int result = Z_OK;
+        do {
+            if (stream.total_out == decompressed.size()) decompressed.resize(decompressed.size() * 2);
+            stream.next_out = reinterpret_cast<Bytef *>(decompressed.data() + stream.total_out);
+            stream.avail_out = static_cast<uInt>(decompressed.size() - stream.total_out);
+
+            result = ::inflate(&stream, Z_NO_FLUSH);
+        } while (Z_OK == result);
+        decompressed.resize(stream.total_out);
+        inflateEnd(&stream);
+
+        return Z_STREAM_END == result;
+    }
+};
+}  // namespace vacdm::utils
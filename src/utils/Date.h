@@ -1,15 +1,13 @@
 #pragma once
 
 #include <chrono>
+#include <cstring>
 #include <string>
+#include <string_view>
 
 #include <NeoRadarSDK/SDK.h>
 
-#ifdef _WIN32
-#define MKTIME_UTC _mkgmtime
-#else
-#define MKTIME_UTC timegm
-#endif
+#include "types/Pilot.h"
 
 #define DEFAULT_TIMESTAMP "1969-12-31T23:59:59.999Z"
 
@@ -23,56 +21,91 @@ class Date {
     Date &operator=(const Date &) = delete;
     Date &operator=(Date &&) = delete;
 
-    /// @brief Converts std::chrono::system_clock::time_point to an ISO-formatted string.
+    /// @brief length of the ISO timestamps, "YYYY-MM-DDTHH:MM:SS.mmmZ"
+    static constexpr std::size_t isoStringLength = 24;
+
+    /// @brief Writes the ISO timestamp of a time_point with millisecond precision.
     ///
-    /// This function takes a std::chrono::system_clock::time_point and converts it to an
-    /// ISO-formatted string. The resulting string follows the format "%Y-%m-%dT%H:%M:%S.Z".
-    /// The function ensures proper formatting, including the addition of "Z" to indicate UTC.
+    /// The timestamp has the fixed format "YYYY-MM-DDTHH:MM:SS.mmmZ". Time points before the epoch are written as
+    /// DEFAULT_TIMESTAMP, which stands for times which are not set.
     ///
-    /// If the provided time_point is non-negative (i.e., not before the epoch), the
-    /// function formats it into a string and appends "Z" to indicate UTC. If the time_point
-    /// is negative, the function returns a default timestamp representing "1969-12-31T23:59:59.999Z".
+    /// @param timepoint std::chrono::system_clock::time_point to be converted.
+    /// @param out buffer of at least isoStringLength characters, the timestamp is not null-terminated.
+    static void writeIsoString(const std::chrono::system_clock::time_point &timepoint, char *out) {
+        if (timepoint.time_since_epoch().count() < 0) {
+            std::memcpy(out, DEFAULT_TIMESTAMP, isoStringLength);
+            return;
+        }
+
+        const auto milliseconds = std::chrono::floor<std::chrono::milliseconds>(timepoint);
+        const auto day = std::chrono::floor<std::chrono::days>(milliseconds);
+        const std::chrono::year_month_day date(day);
+        const std::chrono::hh_mm_ss time(milliseconds - day);
+
+        writeDigits(out, static_cast<unsigned int>(static_cast<int>(date.year())), 4);
+        out[4] = '-';
+        writeDigits(out + 5, static_cast<unsigned int>(date.month()), 2);
+        out[7] = '-';
+        writeDigits(out + 8, static_cast<unsigned int>(date.day()), 2);
+        out[10] = 'T';
+        writeDigits(out + 11, static_cast<unsigned int>(time.hours().count()), 2);
+        out[13] = ':';
+        writeDigits(out + 14, static_cast<unsigned int>(time.minutes().count()), 2);
+        out[16] = ':';
+        writeDigits(out + 17, static_cast<unsigned int>(time.seconds().count()), 2);
+        out[19] = '.';
+        writeDigits(out + 20, static_cast<unsigned int>(time.subseconds().count()), 3);
+        out[23] = 'Z';
+    }
+
+    /// @brief Converts std::chrono::system_clock::time_point to an ISO-formatted string.
+    ///
+    /// The resulting string has the format "YYYY-MM-DDTHH:MM:SS.mmmZ", a time_point before the epoch is returned as
+    /// the default timestamp "1969-12-31T23:59:59.999Z".
     ///
     /// @param timepoint std::chrono::system_clock::time_point to be converted.
     /// @return ISO-formatted string representing the converted timestamp.
     static std::string timestampToIsoString(const std::chrono::system_clock::time_point &timepoint) {
-        if (timepoint.time_since_epoch().count() >= 0) {
-            std::stringstream stream;
-            stream << std::format("{0:%FT%T}", timepoint);
-            auto timestamp = stream.str();
-            timestamp = timestamp.substr(0, timestamp.length() - 4) + "Z";
-            return timestamp;
-        } else {
-            return DEFAULT_TIMESTAMP;
-        }
+        std::string timestamp(isoStringLength, '\0');
+        writeIsoString(timepoint, timestamp.data());
+        return timestamp;
     }
 
     /// @brief Converts an ISO-formatted string to std::chrono::system_clock::time_point.
     ///
-    /// This function takes an ISO-formatted string representing a timestamp and converts
-    /// it to a std::chrono::system_clock::time_point. The input string is expected to be in
-    /// the format "%Y-%m-%dT%H:%M:%S".
-    ///
-    /// The function uses a std::stringstream to parse the input string and create a
-    /// std::chrono::system_clock::time_point. The resulting time_point is then returned.
+    /// The input string is expected in the format "YYYY-MM-DDTHH:MM:SS", optionally followed by a fraction of the
+    /// second and the zone designator, which is always UTC. The first three digits of the fraction are kept. The
+    /// default timestamp and strings which are not valid timestamps are converted to types::defaultTime.
     ///
     /// @param timestamp ISO-formatted string representing the timestamp.
     /// @return std::chrono::system_clock::time_point representing the converted timestamp.
-    static std::chrono::system_clock::time_point isoStringToTimestamp(const std::string &timestamp) {
-        std::chrono::system_clock::time_point retval;
-        std::stringstream stream;
-        std::tm timeDate = {};
+    static std::chrono::system_clock::time_point isoStringToTimestamp(std::string_view timestamp) {
+        if (timestamp.size() < 19 || DEFAULT_TIMESTAMP == timestamp) return types::defaultTime;
 
-        if (timestamp == DEFAULT_TIMESTAMP) {
-            retval = types::defaultTime;
-        }
-        else {
-            stream << timestamp.substr(0, timestamp.length() - 5);
-            stream >> std::get_time(&timeDate, "%Y-%m-%dT%H:%M:%S");
-            retval = std::chrono::system_clock::from_time_t(MKTIME_UTC(&timeDate));
+        const char *in = timestamp.data();
+        unsigned int year, month, day, hours, minutes, seconds;
+        const bool valid = readDigits(in, 4, year) && '-' == in[4] && readDigits(in + 5, 2, month) && '-' == in[7] &&
+                           readDigits(in + 8, 2, day) && 'T' == in[10] && readDigits(in + 11, 2, hours) &&
+                           ':' == in[13] && readDigits(in + 14, 2, minutes) && ':' == in[16] &&
+                           readDigits(in + 17, 2, seconds);
+        if (false == valid || hours > 23 || minutes > 59 || seconds > 59) return types::defaultTime;
+
+        const std::chrono::year_month_day date(std::chrono::year(static_cast<int>(year)), std::chrono::month(month),
+                                               std::chrono::day(day));
+        if (false == date.ok()) return types::defaultTime;
+
+        // the fraction has any number of digits, only the milliseconds are kept
+        unsigned int milliseconds = 0;
+        if (timestamp.size() > 20 && '.' == in[19]) {
+            unsigned int scale = 100;
+            for (std::size_t i = 20; i < timestamp.size() && i < 23 && '0' <= in[i] && '9' >= in[i]; ++i) {
+                milliseconds += static_cast<unsigned int>(in[i] - '0') * scale;
+                scale /= 10;
+            }
         }
 
-        return retval;
+        return std::chrono::sys_days(date) + std::chrono::hours(hours) + std::chrono::minutes(minutes) +
+               std::chrono::seconds(seconds) + std::chrono::milliseconds(milliseconds);
     }
 
     /// @brief Converts a Scope departure time string to a UTC time_point.
@@ -90,36 +123,59 @@ class Date {
         return convertStringToTimePoint(eobt);
     }
     /// @brief Converts a 4-character HHMM string to a UTC time_point.
-    /// This function takes a 4-character string representing time in HHMM format.
-    /// If the string is not valid (empty or exceeds 4 characters), the function returns the
-    /// current UTC time. Otherwise, it constructs a formatted string combining the current
-    /// date (year, month, day) with the given time, ensuring proper zero-padding.
-    /// The formatted string is then parsed to obtain a std::chrono::system_clock::time_point.
+    /// This function takes a string of up to 4 digits representing time in HHMM format, shorter strings have implicit
+    /// leading zeros. If the string is not a valid time, the function returns the current UTC time.
+    ///
+    /// The time is placed on the day which brings it closest to the current time, an EOBT of 0010 which is seen at
+    /// 2350 is on the next day, an EOBT of 2350 which is seen at 0010 on the previous day.
     ///
     /// @param hhmmString The 4-character string representing time in HHMM format.
     /// @return std::chrono::system_clock::time_point representing the converted time.
     ///
     static std::chrono::system_clock::time_point convertStringToTimePoint(const std::string &hhmmString) {
-        const auto now = std::chrono::system_clock::now();
-        if (hhmmString.length() == 0 || hhmmString.length() > 4) {
+        return convertStringToTimePoint(hhmmString, std::chrono::system_clock::now());
+    }
+
+    /// @brief Converts a 4-character HHMM string to a UTC time_point relative to the given current time.
+    static std::chrono::system_clock::time_point convertStringToTimePoint(
+        std::string_view hhmmString, const std::chrono::system_clock::time_point &now) {
+        unsigned int clock;
+        if (hhmmString.length() == 0 || hhmmString.length() > 4 ||
+            false == readDigits(hhmmString.data(), hhmmString.length(), clock))
             return now;
-        }
 
-        std::stringstream stream;
-        stream << std::format("{0:%Y%m%d}", now);
-        std::size_t requiredLeadingZeros = 4 - hhmmString.length();
-        while (requiredLeadingZeros != 0) {
-            requiredLeadingZeros -= 1;
-            stream << "0";
-        }
-        stream << hhmmString;
+        const auto hours = clock / 100, minutes = clock % 100;
+        if (hours > 23 || minutes > 59) return now;
 
-        std::chrono::system_clock::time_point time;
-        std::tm timeDate = {};
-        stream >> std::get_time(&timeDate, "%Y%m%d%H%M");
-        time = std::chrono::system_clock::from_time_t(MKTIME_UTC(&timeDate));  
+        auto time = std::chrono::floor<std::chrono::days>(now) + std::chrono::hours(hours) +
+                    std::chrono::minutes(minutes);
+        if (time - now > std::chrono::hours(12))
+            time -= std::chrono::days(1);
+        else if (now - time > std::chrono::hours(12))
+            time += std::chrono::days(1);
 
-        return time;
+        return std::chrono::time_point_cast<std::chrono::system_clock::duration>(time);
+    }
+
+   private:
+    /// @brief writes the value as decimal number with the given number of digits, leading zeros included
+    static void writeDigits(char *out, unsigned int value, std::size_t count) {
+        for (std::size_t i = count; i > 0; --i) {
+            out[i - 1] = static_cast<char>('0' + value % 10);
+            value /= 10;
+        }
+    }
+
+    /// @brief reads the given number of decimal digits
+    /// @return false if one of the characters is not a digit
+    static bool readDigits(const char *in, std::size_t count, unsigned int &value) {
+        value = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            const auto digit = static_cast<unsigned int>(in[i] - '0');
+            if (digit > 9) return false;
+            value = value * 10 + digit;
+        }
+        return true;
     }
 };
 }  // namespace vacdm::utils
@@ -0,0 +1,136 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+namespace vacdm::utils {
+/// @brief Bounded lock-free queue with multiple producers and a single consumer
+///
+/// The slots are allocated once by the constructor and reused, an enqueue moves the value into a free slot and does
+/// not allocate. The producers reserve the slots with an atomic position, every slot carries a sequence number which
+/// tells the consumer that the value was written and the producers that the consumer took it. A full queue drops the
+/// new value instead of blocking the producer.
+template <typename T>
+class MpscQueue {
+   public:
+    struct Statistics {
+        std::uint64_t enqueued = 0;
+        /// @brief values which were rejected because the queue was full
+        std::uint64_t dropped = 0;
+        /// @brief retries of the producers because another producer reserved the same slot
+        std::uint64_t contended = 0;
+    };
+
+    /// @param capacity number of slots, rounded up to the next power of two
+    explicit MpscQueue(std::size_t capacity)
+        : m_capacity(MpscQueue::roundCapacity(capacity)),
+          m_slots(std::make_unique<Slot[]>(m_capacity)),
+          m_enqueuePosition(0),
+          m_dequeuePosition(0),
+          m_enqueued(0),
+          m_dropped(0),
+          m_contended(0) {
+        for (std::size_t i = 0; i < this->m_capacity; ++i) this->m_slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    MpscQueue(const MpscQueue &) = delete;
+    MpscQueue &operator=(const MpscQueue &) = delete;
+
+    /// @brief Enqueues the value, may be called by any thread
+    /// @param value moved into the queue, unchanged if the queue is full
+    /// @return false if the queue is full and the value was dropped
+    bool push(T &&value) {
+        auto position = this->m_enqueuePosition.load(std::memory_order_relaxed);
+
+        while (true) {
+            auto &slot = this->m_slots[position & (this->m_capacity - 1)];
+            const auto sequence = slot.sequence.load(std::memory_order_acquire);
+            const auto difference = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position);
+
+            if (0 == difference) {
+                if (true == this->m_enqueuePosition.compare_exchange_strong(position, position + 1,
+                                                                            std::memory_order_relaxed)) {
+                    slot.value = std::move(value);
+                    slot.sequence.store(position + 1, std::memory_order_release);
+                    this->m_enqueued.fetch_add(1, std::memory_order_relaxed);
+                    return true;
+                }
+                // the position was updated by the failed exchange
+                this->m_contended.fetch_add(1, std::memory_order_relaxed);
+            } else if (difference < 0) {
+                // the consumer did not take the value of the previous round yet
+                this->m_dropped.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            } else {
+                this->m_contended.fetch_add(1, std::memory_order_relaxed);
+                position = this->m_enqueuePosition.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /// @brief Takes the queued values in their order, must only be called by the consumer thread
+    /// @param consumer called with every value as rvalue
+    /// @return number of taken values
+    template <typename Consumer>
+    std::size_t drain(Consumer &&consumer) {
+        auto position = this->m_dequeuePosition.load(std::memory_order_relaxed);
+        std::size_t count = 0;
+
+        while (true) {
+            auto &slot = this->m_slots[position & (this->m_capacity - 1)];
+            const auto sequence = slot.sequence.load(std::memory_order_acquire);
+
+            // the slot is empty or a producer is still writing it, the following values are taken by the next drain
+            if (sequence != position + 1) break;
+
+            consumer(std::move(slot.value));
+            slot.sequence.store(position + this->m_capacity, std::memory_order_release);
+
+            position += 1;
+            count += 1;
+            this->m_dequeuePosition.store(position, std::memory_order_relaxed);
+        }
+
+        return count;
+    }
+
+    /// @brief Returns the number of queued values, including the values which are written right now
+    std::size_t size() const {
+        const auto dequeuePosition = this->m_dequeuePosition.load(std::memory_order_relaxed);
+        const auto enqueuePosition = this->m_enqueuePosition.load(std::memory_order_relaxed);
+        return enqueuePosition > dequeuePosition ? enqueuePosition - dequeuePosition : 0;
+    }
+    bool empty() const { return 0 == this->size(); }
+    std::size_t capacity() const { return this->m_capacity; }
+
+    Statistics statistics() const {
+        return {this->m_enqueued.load(std::memory_order_relaxed), this->m_dropped.load(std::memory_order_relaxed),
+                this->m_contended.load(std::memory_order_relaxed)};
+    }
+
+   private:
+    struct Slot {
+        std::atomic<std::size_t> sequence;
+        T value;
+    };
+
+    static std::size_t roundCapacity(std::size_t capacity) {
+        std::size_t rounded = 2;
+        while (rounded < capacity) rounded <<= 1;
+        return rounded;
+    }
+
+    const std::size_t m_capacity;
+    std::unique_ptr<Slot[]> m_slots;
+
+    // the positions are written by different threads and kept on separate cache lines
+    alignas(64) std::atomic<std::size_t> m_enqueuePosition;
+    alignas(64) std::atomic<std::size_t> m_dequeuePosition;
+    alignas(64) std::atomic<std::uint64_t> m_enqueued;
+    std::atomic<std::uint64_t> m_dropped;
+    std::atomic<std::uint64_t> m_contended;
+};
+}  // namespace vacdm::utils
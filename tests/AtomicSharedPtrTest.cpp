@@ -0,0 +1,48 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "utils/AtomicSharedPtr.h"
+
+using vacdm::utils::AtomicSharedPtr;
+
+TEST(AtomicSharedPtrTest, LoadedValueOutlivesReplacement) {
+    AtomicSharedPtr<const std::string> pointer(std::make_shared<const std::string>("first"));
+
+    const auto loaded = pointer.load();
+    pointer.store(std::make_shared<const std::string>("second"));
+
+    EXPECT_EQ("first", *loaded);
+    EXPECT_EQ("second", *pointer.load());
+    EXPECT_EQ(1, loaded.use_count());
+
+    pointer.store(nullptr);
+    EXPECT_EQ(nullptr, pointer.load());
+}
+
+TEST(AtomicSharedPtrTest, ReadersSeeCompleteValues) {
+    AtomicSharedPtr<const std::vector<int>> pointer(std::make_shared<const std::vector<int>>(16, 0));
+    std::atomic<bool> stop = false;
+
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 4; ++i) {
+        readers.emplace_back([&pointer, &stop]() {
+            while (false == stop) {
+                const auto values = pointer.load();
+                ASSERT_EQ(16u, values->size());
+                // every stored vector contains the same value in all elements
+                for (const auto value : *values) ASSERT_EQ(values->front(), value);
+            }
+        });
+    }
+
+    for (int i = 1; i <= 10000; ++i) pointer.store(std::make_shared<const std::vector<int>>(16, i));
+    stop = true;
+    for (auto &reader : readers) reader.join();
+
+    EXPECT_EQ(10000, pointer.load()->front());
+}
@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+
+#include "core/CircuitBreaker.h"
+
+using namespace std::chrono_literals;
+using vacdm::com::CircuitBreaker;
+
+namespace {
+constexpr std::chrono::milliseconds openDuration = 50ms;
+
+/// @brief opens the breaker with the failures of the threshold
+void open(CircuitBreaker &breaker) {
+    for (int i = 0; i < 3; ++i) {
+        ASSERT_EQ(CircuitBreaker::Decision::Send, breaker.acquire());
+        breaker.recordFailure();
+    }
+    ASSERT_EQ(CircuitBreaker::State::Open, breaker.state());
+}
+}  // namespace
+
+TEST(CircuitBreakerTest, OpensAfterConsecutiveFailures) {
+    CircuitBreaker breaker(3, openDuration, 200ms);
+
+    EXPECT_FALSE(breaker.recordFailure());
+    EXPECT_FALSE(breaker.recordFailure());
+    EXPECT_EQ(CircuitBreaker::State::Closed, breaker.state());
+    EXPECT_TRUE(breaker.recordFailure());
+    EXPECT_EQ(CircuitBreaker::State::Open, breaker.state());
+    EXPECT_EQ(CircuitBreaker::Decision::Reject, breaker.acquire());
+}
+
+TEST(CircuitBreakerTest, SuccessResetsFailureCount) {
+    CircuitBreaker breaker(3, openDuration, 200ms);
+
+    breaker.recordFailure();
+    breaker.recordFailure();
+    breaker.recordSuccess();
+    EXPECT_FALSE(breaker.recordFailure());
+    EXPECT_FALSE(breaker.recordFailure());
+    EXPECT_EQ(CircuitBreaker::State::Closed, breaker.state());
+}
+
+TEST(CircuitBreakerTest, AllowsSingleProbeAfterOpenDuration) {
+    CircuitBreaker breaker(3, openDuration, 200ms);
+    open(breaker);
+
+    std::this_thread::sleep_for(openDuration + 20ms);
+    EXPECT_EQ(CircuitBreaker::Decision::Probe, breaker.acquire());
+    EXPECT_EQ(CircuitBreaker::State::HalfOpen, breaker.state());
+    // the other callers wait for the result of the probe
+    EXPECT_EQ(CircuitBreaker::Decision::Reject, breaker.acquire());
+
+    breaker.recordSuccess();
+    EXPECT_EQ(CircuitBreaker::State::Closed, breaker.state());
+    EXPECT_EQ(CircuitBreaker::Decision::Send, breaker.acquire());
+}
+
+TEST(CircuitBreakerTest, FailedProbeDoublesOpenDuration) {
+    CircuitBreaker breaker(3, openDuration, 200ms);
+    open(breaker);
+
+    std::this_thread::sleep_for(openDuration + 20ms);
+    ASSERT_EQ(CircuitBreaker::Decision::Probe, breaker.acquire());
+    EXPECT_TRUE(breaker.recordFailure());
+    EXPECT_EQ(CircuitBreaker::State::Open, breaker.state());
+
+    // the breaker stays open for twice the duration
+    std::this_thread::sleep_for(openDuration + 20ms);
+    EXPECT_EQ(CircuitBreaker::Decision::Reject, breaker.acquire());
+    std::this_thread::sleep_for(openDuration);
+    EXPECT_EQ(CircuitBreaker::Decision::Probe, breaker.acquire());
+}
+
+TEST(CircuitBreakerTest, OpenDurationIsLimited) {
+    CircuitBreaker breaker(1, openDuration, 80ms);
+    ASSERT_TRUE(breaker.recordFailure());
+
+    // 50ms, doubled to 80ms instead of 100ms, and limited to 80ms for all further probes
+    for (int i = 0; i < 3; ++i) {
+        std::this_thread::sleep_for(100ms);
+        ASSERT_EQ(CircuitBreaker::Decision::Probe, breaker.acquire());
+        breaker.recordFailure();
+    }
+}
+
+TEST(CircuitBreakerTest, ResetCloses) {
+    CircuitBreaker breaker(3, openDuration, 200ms);
+    open(breaker);
+
+    breaker.reset();
+    EXPECT_EQ(CircuitBreaker::State::Closed, breaker.state());
+    EXPECT_EQ(CircuitBreaker::Decision::Send, breaker.acquire());
+}
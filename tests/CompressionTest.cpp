@@ -0,0 +1,78 @@
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include <zlib.h>
+
+#include "utils/Compression.h"
+
+using vacdm::utils::Compression;
+
+namespace {
+const std::string content =
+    R"([{"callsign":"DLH1","vacdm":{"tobt":"2024-01-01T10:00:00.000Z"}},)"
+    R"({"callsign":"DLH2","vacdm":{"tobt":"2024-01-01T10:05:00.000Z"}}])";
+
+/// @brief compresses the data with the window bits of the format, negative bits write a raw deflate stream
+std::string deflateWith(const std::string &data, int windowBits) {
+    z_stream stream{};
+    EXPECT_EQ(Z_OK, deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, windowBits, 8, Z_DEFAULT_STRATEGY));
+
+    std::string compressed(deflateBound(&stream, static_cast<uLong>(data.size())) + 18, '\0');
+    stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(data.data()));
+    stream.avail_in = static_cast<uInt>(data.size());
+    stream.next_out = reinterpret_cast<Bytef *>(compressed.data());
+    stream.avail_out = static_cast<uInt>(compressed.size());
+    EXPECT_EQ(Z_STREAM_END, deflate(&stream, Z_FINISH));
+    compressed.resize(stream.total_out);
+    deflateEnd(&stream);
+
+    return compressed;
+}
+}  // namespace
+
+TEST(CompressionTest, GzipIsInflatedAgain) {
+    std::string compressed;
+    ASSERT_TRUE(Compression::gzip(content, compressed));
+    // the gzip magic bytes
+    ASSERT_LE(2u, compressed.size());
+    EXPECT_EQ('\x1f', compressed[0]);
+    EXPECT_EQ('\x8b', compressed[1]);
+
+    std::string decompressed;
+    ASSERT_TRUE(Compression::inflate(compressed, decompressed));
+    EXPECT_EQ(content, decompressed);
+}
+
+TEST(CompressionTest, InflatesZlibStream) {
+    std::string decompressed;
+    ASSERT_TRUE(Compression::inflate(deflateWith(content, 15), decompressed));
+    EXPECT_EQ(content, decompressed);
+}
+
+TEST(CompressionTest, FallsBackToRawDeflateStream) {
+    std::string decompressed;
+    ASSERT_TRUE(Compression::inflate(deflateWith(content, -15), decompressed));
+    EXPECT_EQ(content, decompressed);
+}
+
+TEST(CompressionTest, InflatesContentLargerThanInitialBuffer) {
+    // compresses far better than the ratio of the initial buffer
+    const std::string large(1024 * 1024, 'x');
+
+    std::string compressed;
+    ASSERT_TRUE(Compression::gzip(large, compressed));
+    std::string decompressed;
+    ASSERT_TRUE(Compression::inflate(compressed, decompressed));
+    EXPECT_EQ(large, decompressed);
+}
+
+TEST(CompressionTest, RejectsTruncatedStream) {
+    std::string compressed;
+    ASSERT_TRUE(Compression::gzip(content, compressed));
+    compressed.resize(compressed.size() / 2);
+
+    std::string decompressed;
+    EXPECT_FALSE(Compression::inflate(compressed, decompressed));
+    EXPECT_FALSE(Compression::inflate("not compressed", decompressed));
+}
@@ -0,0 +1,190 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <list>
+#include <string>
+
+#include "core/DataManager.h"
+
+using namespace std::chrono_literals;
+
+namespace vacdm::core {
+namespace {
+// same indices of the records as in the DataManager
+constexpr std::size_t ConsolidatedData = 0;
+constexpr std::size_t ScopeData = 1;
+constexpr std::size_t ServerData = 2;
+
+const std::chrono::system_clock::time_point someTime = std::chrono::system_clock::time_point(1704103200000ms);
+
+std::string callsign(std::size_t index) { return "DLH" + std::to_string(index); }
+
+/// @brief returns the local pilots with the Scope data of the callsigns
+PilotSnapshotStore::Pilots localPilots(std::size_t count) {
+    PilotSnapshotStore::Pilots pilots;
+    for (std::size_t i = 0; i < count; ++i) {
+        PilotRecord record;
+        for (auto &pilot : record) EXPECT_TRUE(pilot.callsign.assign(callsign(i)));
+        record[ScopeData].origin = "EDDM";
+        pilots.emplace(callsign(i), PilotSnapshotStore::makeRecord(std::move(record)));
+    }
+    return pilots;
+}
+
+/// @brief returns the backend pilots in the reversed order of the local pilots, the TOBT identifies the pilot
+std::list<types::Pilot> backendPilots(std::size_t count) {
+    std::list<types::Pilot> pilots;
+    for (std::size_t i = 0; i < count; ++i) {
+        types::Pilot pilot;
+        EXPECT_TRUE(pilot.callsign.assign(callsign(i)));
+        pilot.tobt = someTime + std::chrono::minutes(i);
+        pilots.push_front(std::move(pilot));
+    }
+    return pilots;
+}
+}  // namespace
+
+class DataManagerTest : public ::testing::Test {
+   protected:
+    // without a server the worker does not change any pilots
+    DataManagerTest() : m_dataManager(nullptr, nullptr) {}
+
+    void mergeBackendPilots(PilotSnapshotStore::Pilots &pilots, std::list<types::Pilot> backendPilots) {
+        m_dataManager.mergeBackendPilots(pilots, std::move(backendPilots));
+    }
+
+    /// @brief merges the backend pilots with a linear search for every local pilot, like the DataManager did before
+    /// the callsign index
+    void mergeBackendPilotsLinear(PilotSnapshotStore::Pilots &pilots, std::list<types::Pilot> backendPilots) {
+        for (auto pilot = pilots.begin(); pilots.end() != pilot;) {
+            const auto &scopeData = (*pilot->second)[ScopeData];
+            bool removeFlight = (*pilot->second)[ServerData].inactive == true;
+            for (auto updateIt = backendPilots.begin(); updateIt != backendPilots.end(); ++updateIt) {
+                if (updateIt->callsign == scopeData.callsign) {
+                    auto &record = PilotSnapshotStore::modify(pilot->second);
+                    record[ServerData] = std::move(*updateIt);
+                    m_dataManager.consolidateData(record);
+                    removeFlight = false;
+                    updateIt = backendPilots.erase(updateIt);
+                    break;
+                }
+            }
+
+            if (true == removeFlight) {
+                pilot = pilots.erase(pilot);
+            } else {
+                ++pilot;
+            }
+        }
+    }
+
+    /// @brief returns the shortest duration of the merge of the backend pilots into copies of the local pilots
+    template <typename Merge>
+    static std::chrono::microseconds measure(std::size_t count, Merge merge) {
+        const auto pilots = localPilots(count);
+        auto shortest = std::chrono::microseconds::max();
+        for (int run = 0; run < 3; ++run) {
+            auto copy = pilots;
+            auto backend = backendPilots(count);
+
+            const auto start = std::chrono::steady_clock::now();
+            merge(copy, std::move(backend));
+            const auto duration = std::chrono::steady_clock::now() - start;
+
+            shortest = std::min(shortest, std::chrono::duration_cast<std::chrono::microseconds>(duration));
+        }
+        return shortest;
+    }
+
+    DataManager m_dataManager;
+};
+
+TEST_F(DataManagerTest, MergeUpdatesServerDataOfLocalPilots) {
+    auto pilots = localPilots(3);
+    auto backend = backendPilots(2);
+    // the backend does not know the local pilot yet
+    backend.push_back(types::Pilot());
+    backend.back().callsign = "AFR1";
+
+    this->mergeBackendPilots(pilots, std::move(backend));
+
+    ASSERT_EQ(3u, pilots.size());
+    EXPECT_EQ(someTime + 1min, (*pilots.at(callsign(1)))[ServerData].tobt);
+    EXPECT_EQ(someTime + 1min, (*pilots.at(callsign(1)))[ConsolidatedData].tobt);
+    EXPECT_EQ("EDDM", (*pilots.at(callsign(1)))[ConsolidatedData].origin);
+    EXPECT_EQ(types::defaultTime, (*pilots.at(callsign(2)))[ServerData].tobt);
+    EXPECT_EQ(0u, pilots.count("AFR1"));
+}
+
+TEST_F(DataManagerTest, MergeUsesFirstPilotOfDuplicateCallsign) {
+    auto pilots = localPilots(1);
+    auto backend = backendPilots(1);
+    backend.push_back(backend.front());
+    backend.back().tobt = someTime + 1h;
+
+    this->mergeBackendPilots(pilots, std::move(backend));
+
+    EXPECT_EQ(someTime, (*pilots.at(callsign(0)))[ConsolidatedData].tobt);
+}
+
+TEST_F(DataManagerTest, MergeRemovesPilotsWhichAreInactiveInBackend) {
+    auto pilots = localPilots(2);
+    auto backend = backendPilots(2);
+    backend.front().inactive = true;
+    this->mergeBackendPilots(pilots, std::move(backend));
+
+    // the inactive pilot is kept until the backend does not send it anymore
+    ASSERT_EQ(2u, pilots.size());
+    EXPECT_TRUE((*pilots.at(callsign(1)))[ConsolidatedData].inactive);
+
+    backend = backendPilots(2);
+    backend.pop_front();
+    this->mergeBackendPilots(pilots, std::move(backend));
+    EXPECT_EQ(1u, pilots.size());
+    EXPECT_EQ(0u, pilots.count(callsign(1)));
+}
+
+TEST_F(DataManagerTest, IndexedMergeMatchesLinearMerge) {
+    auto indexed = localPilots(50);
+    auto linear = localPilots(50);
+
+    // unknown, inactive and duplicate pilots of the backend
+    auto backend = backendPilots(60);
+    std::size_t index = 0;
+    for (auto &pilot : backend) pilot.inactive = 0 == index++ % 7;
+    backend.push_back(backend.front());
+    backend.back().tobt = someTime + 1h;
+
+    this->mergeBackendPilots(indexed, backend);
+    this->mergeBackendPilotsLinear(linear, backend);
+
+    ASSERT_EQ(linear.size(), indexed.size());
+    for (const auto &[callsign, record] : linear) {
+        ASSERT_EQ(1u, indexed.count(callsign)) << callsign;
+        const auto &pilot = (*indexed.at(callsign))[ConsolidatedData];
+        EXPECT_EQ((*record)[ConsolidatedData].tobt, pilot.tobt) << callsign;
+        EXPECT_EQ((*record)[ConsolidatedData].inactive, pilot.inactive) << callsign;
+    }
+}
+
+TEST_F(DataManagerTest, IndexedMergeIsFasterThanLinearMerge) {
+    for (const std::size_t count : {200, 1000, 5000}) {
+        const auto linear = measure(count, [this](PilotSnapshotStore::Pilots &pilots, std::list<types::Pilot> update) {
+            this->mergeBackendPilotsLinear(pilots, std::move(update));
+        });
+        const auto indexed = measure(count, [this](PilotSnapshotStore::Pilots &pilots, std::list<types::Pilot> update) {
+            this->mergeBackendPilots(pilots, std::move(update));
+        });
+
+        std::cout << "merge of " << count << " pilots: linear " << linear.count() << " us, indexed "
+                  << indexed.count() << " us" << std::endl;
+        RecordProperty("linear" + std::to_string(count), static_cast<int>(linear.count()));
+        RecordProperty("indexed" + std::to_string(count), static_cast<int>(indexed.count()));
+
+        // the quadratic search dominates with many pilots, fewer pilots are within the noise of the record copies
+        if (5000 == count) EXPECT_LT(indexed, linear);
+    }
+}
+}  // namespace vacdm::core
@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "utils/Date.h"
+
+using namespace std::chrono_literals;
+using namespace vacdm;
+using vacdm::utils::Date;
+
+namespace {
+/// @brief returns the time point of the UTC date and time
+std::chrono::system_clock::time_point utc(int year, unsigned int month, unsigned int day,
+                                          std::chrono::milliseconds time = 0ms) {
+    return std::chrono::sys_days(std::chrono::year(year) / std::chrono::month(month) / std::chrono::day(day)) + time;
+}
+}  // namespace
+
+TEST(DateTest, WritesIsoTimestamps) {
+    EXPECT_EQ("1970-01-01T00:00:00.000Z", Date::timestampToIsoString(utc(1970, 1, 1)));
+    EXPECT_EQ("2024-01-01T10:00:00.123Z", Date::timestampToIsoString(utc(2024, 1, 1, 10h + 123ms)));
+    EXPECT_EQ("2024-02-29T23:59:59.999Z", Date::timestampToIsoString(utc(2024, 2, 29, 24h - 1ms)));
+    EXPECT_EQ("2000-12-31T05:06:07.089Z", Date::timestampToIsoString(utc(2000, 12, 31, 5h + 6min + 7s + 89ms)));
+    // the fraction is truncated to milliseconds
+    EXPECT_EQ("2024-01-01T10:00:00.123Z", Date::timestampToIsoString(utc(2024, 1, 1, 10h + 123ms) + 999us));
+}
+
+TEST(DateTest, WritesDefaultTimestampBeforeEpoch) {
+    EXPECT_EQ(DEFAULT_TIMESTAMP, Date::timestampToIsoString(types::defaultTime));
+    EXPECT_EQ(DEFAULT_TIMESTAMP, Date::timestampToIsoString(utc(1969, 7, 20, 20h + 17min)));
+    EXPECT_EQ(types::defaultTime, Date::isoStringToTimestamp(DEFAULT_TIMESTAMP));
+}
+
+TEST(DateTest, ReadsWrittenTimestamps) {
+    for (const auto &timepoint : {utc(1970, 1, 1), utc(2024, 2, 29, 24h - 1ms), utc(2099, 6, 15, 12h + 34min + 56s)})
+        EXPECT_EQ(timepoint, Date::isoStringToTimestamp(Date::timestampToIsoString(timepoint)));
+}
+
+TEST(DateTest, ReadsFractionsOfAnyLength) {
+    const auto time = utc(2024, 1, 1, 10h);
+
+    EXPECT_EQ(time, Date::isoStringToTimestamp("2024-01-01T10:00:00"));
+    EXPECT_EQ(time, Date::isoStringToTimestamp("2024-01-01T10:00:00Z"));
+    EXPECT_EQ(time + 500ms, Date::isoStringToTimestamp("2024-01-01T10:00:00.5Z"));
+    EXPECT_EQ(time + 120ms, Date::isoStringToTimestamp("2024-01-01T10:00:00.12Z"));
+    EXPECT_EQ(time + 123ms, Date::isoStringToTimestamp("2024-01-01T10:00:00.123456Z"));
+}
+
+TEST(DateTest, ReadsInvalidTimestampsAsDefaultTime) {
+    const std::vector<std::string> invalid = {
+        "",
+        "2024-01-01",
+        "2024-01-01T10:00",
+        "2024-01-01 10:00:00Z",
+        "2024/01/01T10:00:00Z",
+        "2024-13-01T10:00:00Z",
+        "2023-02-29T10:00:00Z",
+        "2024-01-01T24:00:00Z",
+        "2024-01-01T10:60:00Z",
+        "2024-01-01T10:00:60Z",
+        "2024-0a-01T10:00:00Z",
+        "2024-01-01T-1:00:00Z",
+    };
+    for (const auto &timestamp : invalid)
+        EXPECT_EQ(types::defaultTime, Date::isoStringToTimestamp(timestamp)) << timestamp;
+}
+
+TEST(DateTest, ConvertsClockTimeOnSameDay) {
+    const auto now = utc(2024, 1, 1, 10h + 30s);
+
+    EXPECT_EQ(utc(2024, 1, 1, 12h + 15min), Date::convertStringToTimePoint("1215", now));
+    EXPECT_EQ(utc(2024, 1, 1, 8h + 5min), Date::convertStringToTimePoint("0805", now));
+    // shorter strings have implicit leading zeros
+    EXPECT_EQ(utc(2024, 1, 1, 1h + 30min), Date::convertStringToTimePoint("130", now));
+    EXPECT_EQ(utc(2024, 1, 1, 5min), Date::convertStringToTimePoint("5", now));
+}
+
+TEST(DateTest, ConvertsClockTimeAroundMidnight) {
+    // an EOBT after midnight which is seen before midnight is on the next day
+    EXPECT_EQ(utc(2024, 1, 2, 10min), Date::convertStringToTimePoint("0010", utc(2024, 1, 1, 23h + 50min)));
+    // an EOBT before midnight which is seen after midnight is on the previous day
+    EXPECT_EQ(utc(2024, 1, 1, 23h + 50min), Date::convertStringToTimePoint("2350", utc(2024, 1, 2, 10min)));
+    // midnight itself
+    EXPECT_EQ(utc(2024, 1, 2), Date::convertStringToTimePoint("0000", utc(2024, 1, 1, 23h + 59min + 59s)));
+    EXPECT_EQ(utc(2024, 1, 2), Date::convertStringToTimePoint("0000", utc(2024, 1, 2)));
+    EXPECT_EQ(utc(2024, 1, 1, 23h + 59min), Date::convertStringToTimePoint("2359", utc(2024, 1, 2)));
+
+    // the rollover changes the month, the year and reaches the leap day
+    EXPECT_EQ(utc(2024, 1, 1, 15min), Date::convertStringToTimePoint("0015", utc(2023, 12, 31, 23h + 45min)));
+    EXPECT_EQ(utc(2023, 12, 31, 23h + 45min), Date::convertStringToTimePoint("2345", utc(2024, 1, 1, 15min)));
+    EXPECT_EQ(utc(2024, 2, 29, 5min), Date::convertStringToTimePoint("0005", utc(2024, 2, 28, 23h + 55min)));
+    EXPECT_EQ(utc(2023, 3, 1, 5min), Date::convertStringToTimePoint("0005", utc(2023, 2, 28, 23h + 55min)));
+}
+
+TEST(DateTest, ConvertsClockTimeToClosestDay) {
+    const auto now = utc(2024, 1, 1, 11h + 58min);
+
+    // exactly twelve hours apart stays on the same day
+    EXPECT_EQ(utc(2024, 1, 1, 23h + 58min), Date::convertStringToTimePoint("2358", now));
+    EXPECT_EQ(utc(2023, 12, 31, 23h + 59min), Date::convertStringToTimePoint("2359", now));
+
+    const auto afternoon = utc(2024, 1, 1, 12h + 2min);
+    EXPECT_EQ(utc(2024, 1, 1, 2min), Date::convertStringToTimePoint("0002", afternoon));
+    EXPECT_EQ(utc(2024, 1, 2, 1min), Date::convertStringToTimePoint("0001", afternoon));
+}
+
+TEST(DateTest, ReturnsCurrentTimeForInvalidClockTime) {
+    const auto now = utc(2024, 1, 1, 10h + 123ms);
+
+    for (const auto *clock : {"", "2400", "1260", "12345", "ab12", "12:0", "-100"})
+        EXPECT_EQ(now, Date::convertStringToTimePoint(clock, now)) << clock;
+}
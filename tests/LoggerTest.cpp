@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "log/Logger.h"
+
+namespace vacdm::logging {
+class LoggerTest : public ::testing::Test {
+   protected:
+    // without the logger of the SDK the log writer leaves the logs in the queue for takeLogs
+    LoggerTest() : m_logger() { m_logger.handleLogLevelCommand({"vACDM", "DEBUG"}); }
+
+    std::vector<Logger::AsynchronousLog> takeLogs() { return m_logger.takeLogs(); }
+
+    Logger m_logger;
+};
+
+TEST_F(LoggerTest, TakesLogsOfEnabledSenders) {
+    m_logger.handleLogLevelCommand({"Server", "WARNING"});
+    m_logger.log(Logger::vACDM, "first", Logger::Debug);
+    m_logger.log(Logger::Server, "filtered", Logger::Info);
+    m_logger.log(Logger::Server, "second", Logger::Error);
+
+    const auto logs = this->takeLogs();
+    ASSERT_EQ(2u, logs.size());
+    EXPECT_EQ("first", logs[0].message);
+    EXPECT_EQ("second", logs[1].message);
+    EXPECT_TRUE(this->takeLogs().empty());
+}
+
+TEST_F(LoggerTest, MarksDroppedLinesAfterQueuedLines) {
+    const auto capacity = logQueueCapacity;
+    for (std::size_t i = 0; i < capacity + 10; ++i)
+        m_logger.log(Logger::vACDM, "line " + std::to_string(i), Logger::Info);
+
+    auto logs = this->takeLogs();
+    ASSERT_EQ(capacity + 1, logs.size());
+    EXPECT_EQ("line " + std::to_string(capacity - 1), logs[capacity - 1].message);
+    EXPECT_EQ(Logger::Warning, logs.back().loglevel);
+    EXPECT_EQ(0u, logs.back().message.find("10 log lines dropped")) << logs.back().message;
+
+    // the drops are only reported once, the queue accepts lines again
+    m_logger.log(Logger::vACDM, "after", Logger::Info);
+    logs = this->takeLogs();
+    ASSERT_EQ(1u, logs.size());
+    EXPECT_EQ("after", logs.front().message);
+}
+
+TEST_F(LoggerTest, DisabledLoggingQueuesNothing) {
+    m_logger.handleLogCommand("OFF");
+    m_logger.log(Logger::vACDM, "ignored", Logger::Critical);
+    EXPECT_TRUE(this->takeLogs().empty());
+
+    m_logger.handleLogCommand("ON");
+    m_logger.log(Logger::vACDM, "logged", Logger::Critical);
+    EXPECT_EQ(1u, this->takeLogs().size());
+}
+
+TEST_F(LoggerTest, ConcurrentLinesAreTakenCompletely) {
+    constexpr int producers = 4;
+    constexpr int linesPerProducer = 1000;
+
+    // the lines fit into the queue, none of them is dropped
+    std::vector<std::thread> threads;
+    for (int producer = 0; producer < producers; ++producer) {
+        threads.emplace_back([this, producer]() {
+            for (int i = 0; i < linesPerProducer; ++i)
+                m_logger.log(Logger::vACDM, std::to_string(producer) + " " + std::to_string(i), Logger::Info);
+        });
+    }
+    for (auto &thread : threads) thread.join();
+
+    const auto logs = this->takeLogs();
+    ASSERT_EQ(std::size_t(producers * linesPerProducer), logs.size());
+
+    std::vector<int> next(producers, 0);
+    for (const auto &entry : logs) {
+        const auto separator = entry.message.find(' ');
+        const auto producer = std::stoi(entry.message.substr(0, separator));
+        EXPECT_EQ(next[producer]++, std::stoi(entry.message.substr(separator + 1))) << entry.message;
+    }
+}
+}  // namespace vacdm::logging
@@ -0,0 +1,146 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include "core/MessageWriter.h"
+#include "utils/Date.h"
+
+using namespace std::chrono_literals;
+using namespace vacdm;
+using vacdm::com::MessageWriter;
+
+namespace {
+const std::chrono::system_clock::time_point someTime = std::chrono::system_clock::time_point(1704103200123ms);
+
+/// @brief times which are formatted differently, the default time is written as the default timestamp
+const std::vector<std::chrono::system_clock::time_point> times = {
+    types::defaultTime,
+    std::chrono::system_clock::time_point(),
+    someTime,
+    someTime + 59min + 59s + 876ms,
+};
+
+/// @brief callsigns which need escape sequences in the messages
+const std::vector<std::string> callsigns = {
+    "DLH123", "", "DLH\"1", "DLH\\1", "DLH\n\t\r\b\f1", std::string("DLH\x01\x1f", 5), "DLH\xc3\xa4\xe2\x82\xac",
+};
+
+types::Pilot pilot(const std::string &callsign) {
+    types::Pilot pilot;
+    EXPECT_TRUE(pilot.callsign.assign(callsign));
+    pilot.origin = "EDDM";
+    pilot.destination = "EDDF";
+    pilot.runway = "26R";
+    pilot.sid = "GIVMI1N";
+    pilot.latitude = 48.353783;
+    pilot.longitude = 11.786086;
+    pilot.eobt = someTime;
+    pilot.tobt = someTime + 5min;
+    pilot.tsat = someTime + 10min;
+    return pilot;
+}
+
+/// @brief reference of the writer, builds the creation message as a document like the plugin did before the writer
+nlohmann::json pilotCreationDocument(const types::Pilot &pilot) {
+    nlohmann::json root;
+
+    root["callsign"] = pilot.callsign.str();
+    root["inactive"] = false;
+
+    root["position"] = nlohmann::json();
+    root["position"]["lat"] = pilot.latitude;
+    root["position"]["lon"] = pilot.longitude;
+
+    root["flightplan"] = nlohmann::json();
+    root["flightplan"]["departure"] = pilot.origin.str();
+    root["flightplan"]["arrival"] = pilot.destination.str();
+
+    root["vacdm"] = nlohmann::json();
+    root["vacdm"]["eobt"] = utils::Date::timestampToIsoString(pilot.eobt);
+    root["vacdm"]["tobt"] = utils::Date::timestampToIsoString(pilot.tobt);
+
+    root["clearance"] = nlohmann::json();
+    root["clearance"]["dep_rwy"] = pilot.runway.str();
+    root["clearance"]["sid"] = pilot.sid.str();
+
+    return root;
+}
+}  // namespace
+
+TEST(MessageWriterTest, PilotCreationMatchesDocument) {
+    MessageWriter writer;
+    for (const auto &callsign : callsigns) {
+        const auto created = pilot(callsign);
+        EXPECT_EQ(pilotCreationDocument(created).dump(), writer.pilotCreation(created)) << callsign;
+    }
+}
+
+TEST(MessageWriterTest, NumbersMatchDocument) {
+    const std::vector<double> coordinates = {
+        0.0, -0.0, 1.0, -90.0, 0.1, 1.0 / 3.0, 1e-7, 123456789.125, std::numeric_limits<double>::max(),
+        std::numeric_limits<double>::denorm_min(),
+        // not finite numbers are written as null
+        std::numeric_limits<double>::quiet_NaN(), std::numeric_limits<double>::infinity(),
+    };
+
+    MessageWriter writer;
+    for (const auto coordinate : coordinates) {
+        auto created = pilot("DLH123");
+        created.latitude = coordinate;
+        created.longitude = -coordinate;
+        EXPECT_EQ(pilotCreationDocument(created).dump(), writer.pilotCreation(created)) << coordinate;
+    }
+}
+
+TEST(MessageWriterTest, TimesMatchDocument) {
+    MessageWriter writer;
+    for (const auto &time : times) {
+        auto created = pilot("DLH123");
+        created.eobt = time;
+        created.tobt = time;
+        EXPECT_EQ(pilotCreationDocument(created).dump(), writer.pilotCreation(created));
+    }
+}
+
+TEST(MessageWriterTest, NextMessageReplacesContent) {
+    MessageWriter writer;
+    const std::string longCallsign(types::Callsign::maxSize, 'D');
+
+    writer.pilotCreation(pilot(longCallsign));
+    // the shorter message does not keep a part of the longer one
+    EXPECT_EQ(pilotCreationDocument(pilot("DLH1")).dump(), writer.pilotCreation(pilot("DLH1")));
+    EXPECT_EQ(pilotCreationDocument(pilot(longCallsign)).dump(), writer.pilotCreation(pilot(longCallsign)));
+}
+
+TEST(MessageWriterTest, WriterIsFasterThanDocument) {
+    constexpr int messages = 20000;
+    std::vector<types::Pilot> pilots;
+    for (int i = 0; i < messages; ++i) pilots.push_back(pilot("DLH" + std::to_string(i)));
+
+    // the bytes are summed up so that the serialisation is not optimised away
+    std::size_t documentBytes = 0, writerBytes = 0;
+    const auto documentStart = std::chrono::steady_clock::now();
+    for (const auto &created : pilots) documentBytes += pilotCreationDocument(created).dump().size();
+    const auto document = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() -
+                                                                                documentStart);
+
+    MessageWriter writer;
+    const auto writerStart = std::chrono::steady_clock::now();
+    for (const auto &created : pilots) writerBytes += writer.pilotCreation(created).size();
+    const auto written =
+        std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - writerStart);
+
+    std::cout << "creation of " << messages << " messages: document " << document.count() << " us, writer "
+              << written.count() << " us" << std::endl;
+    RecordProperty("document", static_cast<int>(document.count()));
+    RecordProperty("writer", static_cast<int>(written.count()));
+
+    EXPECT_EQ(documentBytes, writerBytes);
+    EXPECT_LT(written, document);
+}
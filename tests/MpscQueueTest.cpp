@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "utils/MpscQueue.h"
+
+using vacdm::utils::MpscQueue;
+
+namespace {
+std::vector<int> drainAll(MpscQueue<int> &queue) {
+    std::vector<int> values;
+    queue.drain([&values](int &&value) { values.push_back(value); });
+    return values;
+}
+}  // namespace
+
+TEST(MpscQueueTest, RoundsCapacityUpToPowerOfTwo) {
+    EXPECT_EQ(2u, MpscQueue<int>(0).capacity());
+    EXPECT_EQ(2u, MpscQueue<int>(2).capacity());
+    EXPECT_EQ(8u, MpscQueue<int>(5).capacity());
+    EXPECT_EQ(4096u, MpscQueue<int>(4096).capacity());
+}
+
+TEST(MpscQueueTest, DropsValuesWhileFull) {
+    MpscQueue<int> queue(4);
+    for (int value = 0; value < 4; ++value) EXPECT_TRUE(queue.push(int(value)));
+
+    EXPECT_FALSE(queue.push(4));
+    EXPECT_FALSE(queue.push(5));
+    EXPECT_EQ(4u, queue.size());
+
+    const auto statistics = queue.statistics();
+    EXPECT_EQ(4u, statistics.enqueued);
+    EXPECT_EQ(2u, statistics.dropped);
+
+    // the queued values are kept, the dropped ones are lost
+    EXPECT_EQ((std::vector<int>{0, 1, 2, 3}), drainAll(queue));
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(MpscQueueTest, DroppedValueIsNotMoved) {
+    MpscQueue<std::unique_ptr<std::string>> queue(2);
+    EXPECT_TRUE(queue.push(std::make_unique<std::string>("first")));
+    EXPECT_TRUE(queue.push(std::make_unique<std::string>("second")));
+
+    auto dropped = std::make_unique<std::string>("dropped");
+    EXPECT_FALSE(queue.push(std::move(dropped)));
+    ASSERT_NE(nullptr, dropped);
+    EXPECT_EQ("dropped", *dropped);
+}
+
+TEST(MpscQueueTest, SlotsAreReusedAfterDrain) {
+    MpscQueue<int> queue(4);
+
+    // several rounds over all slots
+    for (int round = 0; round < 5; ++round) {
+        for (int value = 0; value < 3; ++value) ASSERT_TRUE(queue.push(round * 10 + value));
+        EXPECT_EQ((std::vector<int>{round * 10, round * 10 + 1, round * 10 + 2}), drainAll(queue));
+    }
+    EXPECT_EQ(0u, queue.statistics().dropped);
+    EXPECT_TRUE(drainAll(queue).empty());
+}
+
+TEST(MpscQueueTest, ConcurrentProducersKeepTheirOrder) {
+    constexpr int producers = 4;
+    constexpr int valuesPerProducer = 100000;
+    MpscQueue<std::uint64_t> queue(256);
+
+    // the small queue is full most of the time, the producers retry the dropped values
+    std::vector<std::thread> threads;
+    for (int producer = 0; producer < producers; ++producer) {
+        threads.emplace_back([&queue, producer]() {
+            for (std::uint64_t i = 0; i < valuesPerProducer; ++i) {
+                while (false == queue.push((std::uint64_t(producer) << 32) | i)) std::this_thread::yield();
+            }
+        });
+    }
+
+    std::vector<std::uint64_t> next(producers, 0);
+    std::uint64_t received = 0, outOfOrder = 0;
+    while (received < std::uint64_t(producers) * valuesPerProducer) {
+        const auto count = queue.drain([&next, &outOfOrder](std::uint64_t &&value) {
+            auto &expected = next[value >> 32];
+            if ((value & 0xffffffff) != expected) ++outOfOrder;
+            expected = (value & 0xffffffff) + 1;
+        });
+        received += count;
+        if (0 == count) std::this_thread::yield();
+    }
+    for (auto &thread : threads) thread.join();
+
+    EXPECT_EQ(0u, outOfOrder);
+    for (const auto count : next) EXPECT_EQ(std::uint64_t(valuesPerProducer), count);
+    EXPECT_EQ(received, queue.statistics().enqueued);
+    EXPECT_TRUE(queue.empty());
+}
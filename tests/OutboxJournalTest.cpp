@@ -0,0 +1,175 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include "core/OutboxJournal.h"
+
+using namespace std::chrono_literals;
+using vacdm::core::OutboxJournal;
+
+namespace {
+constexpr std::chrono::minutes maxAge = 30min;
+
+nlohmann::json patch(const std::string &callsign, const std::string &field, const std::string &value) {
+    return {{"callsign", callsign}, {"vacdm", {{field, value}}}};
+}
+}  // namespace
+
+class OutboxJournalTest : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        const auto test = ::testing::UnitTest::GetInstance()->current_test_info();
+        m_path = (std::filesystem::temp_directory_path() /
+                  (std::string("vacdm_outbox_") + test->name() + ".jsonl"))
+                     .string();
+        std::filesystem::remove(m_path);
+    }
+    void TearDown() override { std::filesystem::remove(m_path); }
+
+    std::string m_path;
+    const std::chrono::system_clock::time_point m_now =
+        std::chrono::floor<std::chrono::milliseconds>(std::chrono::system_clock::now());
+};
+
+TEST_F(OutboxJournalTest, ReplaysOnlyPilotsWithRejectedActions) {
+    OutboxJournal journal;
+    ASSERT_TRUE(journal.open(m_path, maxAge));
+
+    const auto tobt = journal.append(4, "DLH1", m_now, patch("DLH1", "tobt", "A"));
+    const auto asat = journal.append(7, "DLH1", m_now, patch("DLH1", "asat", "B"));
+    journal.append(7, "AFR1", m_now, patch("AFR1", "asat", "C"));
+
+    journal.reject({tobt});
+    const auto entries = journal.takeReplayEntries();
+
+    // the accepted actions of the rejected pilot are sent again together with the rejected one
+    ASSERT_EQ(1u, entries.size());
+    EXPECT_EQ("DLH1", entries.front().callsign);
+    EXPECT_EQ((std::vector<std::uint64_t>{tobt, asat}), entries.front().ids);
+    EXPECT_EQ("A", entries.front().message["vacdm"]["tobt"]);
+    EXPECT_EQ("B", entries.front().message["vacdm"]["asat"]);
+}
+
+TEST_F(OutboxJournalTest, ReplayedActionsCountAsSent) {
+    OutboxJournal journal;
+    ASSERT_TRUE(journal.open(m_path, maxAge));
+
+    const auto id = journal.append(4, "DLH1", m_now, patch("DLH1", "tobt", "A"));
+    journal.reject({id});
+    ASSERT_EQ(1u, journal.takeReplayEntries().size());
+    EXPECT_TRUE(journal.takeReplayEntries().empty());
+
+    journal.reject({id});
+    EXPECT_EQ(1u, journal.takeReplayEntries().size());
+
+    journal.acknowledge({id});
+    journal.reject({id});
+    EXPECT_TRUE(journal.takeReplayEntries().empty());
+    EXPECT_EQ(0u, journal.pendingEntries());
+}
+
+TEST_F(OutboxJournalTest, DeletionReplacesEarlierActionsOfPilot) {
+    OutboxJournal journal;
+    ASSERT_TRUE(journal.open(m_path, maxAge));
+
+    const auto before = journal.append(4, "DLH1", m_now, patch("DLH1", "tobt", "A"));
+    const auto deletion = journal.append(16, "DLH1", m_now, nullptr);
+    const auto after = journal.append(7, "DLH1", m_now, patch("DLH1", "asat", "B"));
+
+    journal.reject({after});
+    const auto entries = journal.takeReplayEntries();
+
+    ASSERT_EQ(2u, entries.size());
+    EXPECT_TRUE(entries.front().message.is_null());
+    EXPECT_EQ((std::vector<std::uint64_t>{before, deletion}), entries.front().ids);
+    EXPECT_EQ((std::vector<std::uint64_t>{after}), entries.back().ids);
+    EXPECT_FALSE(entries.back().message["vacdm"].contains("tobt"));
+}
+
+TEST_F(OutboxJournalTest, DiscardedActionsAreNotReplayed) {
+    {
+        OutboxJournal journal;
+        ASSERT_TRUE(journal.open(m_path, maxAge));
+
+        const auto tobt = journal.append(4, "DLH1", m_now, patch("DLH1", "tobt", "A"));
+        const auto asat = journal.append(7, "AFR1", m_now, patch("AFR1", "asat", "B"));
+        journal.reject({tobt, asat});
+
+        journal.discard();
+        EXPECT_EQ(0u, journal.pendingEntries());
+        EXPECT_TRUE(journal.takeReplayEntries().empty());
+
+        // a message of the cleared data which is taken by the sender afterwards does not bring the actions back
+        journal.reject({tobt});
+        EXPECT_TRUE(journal.takeReplayEntries().empty());
+    }
+
+    OutboxJournal journal;
+    ASSERT_TRUE(journal.open(m_path, maxAge));
+    EXPECT_EQ(0u, journal.pendingEntries());
+    EXPECT_TRUE(journal.takeReplayEntries().empty());
+}
+
+TEST_F(OutboxJournalTest, ReopenedJournalReplaysUnconfirmedActions) {
+    std::uint64_t unconfirmed = 0;
+    {
+        OutboxJournal journal;
+        ASSERT_TRUE(journal.open(m_path, maxAge));
+
+        unconfirmed = journal.append(4, "DLH1", m_now, patch("DLH1", "tobt", "A"));
+        const auto confirmed = journal.append(7, "AFR1", m_now, patch("AFR1", "asat", "B"));
+        journal.acknowledge({confirmed});
+    }
+
+    OutboxJournal journal;
+    ASSERT_TRUE(journal.open(m_path, maxAge));
+    EXPECT_EQ(1u, journal.pendingEntries());
+
+    const auto entries = journal.takeReplayEntries();
+    ASSERT_EQ(1u, entries.size());
+    EXPECT_EQ((std::vector<std::uint64_t>{unconfirmed}), entries.front().ids);
+    EXPECT_EQ(m_now, entries.front().value);
+
+    // new entries do not reuse the ids of the previous session
+    EXPECT_GT(journal.append(4, "DLH1", m_now, patch("DLH1", "tobt", "C")), unconfirmed);
+}
+
+TEST_F(OutboxJournalTest, DropsActionsOlderThanMaxAge) {
+    {
+        std::ofstream stream(m_path);
+        const auto journaledAt = [](std::chrono::system_clock::time_point timepoint) {
+            return std::chrono::duration_cast<std::chrono::milliseconds>(timepoint.time_since_epoch()).count();
+        };
+        stream << nlohmann::json({{"id", 1},
+                                  {"type", 4},
+                                  {"callsign", "DLH1"},
+                                  {"value", 0},
+                                  {"journaledAt", journaledAt(m_now - maxAge - 1min)},
+                                  {"message", patch("DLH1", "tobt", "A")}})
+                      .dump()
+               << "\n"
+               << nlohmann::json({{"id", 2},
+                                  {"type", 4},
+                                  {"callsign", "AFR1"},
+                                  {"value", 0},
+                                  {"journaledAt", journaledAt(m_now - 1min)},
+                                  {"message", patch("AFR1", "tobt", "B")}})
+                      .dump()
+               << "\n"
+               // the plugin stopped while the last line was written
+               << R"({"id":3,"type":4,"call)";
+    }
+
+    OutboxJournal journal;
+    ASSERT_TRUE(journal.open(m_path, maxAge));
+
+    const auto entries = journal.takeReplayEntries();
+    ASSERT_EQ(1u, entries.size());
+    EXPECT_EQ("AFR1", entries.front().callsign);
+}
@@ -0,0 +1,239 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <list>
+#include <string>
+
+#include <nlohmann/json.hpp>
+
+#include "core/PilotDecoder.h"
+#include "utils/Date.h"
+
+using namespace std::chrono_literals;
+using namespace vacdm;
+
+namespace {
+/// @brief decodes the pilots with a JSON document like the plugin did before the streaming decoder
+std::list<types::Pilot> decodeWithDocument(const std::string &body) {
+    std::list<types::Pilot> pilots;
+
+    const auto root = nlohmann::json::parse(body);
+    for (const auto &pilot : root) {
+        pilots.push_back(types::Pilot());
+
+        EXPECT_TRUE(pilots.back().callsign.assign(pilot["callsign"].get<std::string>()));
+        pilots.back().lastUpdate = utils::Date::isoStringToTimestamp(pilot["updatedAt"].get<std::string>());
+        pilots.back().inactive = pilot["inactive"].get<bool>();
+
+        pilots.back().latitude = pilot["position"]["lat"].get<double>();
+        pilots.back().longitude = pilot["position"]["lon"].get<double>();
+        pilots.back().taxizoneIsTaxiout = pilot["vacdm"]["taxizoneIsTaxiout"].get<bool>();
+
+        EXPECT_TRUE(pilots.back().origin.assign(pilot["flightplan"]["departure"].get<std::string>()));
+        EXPECT_TRUE(pilots.back().destination.assign(pilot["flightplan"]["arrival"].get<std::string>()));
+        EXPECT_TRUE(pilots.back().runway.assign(pilot["clearance"]["dep_rwy"].get<std::string>()));
+        EXPECT_TRUE(pilots.back().sid.assign(pilot["clearance"]["sid"].get<std::string>()));
+
+        pilots.back().eobt = utils::Date::isoStringToTimestamp(pilot["vacdm"]["eobt"].get<std::string>());
+        pilots.back().tobt = utils::Date::isoStringToTimestamp(pilot["vacdm"]["tobt"].get<std::string>());
+        pilots.back().tobt_state = types::tobtStateFromString(pilot["vacdm"]["tobt_state"].get<std::string>());
+        pilots.back().ctot = utils::Date::isoStringToTimestamp(pilot["vacdm"]["ctot"].get<std::string>());
+        pilots.back().ttot = utils::Date::isoStringToTimestamp(pilot["vacdm"]["ttot"].get<std::string>());
+        pilots.back().tsat = utils::Date::isoStringToTimestamp(pilot["vacdm"]["tsat"].get<std::string>());
+        pilots.back().exot =
+            std::chrono::system_clock::time_point(std::chrono::minutes(pilot["vacdm"]["exot"].get<long int>()));
+        pilots.back().asat = utils::Date::isoStringToTimestamp(pilot["vacdm"]["asat"].get<std::string>());
+        pilots.back().aobt = utils::Date::isoStringToTimestamp(pilot["vacdm"]["aobt"].get<std::string>());
+        pilots.back().atot = utils::Date::isoStringToTimestamp(pilot["vacdm"]["atot"].get<std::string>());
+        pilots.back().asrt = utils::Date::isoStringToTimestamp(pilot["vacdm"]["asrt"].get<std::string>());
+        pilots.back().aort = utils::Date::isoStringToTimestamp(pilot["vacdm"]["aort"].get<std::string>());
+
+        for (const auto &measureObject : pilot["measures"]) {
+            types::EcfmpMeasure measure;
+            measure.ident = measureObject["ident"].get<std::string>();
+            measure.value = measureObject["value"].get<int>();
+            pilots.back().measures.push_back(measure);
+        }
+        pilots.back().hasBooking = pilot["hasBooking"].get<bool>();
+    }
+
+    return pilots;
+}
+
+/// @brief creates a pilot of the backend schema, the times are set relative to the current time
+nlohmann::json backendPilot(const std::string &callsign, int index) {
+    // the same pilot is created several times by the tests, all times refer to the start of the tests
+    static const auto now = std::chrono::floor<std::chrono::milliseconds>(std::chrono::system_clock::now());
+    const auto time = [index](std::chrono::minutes offset) {
+        return utils::Date::timestampToIsoString(now + offset + std::chrono::milliseconds(index * 37));
+    };
+
+    return {
+        {"callsign", callsign},
+        {"updatedAt", time(-1min)},
+        {"inactive", 0 == index % 7},
+        {"position", {{"lat", 48.35 + index * 0.001}, {"lon", 11.78 - index * 0.002}}},
+        {"vacdm",
+         {{"taxizoneIsTaxiout", 0 == index % 2},
+          {"eobt", time(10min)},
+          {"tobt", time(12min)},
+          {"tobt_state", 0 == index % 3 ? "CONFIRMED" : "GUESS"},
+          {"ctot", DEFAULT_TIMESTAMP},
+          {"ttot", time(30min)},
+          {"tsat", time(15min)},
+          {"exot", 10 + index % 5},
+          {"asat", DEFAULT_TIMESTAMP},
+          {"aobt", DEFAULT_TIMESTAMP},
+          {"atot", DEFAULT_TIMESTAMP},
+          {"asrt", time(5min)},
+          {"aort", DEFAULT_TIMESTAMP}}},
+        {"flightplan", {{"departure", "EDDM"}, {"arrival", 0 == index % 2 ? "EDDF" : "LFPG"}}},
+        {"clearance", {{"dep_rwy", "26R"}, {"sid", "KIRDI4S"}}},
+        {"measures", 0 == index % 4 ? nlohmann::json::array({{{"ident", "EDDF-MDI"}, {"value", 120 + index}}})
+                                    : nlohmann::json::array()},
+        {"hasBooking", 0 == index % 5},
+    };
+}
+
+void expectSamePilot(const types::Pilot &expected, const types::Pilot &actual) {
+    SCOPED_TRACE(std::string(expected.callsign));
+
+    EXPECT_EQ(expected.callsign, actual.callsign);
+    EXPECT_EQ(expected.lastUpdate, actual.lastUpdate);
+    EXPECT_EQ(expected.inactive, actual.inactive);
+    EXPECT_DOUBLE_EQ(expected.latitude, actual.latitude);
+    EXPECT_DOUBLE_EQ(expected.longitude, actual.longitude);
+    EXPECT_EQ(expected.taxizoneIsTaxiout, actual.taxizoneIsTaxiout);
+    EXPECT_EQ(expected.origin, actual.origin);
+    EXPECT_EQ(expected.destination, actual.destination);
+    EXPECT_EQ(expected.runway, actual.runway);
+    EXPECT_EQ(expected.sid, actual.sid);
+    EXPECT_EQ(expected.eobt, actual.eobt);
+    EXPECT_EQ(expected.tobt, actual.tobt);
+    EXPECT_EQ(expected.tobt_state, actual.tobt_state);
+    EXPECT_EQ(expected.ctot, actual.ctot);
+    EXPECT_EQ(expected.ttot, actual.ttot);
+    EXPECT_EQ(expected.tsat, actual.tsat);
+    EXPECT_EQ(expected.exot, actual.exot);
+    EXPECT_EQ(expected.asat, actual.asat);
+    EXPECT_EQ(expected.aobt, actual.aobt);
+    EXPECT_EQ(expected.atot, actual.atot);
+    EXPECT_EQ(expected.asrt, actual.asrt);
+    EXPECT_EQ(expected.aort, actual.aort);
+    EXPECT_EQ(expected.hasBooking, actual.hasBooking);
+
+    ASSERT_EQ(expected.measures.size(), actual.measures.size());
+    for (std::size_t i = 0; i < expected.measures.size(); ++i) {
+        EXPECT_EQ(expected.measures[i].ident, actual.measures[i].ident);
+        EXPECT_EQ(expected.measures[i].value, actual.measures[i].value);
+    }
+}
+
+void expectSamePilots(const std::list<types::Pilot> &expected, const std::list<types::Pilot> &actual) {
+    ASSERT_EQ(expected.size(), actual.size());
+    for (auto lhs = expected.begin(), rhs = actual.begin(); expected.end() != lhs; ++lhs, ++rhs)
+        expectSamePilot(*lhs, *rhs);
+}
+}  // namespace
+
+TEST(PilotDecoderTest, MatchesDocumentDecode) {
+    nlohmann::json response = nlohmann::json::array();
+    for (int i = 0; i < 50; ++i) response.push_back(backendPilot("DLH" + std::to_string(i), i));
+    const auto body = response.dump();
+
+    com::PilotDecoder decoder;
+    ASSERT_TRUE(decoder.decode(body));
+    EXPECT_EQ(0u, decoder.skippedPilots());
+    expectSamePilots(decodeWithDocument(body), decoder.pilots());
+}
+
+TEST(PilotDecoderTest, MatchesDocumentDecodeWithUnknownFields) {
+    nlohmann::json response = nlohmann::json::array();
+    for (int i = 0; i < 10; ++i) {
+        auto pilot = backendPilot("AFR" + std::to_string(i), i);
+        // fields of newer backends, some of them reuse the names of the known fields in other objects
+        pilot["vacdm"]["blockAssignment"] = {{"tobt", "2024-01-01T10:00:00.000Z"}, {"lat", 1}};
+        pilot["history"] = nlohmann::json::array({{{"callsign", "OLD"}, {"inactive", true}}});
+        pilot["position"]["heading"] = 270;
+        pilot["notes"] = nullptr;
+        response.push_back(pilot);
+    }
+    const auto body = response.dump();
+
+    com::PilotDecoder decoder;
+    ASSERT_TRUE(decoder.decode(body));
+    EXPECT_EQ(0u, decoder.skippedPilots());
+    expectSamePilots(decodeWithDocument(body), decoder.pilots());
+}
+
+TEST(PilotDecoderTest, MatchesDocumentDecodeInAnyKeyOrder) {
+    // nlohmann::ordered_json keeps the insertion order, the objects start with the nested values
+    nlohmann::ordered_json pilot;
+    const auto reference = backendPilot("BAW1", 3);
+    for (const auto &key : {"measures", "vacdm", "clearance", "flightplan", "position", "hasBooking", "inactive",
+                            "updatedAt", "callsign"})
+        pilot[key] = reference[key];
+    const auto body = nlohmann::ordered_json::array({pilot}).dump();
+
+    com::PilotDecoder decoder;
+    ASSERT_TRUE(decoder.decode(body));
+    expectSamePilots(decodeWithDocument(body), decoder.pilots());
+}
+
+TEST(PilotDecoderTest, DropsOnlyMalformedPilots) {
+    auto malformed = backendPilot("BAD1", 1);
+    malformed["position"]["lat"] = "48.35";
+    auto withoutCallsign = backendPilot("", 2);
+    withoutCallsign.erase("callsign");
+
+    const auto body =
+        nlohmann::json::array({backendPilot("DLH1", 0), malformed, withoutCallsign, backendPilot("DLH2", 3)}).dump();
+
+    com::PilotDecoder decoder;
+    ASSERT_TRUE(decoder.decode(body));
+    EXPECT_EQ(2u, decoder.skippedPilots());
+
+    const auto expected =
+        decodeWithDocument(nlohmann::json::array({backendPilot("DLH1", 0), backendPilot("DLH2", 3)}).dump());
+    expectSamePilots(expected, decoder.pilots());
+}
+
+TEST(PilotDecoderTest, DropsPilotsWithTooLongStrings) {
+    // the strings are stored inline, longer values are rejected instead of being truncated
+    const auto longCallsign = backendPilot(std::string(types::Callsign::maxSize + 1, 'D'), 1);
+    auto longAirport = backendPilot("BAD1", 2);
+    longAirport["flightplan"]["departure"] = "EDDMEDDM";
+    auto longSid = backendPilot("BAD2", 3);
+    longSid["clearance"]["sid"] = std::string(types::ProcedureName::maxSize + 1, 'S');
+
+    const auto body = nlohmann::json::array(
+                          {backendPilot("DLH1", 0), longCallsign, longAirport, longSid, backendPilot("DLH2", 4)})
+                          .dump();
+
+    com::PilotDecoder decoder;
+    ASSERT_TRUE(decoder.decode(body));
+    EXPECT_EQ(3u, decoder.skippedPilots());
+
+    const auto expected =
+        decodeWithDocument(nlohmann::json::array({backendPilot("DLH1", 0), backendPilot("DLH2", 4)}).dump());
+    expectSamePilots(expected, decoder.pilots());
+}
+
+TEST(PilotDecoderTest, KeepsCompletePilotsOfTruncatedResponse) {
+    const auto complete = nlohmann::json::array({backendPilot("DLH1", 0), backendPilot("DLH2", 1)}).dump();
+    const auto truncated = complete.substr(0, complete.size() - 40);
+
+    com::PilotDecoder decoder;
+    EXPECT_FALSE(decoder.decode(truncated));
+    EXPECT_FALSE(decoder.errorMessage().empty());
+    EXPECT_EQ(1u, decoder.skippedPilots());
+
+    expectSamePilots(decodeWithDocument(nlohmann::json::array({backendPilot("DLH1", 0)}).dump()), decoder.pilots());
+}
+
+TEST(PilotDecoderTest, IgnoresResponsesWhichAreNoList) {
+    com::PilotDecoder decoder;
+    EXPECT_TRUE(decoder.decode(R"({"error":"unauthorized","callsign":"DLH1"})"));
+    EXPECT_TRUE(decoder.pilots().empty());
+    EXPECT_EQ(0u, decoder.skippedPilots());
+}
@@ -0,0 +1,140 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <list>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include "Backend.h"
+#include "core/PilotEventStream.h"
+
+using namespace std::chrono_literals;
+
+namespace vacdm::com {
+class PilotEventStreamTest : public ::testing::Test {
+   protected:
+    PilotEventStreamTest() : m_stream(nullptr) {}
+
+    void processEvents(std::string &buffer) { m_stream.processEvents(buffer); }
+
+    static std::unique_ptr<mock::Backend> startBackend(int port) {
+        mock::Options options;
+        options.port = port;
+        options.airports = {"EDDM"};
+        options.pilotsPerAirport = 3;
+        // the pilots only change by the tests
+        options.eventInterval = 0ms;
+
+        auto backend = std::make_unique<mock::Backend>(options);
+        if (-1 == backend->start()) return nullptr;
+        return backend;
+    }
+
+    /// @brief waits until the condition is met or the timeout expires
+    template <typename Condition>
+    static bool eventually(Condition condition, std::chrono::milliseconds timeout) {
+        const auto end = std::chrono::steady_clock::now() + timeout;
+        while (false == condition()) {
+            if (std::chrono::steady_clock::now() > end) return false;
+            std::this_thread::sleep_for(20ms);
+        }
+        return true;
+    }
+
+    /// @brief changes the pilot in the backend and waits until its event is received
+    bool receivesChangeOf(mock::Backend &backend, const std::string &callsign) {
+        if (false == backend.store().patchPilot(callsign, {{"vacdm", {{"tobt", "2024-01-01T10:00:00.000Z"}}}})
+                         .has_value())
+            return false;
+
+        std::list<types::Pilot> pilots;
+        const bool received = eventually(
+            [this, &pilots]() {
+                pilots.splice(pilots.end(), m_stream.takePilots());
+                return false == pilots.empty();
+            },
+            2s);
+        return true == received && callsign == std::string(pilots.front().callsign);
+    }
+
+    PilotEventStream m_stream;
+};
+
+TEST_F(PilotEventStreamTest, ParsesPilotAndDeleteEvents) {
+    std::string buffer =
+        ": keep-alive\n\n"
+        "event: pilot\n"
+        "data: {\"callsign\":\"DLH1\",\"flightplan\":{\"departure\":\"EDDM\"}}\n\n"
+        "event: delete\r\n"
+        "data: {\"callsign\":\"AFR1\"}\r\n\r\n";
+    this->processEvents(buffer);
+
+    EXPECT_TRUE(buffer.empty());
+    const auto pilots = m_stream.takePilots();
+    ASSERT_EQ(2u, pilots.size());
+    // the changes are ordered by the callsign
+    EXPECT_EQ("AFR1", std::string(pilots.front().callsign));
+    EXPECT_TRUE(pilots.front().inactive);
+    EXPECT_EQ("DLH1", std::string(pilots.back().callsign));
+    EXPECT_FALSE(pilots.back().inactive);
+    EXPECT_EQ("EDDM", std::string(pilots.back().origin));
+
+    EXPECT_TRUE(m_stream.takePilots().empty());
+}
+
+TEST_F(PilotEventStreamTest, KeepsIncompleteEventInBuffer) {
+    std::string buffer = "event: delete\ndata: {\"callsign\":";
+    this->processEvents(buffer);
+    EXPECT_TRUE(m_stream.takePilots().empty());
+
+    buffer += "\"DLH1\"}\n\n";
+    this->processEvents(buffer);
+    EXPECT_TRUE(buffer.empty());
+    ASSERT_EQ(1u, m_stream.takePilots().size());
+}
+
+TEST_F(PilotEventStreamTest, KeepsLatestChangeOfPilot) {
+    std::string buffer =
+        "event: pilot\ndata: {\"callsign\":\"DLH1\",\"flightplan\":{\"departure\":\"EDDM\"}}\n\n"
+        "event: delete\ndata: {\"callsign\":\"DLH1\"}\n\n"
+        "event: unknown\ndata: {}\n\n";
+    this->processEvents(buffer);
+
+    const auto pilots = m_stream.takePilots();
+    ASSERT_EQ(1u, pilots.size());
+    EXPECT_TRUE(pilots.front().inactive);
+}
+
+TEST_F(PilotEventStreamTest, ReceivesChangesOfBackend) {
+    auto backend = startBackend(0);
+    ASSERT_NE(nullptr, backend);
+    const auto callsign = backend->store().pilots({"EDDM"}, "").front()["callsign"].get<std::string>();
+
+    m_stream.subscribe("http://127.0.0.1:" + std::to_string(backend->port()), "", {"EDDM"});
+    ASSERT_TRUE(eventually([this]() { return m_stream.connected(); }, 2s));
+
+    EXPECT_TRUE(this->receivesChangeOf(*backend, callsign));
+}
+
+TEST_F(PilotEventStreamTest, ReconnectsAfterBackendClosedStream) {
+    auto backend = startBackend(0);
+    ASSERT_NE(nullptr, backend);
+    const int port = backend->port();
+
+    m_stream.subscribe("http://127.0.0.1:" + std::to_string(port), "", {"EDDM"});
+    ASSERT_TRUE(eventually([this]() { return m_stream.connected(); }, 2s));
+
+    // the backend restarts on the same address, the pilots are polled until the stream is open again
+    backend.reset();
+    ASSERT_TRUE(eventually([this]() { return false == m_stream.connected(); }, 2s));
+
+    backend = startBackend(port);
+    ASSERT_NE(nullptr, backend);
+    const auto callsign = backend->store().pilots({"EDDM"}, "").front()["callsign"].get<std::string>();
+
+    ASSERT_TRUE(eventually([this]() { return m_stream.connected(); },
+                           std::chrono::duration_cast<std::chrono::milliseconds>(eventStreamReconnectDelay) + 3s));
+    EXPECT_TRUE(this->receivesChangeOf(*backend, callsign));
+}
+}  // namespace vacdm::com
@@ -0,0 +1,127 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "core/PilotSnapshotStore.h"
+
+using namespace vacdm;
+using vacdm::core::PilotRecord;
+using vacdm::core::PilotSnapshotStore;
+
+namespace {
+std::shared_ptr<const PilotRecord> record(const std::string &callsign) {
+    PilotRecord record;
+    for (auto &pilot : record) EXPECT_TRUE(pilot.callsign.assign(callsign));
+    return PilotSnapshotStore::makeRecord(std::move(record));
+}
+
+/// @brief publishes a snapshot with the pilots
+void insert(PilotSnapshotStore &store, const std::vector<std::string> &callsigns) {
+    store.update([&callsigns](PilotSnapshotStore::Pilots &pilots) {
+        for (const auto &callsign : callsigns) pilots.emplace(callsign, record(callsign));
+    });
+}
+}  // namespace
+
+TEST(PilotSnapshotStoreTest, PublishedSnapshotIsNotChangedByTransaction) {
+    PilotSnapshotStore store;
+    insert(store, {"AFR1", "DLH1"});
+    const auto before = store.snapshot();
+
+    store.update([](PilotSnapshotStore::Pilots &pilots) {
+        PilotSnapshotStore::modify(pilots.at("DLH1"))[0].origin = "EDDM";
+        pilots.erase("AFR1");
+        pilots.emplace("BAW1", record("BAW1"));
+    });
+    const auto after = store.snapshot();
+
+    ASSERT_EQ(2u, before->pilots.size());
+    EXPECT_TRUE(before->pilots.at("DLH1")->at(0).origin.empty());
+    EXPECT_EQ(1u, before->pilots.count("AFR1"));
+    EXPECT_EQ(0u, before->pilots.count("BAW1"));
+
+    ASSERT_EQ(2u, after->pilots.size());
+    EXPECT_EQ("EDDM", after->pilots.at("DLH1")->at(0).origin);
+    EXPECT_EQ(before->version + 1, after->version);
+}
+
+TEST(PilotSnapshotStoreTest, UnchangedRecordsAreShared) {
+    PilotSnapshotStore store;
+    insert(store, {"AFR1", "DLH1"});
+    const auto before = store.snapshot();
+
+    store.update([](PilotSnapshotStore::Pilots &pilots) {
+        PilotSnapshotStore::modify(pilots.at("DLH1"))[1].runway = "26R";
+    });
+    const auto after = store.snapshot();
+
+    EXPECT_EQ(before->pilots.at("AFR1"), after->pilots.at("AFR1"));
+    EXPECT_NE(before->pilots.at("DLH1"), after->pilots.at("DLH1"));
+}
+
+TEST(PilotSnapshotStoreTest, RecordIsCopiedOncePerTransaction) {
+    PilotSnapshotStore store;
+    insert(store, {"DLH1"});
+    const auto before = store.snapshot();
+
+    store.update([&before](PilotSnapshotStore::Pilots &pilots) {
+        auto &first = PilotSnapshotStore::modify(pilots.at("DLH1"));
+        EXPECT_NE(&before->pilots.at("DLH1")->at(0), &first[0]);
+
+        // the copy is only referenced by the working copy and is changed in place
+        auto &second = PilotSnapshotStore::modify(pilots.at("DLH1"));
+        EXPECT_EQ(&first, &second);
+    });
+}
+
+TEST(PilotSnapshotStoreTest, ClearPublishesEmptySnapshot) {
+    PilotSnapshotStore store;
+    EXPECT_EQ(0u, store.snapshot()->version);
+    insert(store, {"AFR1", "DLH1"});
+    const auto before = store.snapshot();
+
+    store.clear();
+
+    EXPECT_TRUE(store.snapshot()->pilots.empty());
+    EXPECT_EQ(before->version + 1, store.snapshot()->version);
+    EXPECT_EQ(2u, before->pilots.size());
+}
+
+TEST(PilotSnapshotStoreTest, ReadersSeeCompleteTransactions) {
+    PilotSnapshotStore store;
+    insert(store, {"AFR1", "BAW1", "DLH1", "KLM1"});
+
+    // every transaction writes its version into all records, a reader sees the records of a single transaction
+    std::atomic<bool> done = false;
+    std::atomic<int> inconsistent = 0;
+    std::vector<std::thread> readers;
+    for (int reader = 0; reader < 4; ++reader) {
+        readers.emplace_back([&store, &done, &inconsistent]() {
+            while (false == done) {
+                const auto snapshot = store.snapshot();
+                const double expected = snapshot->pilots.begin()->second->at(0).latitude;
+                for (const auto &[callsign, record] : snapshot->pilots) {
+                    for (const auto &pilot : *record) {
+                        if (expected != pilot.latitude) ++inconsistent;
+                    }
+                }
+            }
+        });
+    }
+
+    for (int transaction = 1; transaction <= 2000; ++transaction) {
+        store.update([transaction](PilotSnapshotStore::Pilots &pilots) {
+            for (auto &[callsign, record] : pilots) {
+                for (auto &pilot : PilotSnapshotStore::modify(record)) pilot.latitude = transaction;
+            }
+        });
+    }
+    done = true;
+    for (auto &reader : readers) reader.join();
+
+    EXPECT_EQ(0, inconsistent);
+    EXPECT_EQ(2000.0, store.snapshot()->pilots.at("KLM1")->at(2).latitude);
+}
@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "types/Pilot.h"
+
+using namespace std::chrono_literals;
+using namespace vacdm;
+using vacdm::types::CompactTime;
+
+namespace {
+/// @brief returns the time point of the UTC date and time
+std::chrono::system_clock::time_point utc(int year, unsigned int month, unsigned int day,
+                                          std::chrono::milliseconds time = 0ms) {
+    return std::chrono::sys_days(std::chrono::year(year) / std::chrono::month(month) / std::chrono::day(day)) + time;
+}
+}  // namespace
+
+TEST(PilotTest, InlineStringKeepsShortValues) {
+    types::Callsign callsign("DLH123");
+    EXPECT_EQ("DLH123", callsign);
+    EXPECT_EQ(6u, callsign.size());
+    EXPECT_FALSE(callsign.empty());
+    EXPECT_EQ(std::string("DLH123"), callsign.str());
+    EXPECT_EQ("/api/v1/pilots/DLH123", "/api/v1/pilots/" + callsign);
+
+    callsign = "BAW1";
+    EXPECT_EQ("BAW1", callsign);
+    EXPECT_EQ(types::Callsign("BAW1"), callsign);
+    EXPECT_FALSE(types::Callsign("BAW12") == callsign);
+
+    EXPECT_TRUE(callsign.assign(std::string(types::Callsign::maxSize, 'D')));
+    EXPECT_EQ(std::string(types::Callsign::maxSize, 'D'), callsign);
+
+    EXPECT_TRUE(types::Callsign().empty());
+    EXPECT_EQ("", types::Callsign());
+}
+
+TEST(PilotTest, InlineStringRejectsLongValues) {
+    types::Callsign callsign("DLH123");
+    EXPECT_FALSE(callsign.assign(std::string(types::Callsign::maxSize + 1, 'D')));
+    EXPECT_FALSE(callsign.assign(std::string("DLH\0" "123", 7)));
+    // the rejected values do not change the string
+    EXPECT_EQ("DLH123", callsign);
+
+    // a shorter value replaces all characters of the longer one
+    types::ShortCode code("EDDM");
+    EXPECT_FALSE(code.assign("EDDMXXXX"));
+    EXPECT_TRUE(code.assign("EGL"));
+    EXPECT_EQ("EGL", code);
+    EXPECT_EQ(types::ShortCode("EGL"), code);
+}
+
+TEST(PilotTest, CompactTimeKeepsMilliseconds) {
+    const auto time = utc(2024, 1, 1, 10h + 5min + 7s + 123ms);
+    EXPECT_EQ(time, CompactTime(time).timePoint());
+    EXPECT_EQ(time, CompactTime(time));
+    EXPECT_NE(CompactTime(time), CompactTime(time + 1ms));
+    EXPECT_LT(CompactTime(time), CompactTime(time + 1ms));
+    EXPECT_LT(CompactTime(time), time + 1ms);
+    EXPECT_EQ(10min, CompactTime(time + 10min) - CompactTime(time));
+    EXPECT_EQ(time + 10min, CompactTime(time) + 10min);
+
+    // the fraction below the millisecond is floored like in the ISO timestamps
+    EXPECT_EQ(time, CompactTime(time + 999us).timePoint());
+}
+
+TEST(PilotTest, CompactTimeKeepsDefaultTimeApartFromEpoch) {
+    EXPECT_EQ(types::defaultTime, CompactTime().timePoint());
+    EXPECT_EQ(types::defaultTime, CompactTime(types::defaultTime).timePoint());
+
+    const std::chrono::system_clock::time_point epoch;
+    EXPECT_EQ(epoch, CompactTime(epoch).timePoint());
+    EXPECT_NE(CompactTime(), CompactTime(epoch));
+    EXPECT_LT(CompactTime(), CompactTime(epoch));
+}
+
+TEST(PilotTest, CompactTimeKeepsTimesOfTheClockRange) {
+    const std::vector<std::chrono::system_clock::time_point> times = {
+        utc(1969, 12, 31, 24h - 1ms), utc(1900, 1, 1, 1ms), utc(2106, 2, 7, 7h), utc(2200, 1, 1, 999ms),
+        std::chrono::floor<std::chrono::milliseconds>(std::chrono::system_clock::time_point::max()),
+        std::chrono::ceil<std::chrono::milliseconds>(std::chrono::system_clock::time_point::min()),
+    };
+    for (const auto &time : times) EXPECT_EQ(time, CompactTime(time).timePoint());
+    EXPECT_LT(CompactTime(utc(1900, 1, 1)), CompactTime(utc(2200, 1, 1)));
+}
+
+TEST(PilotTest, PilotIsCompact) {
+    types::Pilot pilot;
+    EXPECT_TRUE(pilot.callsign.empty());
+    EXPECT_EQ(types::defaultTime, pilot.tobt.timePoint());
+    EXPECT_EQ(std::chrono::system_clock::time_point(), pilot.lastUpdate.timePoint());
+
+    EXPECT_EQ(6u, sizeof(CompactTime));
+    EXPECT_EQ(16u, sizeof(types::Callsign));
+    EXPECT_LE(sizeof(types::Pilot), 200u);
+}
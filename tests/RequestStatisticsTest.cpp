@@ -0,0 +1,140 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <thread>
+#include <vector>
+
+#include "core/RequestStatistics.h"
+
+using namespace std::chrono_literals;
+using vacdm::com::LatencyHistogram;
+using vacdm::com::RequestStatistics;
+
+namespace {
+constexpr std::uint64_t lastExponentStart = std::uint64_t(1) << LatencyHistogram::maxExponent;
+
+/// @brief first duration of the bucket
+std::uint64_t bucketStart(std::size_t bucket) { return 0 == bucket ? 0 : LatencyHistogram::bucketLimit(bucket - 1); }
+}  // namespace
+
+TEST(LatencyHistogramTest, ShortDurationsHaveBucketOfTheirOwn) {
+    for (std::uint64_t microseconds = 0; microseconds < LatencyHistogram::subBuckets; ++microseconds) {
+        EXPECT_EQ(microseconds, LatencyHistogram::bucketOf(microseconds));
+        EXPECT_EQ(microseconds + 1, LatencyHistogram::bucketLimit(microseconds));
+    }
+    // the first shared bucket follows without a gap
+    EXPECT_EQ(LatencyHistogram::subBuckets, LatencyHistogram::bucketOf(LatencyHistogram::subBuckets));
+}
+
+TEST(LatencyHistogramTest, BucketsAreContiguous) {
+    for (std::size_t bucket = 1; bucket < LatencyHistogram::bucketCount; ++bucket) {
+        const auto start = bucketStart(bucket);
+        ASSERT_LT(start, LatencyHistogram::bucketLimit(bucket)) << "bucket " << bucket;
+        ASSERT_EQ(bucket, LatencyHistogram::bucketOf(start)) << "bucket " << bucket;
+        ASSERT_EQ(bucket - 1, LatencyHistogram::bucketOf(start - 1)) << "bucket " << bucket;
+    }
+}
+
+TEST(LatencyHistogramTest, BucketsAreAccurateToOneEighth) {
+    for (std::size_t bucket = LatencyHistogram::subBuckets; bucket < LatencyHistogram::bucketCount - 1; ++bucket) {
+        const auto width = LatencyHistogram::bucketLimit(bucket) - bucketStart(bucket);
+        ASSERT_LE(width * LatencyHistogram::subBuckets, bucketStart(bucket)) << "bucket " << bucket;
+    }
+}
+
+TEST(LatencyHistogramTest, LastExponentIsDistinguished) {
+    const auto first = LatencyHistogram::bucketOf(lastExponentStart);
+    EXPECT_EQ(LatencyHistogram::bucketCount - LatencyHistogram::subBuckets, first);
+    EXPECT_EQ(lastExponentStart, bucketStart(first));
+    EXPECT_EQ(lastExponentStart + (lastExponentStart >> LatencyHistogram::subBucketBits),
+              LatencyHistogram::bucketLimit(first));
+    EXPECT_EQ(first - 1, LatencyHistogram::bucketOf(lastExponentStart - 1));
+}
+
+TEST(LatencyHistogramTest, LongerDurationsShareLastBucket) {
+    const auto last = LatencyHistogram::bucketCount - 1;
+
+    EXPECT_EQ(last, LatencyHistogram::bucketOf(2 * lastExponentStart - 1));
+    EXPECT_EQ(last, LatencyHistogram::bucketOf(2 * lastExponentStart));
+    EXPECT_EQ(last, LatencyHistogram::bucketOf(std::numeric_limits<std::uint64_t>::max()));
+    EXPECT_EQ(std::numeric_limits<std::uint64_t>::max(), LatencyHistogram::bucketLimit(last));
+}
+
+TEST(LatencyHistogramTest, PercentilesAreUpperBoundsOfBuckets) {
+    LatencyHistogram histogram;
+    for (int i = 1; i <= 100; ++i) histogram.record(std::chrono::microseconds(i * 1000));
+
+    const auto snapshot = histogram.snapshot();
+    EXPECT_EQ(100u, snapshot.count);
+    EXPECT_EQ(100ms, snapshot.max);
+    EXPECT_EQ(50500us, snapshot.mean());
+
+    const auto median = snapshot.percentile(50);
+    EXPECT_GE(median, 50ms);
+    EXPECT_LE(median, 56250us);
+    // the percentiles do not exceed the longest duration
+    EXPECT_EQ(100ms, snapshot.percentile(100));
+    EXPECT_LE(snapshot.percentile(0), 1125us);
+}
+
+TEST(LatencyHistogramTest, PercentileOfLastBucketIsMaximum) {
+    LatencyHistogram histogram;
+    histogram.record(std::chrono::minutes(10));
+    histogram.record(-1ms);
+
+    const auto snapshot = histogram.snapshot();
+    EXPECT_EQ(std::chrono::minutes(10), snapshot.percentile(100));
+    // negative durations are recorded as zero
+    EXPECT_EQ(1u, snapshot.buckets[0]);
+    EXPECT_EQ(0us, snapshot.percentile(50));
+}
+
+TEST(LatencyHistogramTest, ConcurrentRecordingsAreCounted) {
+    LatencyHistogram histogram;
+
+    std::vector<std::thread> threads;
+    for (int thread = 0; thread < 4; ++thread) {
+        threads.emplace_back([&histogram, thread]() {
+            for (int i = 0; i < 10000; ++i) histogram.record(std::chrono::microseconds(thread * 10000 + i));
+        });
+    }
+    for (auto &thread : threads) thread.join();
+
+    const auto snapshot = histogram.snapshot();
+    EXPECT_EQ(40000u, snapshot.count);
+    EXPECT_EQ(39999us, snapshot.max);
+    EXPECT_EQ(std::chrono::microseconds(std::uint64_t(39999) * 40000 / 2), snapshot.total);
+}
+
+TEST(RequestStatisticsTest, CountsErrorStatusesAndFailures) {
+    RequestStatistics statistics;
+    statistics.record(2ms, 200, 100, 1000);
+    statistics.record(3ms, 304, 100, 0);
+    statistics.record(4ms, 404, 100, 50);
+    statistics.record(5ms, 503, 100, 50);
+    statistics.record(6ms, 503, 100, 50);
+    statistics.recordFailure(5s, 100);
+
+    const auto snapshot = statistics.snapshot();
+    EXPECT_EQ(6u, snapshot.requests);
+    EXPECT_EQ(1u, snapshot.failures);
+    EXPECT_EQ((std::map<int, std::uint64_t>{{404, 1}, {503, 2}}), snapshot.errorStatuses);
+    EXPECT_EQ(600u, snapshot.bytesSent);
+    EXPECT_EQ(1150u, snapshot.bytesReceived);
+    // the failed request is part of the latencies
+    EXPECT_EQ(5s, snapshot.latency.max);
+}
+
+TEST(RequestStatisticsTest, IgnoresStatusesOutsideErrorRange) {
+    RequestStatistics statistics;
+    statistics.record(1ms, RequestStatistics::minErrorStatus - 1, 0, 0);
+    statistics.record(1ms, RequestStatistics::maxErrorStatus + 1, 0, 0);
+    statistics.record(1ms, -1, 0, 0);
+
+    const auto snapshot = statistics.snapshot();
+    EXPECT_EQ(3u, snapshot.requests);
+    EXPECT_TRUE(snapshot.errorStatuses.empty());
+}
@@ -0,0 +1,258 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <list>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include "Backend.h"
+#include "core/Server.h"
+
+using namespace std::chrono_literals;
+
+namespace vacdm::com {
+/// @brief runs the requests of the plugin against the mock backend in the test process
+class ServerBackendTest : public ::testing::Test {
+   protected:
+    ServerBackendTest() : ServerBackendTest(ServerBackendTest::backendOptions()) {}
+    explicit ServerBackendTest(const mock::Options &options) : m_backend(options), m_server(nullptr) {}
+
+    void SetUp() override {
+        const int port = m_backend.start();
+        ASSERT_NE(-1, port);
+
+        m_server.changeServerAddress("http://127.0.0.1:" + std::to_string(port));
+        ASSERT_TRUE(m_server.checkWebApi());
+        m_server.setMaster(true);
+    }
+
+    static mock::Options backendOptions() {
+        mock::Options options;
+        options.port = 0;
+        options.airports = {"EDDM", "EDDF"};
+        options.pilotsPerAirport = 5;
+        // the pilots only change by the tests
+        options.eventInterval = 0ms;
+        return options;
+    }
+
+    /// @brief returns the answered requests with the method to the path
+    std::vector<mock::ReceivedRequest> requests(const std::string &method, const std::string &path) {
+        std::vector<mock::ReceivedRequest> requests;
+        for (const auto &request : m_backend.requests()) {
+            if (method == request.method && path == request.path) requests.push_back(request);
+        }
+        return requests;
+    }
+
+    std::vector<int> statuses(const std::string &method, const std::string &path) {
+        std::vector<int> statuses;
+        for (const auto &request : this->requests(method, path)) statuses.push_back(request.status);
+        return statuses;
+    }
+
+    /// @brief returns the patches which set the TOBT of the first pilots of the airport
+    std::vector<nlohmann::json> tobtPatches(const std::string &airport, std::size_t count) {
+        std::vector<nlohmann::json> patches;
+        for (const auto &pilot : m_backend.store().pilots({airport}, "")) {
+            if (count == patches.size()) break;
+            patches.push_back({{"callsign", pilot["callsign"]}, {"vacdm", {{"tobt", "2024-01-01T10:00:00.000Z"}}}});
+        }
+        return patches;
+    }
+
+    types::Pilot pilot(const std::string &callsign) const {
+        types::Pilot pilot;
+        EXPECT_TRUE(pilot.callsign.assign(callsign));
+        pilot.origin = "EDDM";
+        pilot.destination = "EDDF";
+        pilot.eobt = std::chrono::floor<std::chrono::seconds>(std::chrono::system_clock::now()) + 10min;
+        pilot.tobt = pilot.eobt;
+        return pilot;
+    }
+
+    mock::Backend m_backend;
+    Server m_server;
+};
+
+TEST_F(ServerBackendTest, UnchangedPilotsAreNotSentAgain) {
+    const auto first = m_server.getPilots({"EDDM"});
+    const auto second = m_server.getPilots({"EDDM"});
+
+    ASSERT_EQ(5u, first.size());
+    ASSERT_EQ(first.size(), second.size());
+    EXPECT_EQ(first.front().callsign, second.front().callsign);
+    // the second request carries the tag of the first response
+    EXPECT_EQ((std::vector<int>{200, 304}), this->statuses("GET", "/api/v1/pilots"));
+}
+
+TEST_F(ServerBackendTest, ChangedPilotsAreSentAgain) {
+    const auto first = m_server.getPilots({"EDDM"});
+    ASSERT_EQ(5u, first.size());
+
+    ASSERT_TRUE(m_backend.store().deletePilot(std::string(first.front().callsign)));
+    const auto second = m_server.getPilots({"EDDM"});
+
+    EXPECT_EQ(4u, second.size());
+    EXPECT_EQ((std::vector<int>{200, 200}), this->statuses("GET", "/api/v1/pilots"));
+}
+
+TEST_F(ServerBackendTest, AirportsAreRequestedAtOnceIfSupported) {
+    ASSERT_TRUE(m_server.getServerConfig().multiAirportPilots);
+
+    const auto first = m_server.getPilots({"EDDF", "EDDM"});
+    ASSERT_EQ(10u, first.size());
+    // the pilots are returned in the order of the airports
+    EXPECT_EQ("EDDF", std::string(first.front().origin));
+    EXPECT_EQ("EDDM", std::string(first.back().origin));
+
+    const auto second = m_server.getPilots({"EDDF", "EDDM"});
+    EXPECT_EQ(10u, second.size());
+
+    const auto pilotRequests = this->requests("GET", "/api/v1/pilots");
+    EXPECT_EQ(2u, pilotRequests.size());
+    EXPECT_EQ((std::vector<int>{200, 304}), this->statuses("GET", "/api/v1/pilots"));
+}
+
+TEST_F(ServerBackendTest, AirportsAreRequestedSeparatelyWithoutConfiguration) {
+    const auto pilots = m_server.getPilots({"EDDF", "EDDM"});
+
+    EXPECT_EQ(10u, pilots.size());
+    EXPECT_EQ(2u, this->requests("GET", "/api/v1/pilots").size());
+}
+
+TEST_F(ServerBackendTest, RequestsAreRecordedPerEndpointAndMethod) {
+    m_server.getPilots({"EDDM"});
+    m_server.postPilot(this->pilot("TEST1"));
+    // the backend does not know the pilot
+    m_server.sendDeleteMessage("/api/v1/pilots/UNKNOWN");
+
+    std::map<std::pair<std::string, Server::Endpoint>, RequestStatistics::Snapshot> statistics;
+    for (const auto &entry : m_server.requestStatistics())
+        statistics[{entry.method, entry.endpoint}] = entry.statistics;
+
+    // the version request of the handshake is recorded as well
+    ASSERT_EQ(4u, statistics.size());
+    EXPECT_EQ(1u, (statistics[{"GET", Server::Endpoint::Version}].requests));
+    EXPECT_EQ(1u, (statistics[{"GET", Server::Endpoint::Pilots}].requests));
+    EXPECT_LT(0u, (statistics[{"GET", Server::Endpoint::Pilots}].bytesReceived));
+
+    const auto post = statistics[{"POST", Server::Endpoint::Pilots}];
+    EXPECT_EQ(1u, post.requests);
+    EXPECT_LT(0u, post.bytesSent);
+    EXPECT_TRUE(post.errorStatuses.empty());
+
+    const auto deletion = statistics[{"DELETE", Server::Endpoint::Pilot}];
+    EXPECT_EQ((std::map<int, std::uint64_t>{{404, 1}}), deletion.errorStatuses);
+    EXPECT_EQ(0u, deletion.failures);
+}
+
+TEST_F(ServerBackendTest, CompressedResponsesAreDecompressed) {
+    m_server.setResponseCompression(true);
+
+    EXPECT_EQ(5u, m_server.getPilots({"EDDM"}).size());
+
+    const auto statistics =
+        m_server.compressionStatistics()[static_cast<std::size_t>(Server::Endpoint::Pilots)].responses;
+    EXPECT_EQ(1u, statistics.messages);
+    EXPECT_LT(statistics.compressedBytes, statistics.uncompressedBytes);
+}
+
+TEST_F(ServerBackendTest, CompressedRequestsAreDecodedByBackend) {
+    m_server.setRequestCompression(true, 0);
+
+    ASSERT_TRUE(m_server.postPilot(this->pilot("TEST1")));
+
+    const auto stored = m_backend.store().pilot("TEST1");
+    ASSERT_TRUE(stored.has_value());
+    EXPECT_EQ("EDDM", (*stored)["flightplan"]["departure"]);
+
+    const auto posts = this->requests("POST", "/api/v1/pilots");
+    ASSERT_EQ(1u, posts.size());
+    EXPECT_EQ("gzip", posts.front().contentEncoding);
+    EXPECT_EQ(201, posts.front().status);
+
+    const auto statistics =
+        m_server.compressionStatistics()[static_cast<std::size_t>(Server::Endpoint::Pilots)].requests;
+    EXPECT_EQ(1u, statistics.messages);
+}
+
+TEST_F(ServerBackendTest, SmallRequestsAreNotCompressed) {
+    m_server.setRequestCompression(true, 1024 * 1024);
+
+    ASSERT_TRUE(m_server.postPilot(this->pilot("TEST1")));
+
+    const auto posts = this->requests("POST", "/api/v1/pilots");
+    ASSERT_EQ(1u, posts.size());
+    EXPECT_TRUE(posts.front().contentEncoding.empty());
+    EXPECT_TRUE(m_backend.store().pilot("TEST1").has_value());
+}
+
+TEST_F(ServerBackendTest, PatchesAreSentInOneBulkRequest) {
+    m_server.setBatchRequests(true);
+
+    const auto patches = this->tobtPatches("EDDM", 3);
+    EXPECT_EQ((std::vector<bool>{true, true, true}), m_server.patchPilots(patches));
+
+    EXPECT_EQ((std::vector<int>{200}), this->statuses("PATCH", "/api/v1/pilots/bulk"));
+    const auto patched = m_backend.store().pilot(patches.back()["callsign"].get<std::string>());
+    ASSERT_TRUE(patched.has_value());
+    EXPECT_EQ("2024-01-01T10:00:00.000Z", (*patched)["vacdm"]["tobt"]);
+}
+
+TEST_F(ServerBackendTest, RejectedMessagesOfBatchAreNotSentAgain) {
+    m_server.setBatchRequests(true);
+
+    auto patches = this->tobtPatches("EDDM", 2);
+    patches.push_back({{"callsign", "UNKNOWN"}, {"vacdm", {{"tobt", "2024-01-01T10:00:00.000Z"}}}});
+    // the unknown pilot is rejected by the backend and dropped like a rejected single request
+    EXPECT_EQ((std::vector<bool>{true, true, true}), m_server.patchPilots(patches));
+
+    EXPECT_EQ((std::vector<int>{200}), this->statuses("PATCH", "/api/v1/pilots/bulk"));
+    EXPECT_TRUE(this->requests("PATCH", "/api/v1/pilots/UNKNOWN").empty());
+    EXPECT_TRUE(m_server.batchRequests());
+}
+
+TEST_F(ServerBackendTest, PatchesWithoutCallsignAreNotSent) {
+    m_server.setBatchRequests(true);
+
+    auto patches = this->tobtPatches("EDDM", 2);
+    patches.insert(patches.begin() + 1, {{"vacdm", {{"tobt", "2024-01-01T10:00:00.000Z"}}}});
+    patches.push_back({{"callsign", 42}, {"vacdm", {{"tobt", "2024-01-01T10:00:00.000Z"}}}});
+    EXPECT_EQ((std::vector<bool>{true, false, true, false}), m_server.patchPilots(patches));
+    EXPECT_FALSE(m_server.patchPilot(patches[1]));
+
+    EXPECT_EQ((std::vector<int>{200}), this->statuses("PATCH", "/api/v1/pilots/bulk"));
+    EXPECT_TRUE(m_server.batchRequests());
+}
+
+class ServerWithoutBulkTest : public ServerBackendTest {
+   protected:
+    ServerWithoutBulkTest() : ServerBackendTest(ServerWithoutBulkTest::withoutBulk()) {}
+
+    static mock::Options withoutBulk() {
+        auto options = ServerBackendTest::backendOptions();
+        options.bulkRequests = false;
+        return options;
+    }
+};
+
+TEST_F(ServerWithoutBulkTest, MessagesAreSentSeparatelyIfBulkEndpointIsUnknown) {
+    m_server.setBatchRequests(true);
+
+    const auto patches = this->tobtPatches("EDDM", 3);
+    EXPECT_EQ((std::vector<bool>{true, true, true}), m_server.patchPilots(patches));
+    EXPECT_FALSE(m_server.batchRequests());
+
+    // the following messages do not try the bulk endpoint again until the cooldown expired
+    EXPECT_EQ((std::vector<bool>{true, true, true}), m_server.patchPilots(patches));
+    EXPECT_EQ((std::vector<int>{404}), this->statuses("PATCH", "/api/v1/pilots/bulk"));
+    for (const auto &patch : patches) {
+        const auto callsign = patch["callsign"].get<std::string>();
+        EXPECT_EQ(2u, this->requests("PATCH", "/api/v1/pilots/" + callsign).size()) << callsign;
+    }
+}
+}  // namespace vacdm::com
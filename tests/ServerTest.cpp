@@ -0,0 +1,182 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <list>
+#include <string>
+#include <vector>
+
+#include "core/Server.h"
+
+using namespace std::chrono_literals;
+
+namespace vacdm::com {
+class ServerTest : public ::testing::Test {
+   protected:
+    ServerTest() : m_server(nullptr), m_now(std::chrono::floor<std::chrono::seconds>(std::chrono::system_clock::now())) {}
+
+    /// @brief stores the pilots as the response of a full request of the airport
+    void cacheAirport(const std::string &airport, const std::list<types::Pilot> &pilots) {
+        std::lock_guard guard(m_server.m_airportCacheLock);
+        m_server.m_airportCache[airport] = {"", "", "", pilots, types::defaultTime, std::chrono::steady_clock::now()};
+    }
+
+    std::chrono::system_clock::time_point cachedLastUpdate(const std::string &airport) {
+        std::lock_guard guard(m_server.m_airportCacheLock);
+        return m_server.m_airportCache.at(airport).lastUpdate;
+    }
+
+    std::list<types::Pilot> mergePilotChanges(const std::string &airport, const std::list<types::Pilot> &changes) {
+        return m_server.mergePilotChanges(airport, changes);
+    }
+
+    static std::chrono::milliseconds retryDelay(int attempt) { return Server::retryDelay(attempt); }
+
+    static std::vector<std::list<types::Pilot>> splitByAirport(std::list<types::Pilot> pilots,
+                                                              const std::vector<std::string> &airports) {
+        return Server::splitByAirport(std::move(pilots), airports);
+    }
+
+    bool apiIsChecked() const { return m_server.m_apiIsChecked; }
+    void rejectBulkRequestsUntil(std::chrono::steady_clock::time_point until) { m_server.m_bulkRejectedUntil = until; }
+    std::string baseUrl() const { return m_server.baseUrl(); }
+
+    types::Pilot pilot(const std::string &callsign, std::chrono::minutes updatedAgo, bool inactive = false) const {
+        types::Pilot pilot;
+        EXPECT_TRUE(pilot.callsign.assign(callsign));
+        pilot.origin = "EDDM";
+        pilot.lastUpdate = m_now - updatedAgo;
+        pilot.tobt = m_now + 10min;
+        pilot.inactive = inactive;
+        return pilot;
+    }
+
+    static std::vector<std::string> callsigns(const std::list<types::Pilot> &pilots) {
+        std::vector<std::string> callsigns;
+        for (const auto &pilot : pilots) callsigns.push_back(std::string(pilot.callsign));
+        return callsigns;
+    }
+
+    Server m_server;
+    std::chrono::system_clock::time_point m_now;
+};
+
+TEST_F(ServerTest, MergeReplacesChangedPilotsInPlace) {
+    this->cacheAirport("EDDM", {pilot("DLH1", 30min), pilot("DLH2", 30min), pilot("DLH3", 30min)});
+
+    auto change = pilot("DLH2", 1min);
+    change.tobt = m_now + 20min;
+    const auto pilots = this->mergePilotChanges("EDDM", {change});
+
+    EXPECT_EQ(callsigns(pilots), (std::vector<std::string>{"DLH1", "DLH2", "DLH3"}));
+    EXPECT_EQ(std::next(pilots.begin())->tobt, m_now + 20min);
+}
+
+TEST_F(ServerTest, MergeAppendsNewPilots) {
+    this->cacheAirport("EDDM", {pilot("DLH1", 30min), pilot("DLH2", 30min)});
+
+    const auto pilots = this->mergePilotChanges("EDDM", {pilot("AFR1", 1min), pilot("DLH1", 1min)});
+
+    EXPECT_EQ(callsigns(pilots), (std::vector<std::string>{"DLH1", "DLH2", "AFR1"}));
+}
+
+TEST_F(ServerTest, MergeAppliesDeletionAfterUpdateOfSameCallsign) {
+    this->cacheAirport("EDDM", {pilot("DLH1", 30min), pilot("DLH2", 30min)});
+
+    auto update = pilot("DLH1", 2min);
+    update.tobt = m_now + 20min;
+    const auto pilots = this->mergePilotChanges("EDDM", {update, pilot("DLH1", 1min, true)});
+
+    ASSERT_EQ(callsigns(pilots), (std::vector<std::string>{"DLH1", "DLH2"}));
+    EXPECT_TRUE(pilots.front().inactive);
+    EXPECT_EQ(pilots.front().tobt, m_now + 10min);
+}
+
+TEST_F(ServerTest, MergeAppliesUpdateAfterDeletionOfSameCallsign) {
+    this->cacheAirport("EDDM", {pilot("DLH1", 30min)});
+
+    auto recreated = pilot("DLH1", 1min);
+    recreated.tobt = m_now + 20min;
+    const auto pilots = this->mergePilotChanges("EDDM", {pilot("DLH1", 2min, true), recreated});
+
+    ASSERT_EQ(callsigns(pilots), (std::vector<std::string>{"DLH1"}));
+    EXPECT_FALSE(pilots.front().inactive);
+    EXPECT_EQ(pilots.front().tobt, m_now + 20min);
+}
+
+TEST_F(ServerTest, MergeKeepsLatestUpdateForNextRequest) {
+    this->cacheAirport("EDDM", {pilot("DLH1", 30min)});
+
+    // the backend does not sort the changes by their update time
+    this->mergePilotChanges("EDDM", {pilot("DLH1", 1min), pilot("DLH2", 5min)});
+
+    EXPECT_EQ(this->cachedLastUpdate("EDDM"), m_now - 1min);
+}
+
+TEST_F(ServerTest, MergeIgnoresUnknownAirport) {
+    this->cacheAirport("EDDM", {pilot("DLH1", 30min)});
+
+    EXPECT_TRUE(this->mergePilotChanges("EDDF", {pilot("DLH2", 1min)}).empty());
+}
+
+TEST_F(ServerTest, SplitsPilotsOfMultiAirportResponse) {
+    auto eddf = pilot("DLH2", 1min);
+    eddf.origin = "EDDF";
+    auto unknown = pilot("AFR1", 1min);
+    unknown.origin = "LFPG";
+
+    const auto airportPilots =
+        splitByAirport({pilot("DLH1", 1min), eddf, unknown, pilot("DLH3", 1min)}, {"EDDF", "EDDM"});
+
+    ASSERT_EQ(2u, airportPilots.size());
+    EXPECT_EQ(callsigns(airportPilots[0]), (std::vector<std::string>{"DLH2"}));
+    // the order of the response is kept within an airport, pilots of other airports are dropped
+    EXPECT_EQ(callsigns(airportPilots[1]), (std::vector<std::string>{"DLH1", "DLH3"}));
+}
+
+TEST_F(ServerTest, RetryDelayGrowsUpToLimit) {
+    for (int attempt = 1; attempt <= 5; ++attempt) {
+        const auto limit = std::min(retryBaseDelay * (1 << (attempt - 1)), retryMaxDelay);
+
+        auto longest = std::chrono::milliseconds(0);
+        for (int i = 0; i < 200; ++i) {
+            const auto delay = retryDelay(attempt);
+            ASSERT_GE(delay.count(), 0);
+            ASSERT_LE(delay, limit);
+            longest = std::max(longest, delay);
+        }
+        // the delays are spread over the whole range
+        EXPECT_GT(longest, limit / 2) << "attempt " << attempt;
+    }
+}
+
+TEST_F(ServerTest, BulkRequestsAreTriedAgainAfterCooldown) {
+    m_server.setBatchRequests(true);
+    EXPECT_TRUE(m_server.batchRequests());
+
+    this->rejectBulkRequestsUntil(std::chrono::steady_clock::now() + bulkRetryCooldown);
+    EXPECT_FALSE(m_server.batchRequests());
+
+    this->rejectBulkRequestsUntil(std::chrono::steady_clock::now() - 1s);
+    EXPECT_TRUE(m_server.batchRequests());
+
+    // a new backend may know the bulk endpoint
+    this->rejectBulkRequestsUntil(std::chrono::steady_clock::now() + bulkRetryCooldown);
+    m_server.changeServerAddress("http://127.0.0.1:9");
+    EXPECT_TRUE(m_server.batchRequests());
+}
+
+TEST_F(ServerTest, FailedApiCheckIsRepeatedAndResetByNewAddress) {
+    // nothing listens on the discard port
+    m_server.changeServerAddress("http://127.0.0.1:9");
+
+    EXPECT_FALSE(m_server.checkWebApi());
+    EXPECT_NE(std::string::npos, m_server.errorMessage().find("Failed to connect"));
+    // an unreachable backend is checked again by the next handshake
+    EXPECT_FALSE(this->apiIsChecked());
+
+    m_server.changeServerAddress("http://127.0.0.1:10");
+    EXPECT_TRUE(m_server.errorMessage().empty());
+    EXPECT_EQ("http://127.0.0.1:10", this->baseUrl());
+}
+}  // namespace vacdm::com
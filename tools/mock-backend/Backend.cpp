@@ -0,0 +1,264 @@
+#include "Backend.h"
+
+#include <format>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <random>
+#include <sstream>
+
+#include <nlohmann/json.hpp>
+
+#include "Version.h"
+
+using namespace vacdm::mock;
+
+namespace {
+void sendJson(httplib::Response &response, const nlohmann::json &content, int status = 200) {
+    response.status = status;
+    response.set_content(content.dump(), "application/json");
+}
+
+void sendError(httplib::Response &response, int status, const std::string &message) {
+    sendJson(response, {{"error", message}}, status);
+}
+
+std::optional<nlohmann::json> parseContent(const httplib::Request &request) {
+    try {
+        return nlohmann::json::parse(request.body);
+    } catch (const std::exception &) {
+        return std::nullopt;
+    }
+}
+
+/// @brief strong validator of the content, equal contents have the same tag
+std::string entityTag(const std::string &content) {
+    return std::format("\"{:016x}\"", std::hash<std::string>()(content));
+}
+}  // namespace
+
+std::vector<std::string> vacdm::mock::splitList(const std::string &value) {
+    std::vector<std::string> entries;
+    std::stringstream stream(value);
+    std::string entry;
+    while (std::getline(stream, entry, ',')) {
+        if (false == entry.empty()) entries.push_back(entry);
+    }
+    return entries;
+}
+
+Backend::Backend(Options options)
+    : m_options(std::move(options)),
+      m_port(m_options.port),
+      m_store(m_options.pilotsPerAirport, m_options.paddingBytes),
+      m_server(),
+      m_listener(),
+      m_changer(),
+      m_requestsLock(),
+      m_requests() {
+    this->registerRoutes();
+}
+
+Backend::~Backend() {
+    this->stop();
+    if (this->m_changer.joinable()) this->m_changer.join();
+}
+
+bool Backend::listen() {
+    this->startChanger();
+    const bool listened = this->m_server.listen(this->m_options.host, this->m_options.port);
+
+    this->m_store.stop();
+    if (this->m_changer.joinable()) this->m_changer.join();
+    return listened;
+}
+
+int Backend::start() {
+    int port = this->m_options.port;
+    if (0 == port)
+        port = this->m_server.bind_to_any_port(this->m_options.host);
+    else if (false == this->m_server.bind_to_port(this->m_options.host, port))
+        port = -1;
+    if (0 > port) return -1;
+    this->m_port = port;
+
+    this->startChanger();
+    this->m_listener = std::thread([this]() { this->m_server.listen_after_bind(); });
+    this->m_server.wait_until_ready();
+    return port;
+}
+
+void Backend::stop() {
+    // the event streams end with the store, the server waits for the running requests
+    this->m_store.stop();
+    this->m_server.stop();
+
+    // the thread of listen is not joined, stop is called by its signal handler
+    if (this->m_listener.joinable()) this->m_listener.join();
+}
+
+int Backend::port() const { return this->m_port; }
+
+PilotStore &Backend::store() { return this->m_store; }
+
+std::vector<ReceivedRequest> Backend::requests() {
+    std::lock_guard guard(this->m_requestsLock);
+    return this->m_requests;
+}
+
+void Backend::startChanger() {
+    if (0 == this->m_options.eventInterval.count()) return;
+
+    this->m_changer = std::thread([this]() {
+        while (false == this->m_store.stopped()) {
+            std::this_thread::sleep_for(this->m_options.eventInterval);
+            this->m_store.changeRandomPilot();
+        }
+    });
+}
+
+void Backend::registerRoutes() {
+    this->m_server.set_logger([this](const httplib::Request &request, const httplib::Response &response) {
+        std::lock_guard guard(this->m_requestsLock);
+        this->m_requests.push_back(
+            {request.method, request.path, request.get_header_value("Content-Encoding"), response.status});
+    });
+
+    // the configured latency and errors apply to all endpoints, including the event stream
+    this->m_server.set_pre_routing_handler([this](const httplib::Request &, httplib::Response &response) {
+        thread_local std::mt19937 generator(std::random_device{}());
+        const auto &options = this->m_options;
+
+        auto delay = options.latency;
+        if (0 != options.jitter.count())
+            delay += std::chrono::milliseconds(
+                std::uniform_int_distribution<std::chrono::milliseconds::rep>(0, options.jitter.count())(generator));
+        if (0 != delay.count()) std::this_thread::sleep_for(delay);
+
+        if (0.0 != options.errorRate && std::uniform_real_distribution<double>(0.0, 100.0)(generator) < options.errorRate) {
+            sendError(response, options.errorStatus, "injected error");
+            return httplib::Server::HandlerResponse::Handled;
+        }
+        return httplib::Server::HandlerResponse::Unhandled;
+    });
+
+    auto &store = this->m_store;
+
+    this->m_server.Get("/api/v1/version", [](const httplib::Request &, httplib::Response &response) {
+        sendJson(response, {{"major", PLUGIN_VERSION_MAJOR}, {"minor", PLUGIN_VERSION_MINOR}});
+    });
+    this->m_server.Get("/api/v1/config", [](const httplib::Request &, httplib::Response &response) {
+        sendJson(response, {{"serverName", "vACDM mock backend"},
+                            {"allowSimSession", true},
+                            {"allowObsMaster", true},
+                            {"features", nlohmann::json::array({"multiAirportPilots"})}});
+    });
+    this->m_server.Get("/api/v1/airports", [this](const httplib::Request &, httplib::Response &response) {
+        nlohmann::json airports = nlohmann::json::array();
+        for (const auto &icao : this->m_options.airports) airports.push_back({{"icao", icao}});
+        sendJson(response, airports);
+    });
+
+    // unchanged pilots are answered without content if the client sends the tag of its copy
+    this->m_server.Get("/api/v1/pilots", [&store](const httplib::Request &request, httplib::Response &response) {
+        const auto content =
+            store.pilots(splitList(request.get_param_value("adep")), request.get_param_value("since")).dump();
+        const auto tag = entityTag(content);
+
+        response.set_header("ETag", tag);
+        if (tag == request.get_header_value("If-None-Match")) {
+            response.status = 304;
+            return;
+        }
+        response.status = 200;
+        response.set_content(content, "application/json");
+    });
+    this->m_server.Post("/api/v1/pilots", [&store](const httplib::Request &request, httplib::Response &response) {
+        const auto content = parseContent(request);
+        if (!content) return sendError(response, 400, "invalid JSON");
+
+        const auto pilot = store.createPilot(*content);
+        if (!pilot) return sendError(response, 400, "callsign or departure missing");
+        sendJson(response, *pilot, 201);
+    });
+
+    // registered before the pilot route, "events" would be taken as a callsign otherwise
+    this->m_server.Get("/api/v1/pilots/events", [&store](const httplib::Request &request, httplib::Response &response) {
+        const auto airports = splitList(request.get_param_value("adep"));
+        store.pilots(airports, "");
+
+        auto sequence = std::make_shared<std::uint64_t>(store.latestSequence());
+        response.set_header("Cache-Control", "no-cache");
+        response.set_chunked_content_provider(
+            "text/event-stream", [&store, airports, sequence](std::size_t, httplib::DataSink &sink) {
+                if (true == store.stopped()) return false;
+
+                const auto events = store.waitForEvents(*sequence, airports, keepAliveInterval);
+                std::string frames = true == events.empty() ? ": keep-alive\n\n" : "";
+                for (const auto &event : events) frames += "event: " + event.type + "\ndata: " + event.data + "\n\n";
+
+                return sink.write(frames.data(), frames.size());
+            });
+    });
+
+    // bulk requests answer with the status of every message, registered before the pilot routes as well
+    this->m_server.Post("/api/v1/pilots/bulk", [this, &store](const httplib::Request &request,
+                                                             httplib::Response &response) {
+        if (false == this->m_options.bulkRequests) return sendError(response, 404, "not found");
+
+        const auto content = parseContent(request);
+        if (!content || false == content->is_array()) return sendError(response, 400, "invalid JSON");
+
+        nlohmann::json results = nlohmann::json::array();
+        for (const auto &message : *content) {
+            if (false == message.is_object()) {
+                results.push_back({{"callsign", ""}, {"status", 400}});
+                continue;
+            }
+            const auto pilot = store.createPilot(message);
+            results.push_back({{"callsign", message.value("callsign", "")}, {"status", pilot ? 201 : 400}});
+        }
+        sendJson(response, results);
+    });
+    this->m_server.Patch("/api/v1/pilots/bulk", [this, &store](const httplib::Request &request,
+                                                             httplib::Response &response) {
+        if (false == this->m_options.bulkRequests) return sendError(response, 404, "not found");
+
+        const auto content = parseContent(request);
+        if (!content || false == content->is_array()) return sendError(response, 400, "invalid JSON");
+
+        nlohmann::json results = nlohmann::json::array();
+        for (const auto &message : *content) {
+            if (false == message.is_object()) {
+                results.push_back({{"callsign", ""}, {"status", 400}});
+                continue;
+            }
+            const auto callsign = message.value("callsign", "");
+            const auto pilot = store.patchPilot(callsign, message);
+            results.push_back({{"callsign", callsign}, {"status", pilot ? 200 : 404}});
+        }
+        sendJson(response, results);
+    });
+
+    this->m_server.Get("/api/v1/pilots/:callsign", [&store](const httplib::Request &request, httplib::Response &response) {
+        const auto pilot = store.pilot(request.path_params.at("callsign"));
+        if (!pilot) return sendError(response, 404, "pilot not found");
+        sendJson(response, *pilot);
+    });
+    this->m_server.Patch("/api/v1/pilots/:callsign",
+                         [&store](const httplib::Request &request, httplib::Response &response) {
+                             const auto content = parseContent(request);
+                             if (!content || false == content->is_object())
+                                 return sendError(response, 400, "invalid JSON");
+
+                             const auto pilot = store.patchPilot(request.path_params.at("callsign"), *content);
+                             if (!pilot) return sendError(response, 404, "pilot not found");
+                             sendJson(response, *pilot);
+                         });
+    this->m_server.Delete("/api/v1/pilots/:callsign",
+                          [&store](const httplib::Request &request, httplib::Response &response) {
+                              if (false == store.deletePilot(request.path_params.at("callsign")))
+                                  return sendError(response, 404, "pilot not found");
+                              response.status = 204;
+                          });
+}
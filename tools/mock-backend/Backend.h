@@ -0,0 +1,81 @@
+#pragma once
+
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "PilotStore.h"
+#include "core/Http.h"
+
+namespace vacdm::mock {
+/// @brief interval of the keep-alive comments of the event stream
+constexpr std::chrono::seconds keepAliveInterval = std::chrono::seconds(15);
+
+struct Options {
+    std::string host = "127.0.0.1";
+    int port = 8080;
+    std::vector<std::string> airports = {"EDDM", "EDDF", "LFPG", "EGLL", "EHAM", "LSZH", "LOWW"};
+    std::size_t pilotsPerAirport = 20;
+    std::size_t paddingBytes = 0;
+    std::chrono::milliseconds latency = std::chrono::milliseconds(0);
+    std::chrono::milliseconds jitter = std::chrono::milliseconds(0);
+    double errorRate = 0.0;
+    int errorStatus = 503;
+    std::chrono::milliseconds eventInterval = std::chrono::milliseconds(1000);
+    /// @brief answers the bulk requests with 404 like a backend without the bulk endpoints if not set
+    bool bulkRequests = true;
+};
+
+/// @brief request which was answered by the backend
+struct ReceivedRequest {
+    std::string method;
+    std::string path;
+    std::string contentEncoding;
+    int status;
+};
+
+std::vector<std::string> splitList(const std::string &value);
+
+/// @brief HTTP server of the mock backend
+///
+/// The server runs in the calling thread with listen, or in a background thread on a free port with start, which
+/// is used by the tests of the plugin.
+class Backend {
+   public:
+    explicit Backend(Options options);
+    ~Backend();
+
+    Backend(const Backend &) = delete;
+    Backend &operator=(const Backend &) = delete;
+
+    /// @brief Answers requests on the configured host and port until stop is called
+    /// @return false if the port could not be bound
+    bool listen();
+    /// @brief Answers requests on the configured port in a background thread, on a free port if the port is 0
+    /// @return the port, -1 if the port could not be bound
+    int start();
+    /// @brief Stops the server and closes the event streams, can be called by a signal handler of listen
+    void stop();
+    /// @brief Returns the port of the server, the bound port if it was started on a free port
+    int port() const;
+
+    PilotStore &store();
+    /// @brief Returns the requests which were answered, event streams are listed after they are closed
+    std::vector<ReceivedRequest> requests();
+
+   private:
+    void registerRoutes();
+    void startChanger();
+
+    Options m_options;
+    int m_port;
+    PilotStore m_store;
+    httplib::Server m_server;
+    std::thread m_listener;
+    std::thread m_changer;
+    std::mutex m_requestsLock;
+    std::vector<ReceivedRequest> m_requests;
+};
+}  // namespace vacdm::mock
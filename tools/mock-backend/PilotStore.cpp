@@ -0,0 +1,259 @@
+#include "PilotStore.h"
+
+#include <algorithm>
+#include <format>
+
+using namespace vacdm::mock;
+
+std::string vacdm::mock::isoString(const std::chrono::system_clock::time_point &timepoint) {
+    return std::format("{0:%FT%T}Z", std::chrono::floor<std::chrono::milliseconds>(timepoint));
+}
+
+PilotStore::PilotStore(std::size_t pilotsPerAirport, std::size_t paddingBytes)
+    : m_lock(),
+      m_changed(),
+      m_stop(false),
+      m_pilotsPerAirport(pilotsPerAirport),
+      m_padding(paddingBytes, 'x'),
+      m_callsignCounter(100),
+      m_airports(),
+      m_events(),
+      m_random(std::random_device()()) {}
+
+nlohmann::json PilotStore::pilots(const std::vector<std::string> &airports, const std::string &since) {
+    std::lock_guard guard(this->m_lock);
+    for (const auto &airport : airports) this->populate(airport);
+
+    nlohmann::json result = nlohmann::json::array();
+    for (const auto &[airport, airportPilots] : this->m_airports) {
+        if (false == airports.empty() && airports.end() == std::find(airports.begin(), airports.end(), airport))
+            continue;
+
+        for (const auto &pilot : airportPilots) {
+            // the timestamps have the same format, the string order is the time order
+            if (false == since.empty() && pilot.second["updatedAt"].get<std::string>() <= since) continue;
+            result.push_back(pilot.second);
+        }
+    }
+
+    return result;
+}
+
+std::optional<nlohmann::json> PilotStore::pilot(const std::string &callsign) {
+    std::lock_guard guard(this->m_lock);
+
+    std::map<std::string, nlohmann::json>::iterator pilot;
+    if (this->m_airports.end() == this->find(callsign, pilot)) return std::nullopt;
+    return pilot->second;
+}
+
+std::optional<nlohmann::json> PilotStore::createPilot(const nlohmann::json &content) {
+    if (false == content.is_object() || false == content.contains("callsign") ||
+        false == content["callsign"].is_string() || false == content.contains("flightplan") ||
+        false == content["flightplan"].contains("departure") || false == content["flightplan"]["departure"].is_string())
+        return std::nullopt;
+
+    const auto callsign = content["callsign"].get<std::string>();
+    const auto departure = content["flightplan"]["departure"].get<std::string>();
+
+    std::unique_lock lock(this->m_lock);
+
+    // a pilot which changed the departure airport is moved
+    std::map<std::string, nlohmann::json>::iterator existing;
+    auto airport = this->find(callsign, existing);
+    if (this->m_airports.end() != airport) airport->second.erase(existing);
+
+    auto pilot = content;
+    this->complete(pilot);
+    this->m_airports[departure][callsign] = pilot;
+    this->publish(departure, "pilot", pilot.dump());
+
+    lock.unlock();
+    this->m_changed.notify_all();
+    return pilot;
+}
+
+std::optional<nlohmann::json> PilotStore::patchPilot(const std::string &callsign, const nlohmann::json &content) {
+    std::unique_lock lock(this->m_lock);
+
+    std::map<std::string, nlohmann::json>::iterator pilot;
+    auto airport = this->find(callsign, pilot);
+    if (this->m_airports.end() == airport) return std::nullopt;
+
+    pilot->second.merge_patch(content);
+    pilot->second["callsign"] = callsign;
+    pilot->second["updatedAt"] = isoString(std::chrono::system_clock::now());
+    const auto patched = pilot->second;
+    this->publish(airport->first, "pilot", patched.dump());
+
+    lock.unlock();
+    this->m_changed.notify_all();
+    return patched;
+}
+
+bool PilotStore::deletePilot(const std::string &callsign) {
+    std::unique_lock lock(this->m_lock);
+
+    std::map<std::string, nlohmann::json>::iterator pilot;
+    auto airport = this->find(callsign, pilot);
+    if (this->m_airports.end() == airport) return false;
+
+    airport->second.erase(pilot);
+    this->publish(airport->first, "delete", nlohmann::json{{"callsign", callsign}}.dump());
+
+    lock.unlock();
+    this->m_changed.notify_all();
+    return true;
+}
+
+void PilotStore::changeRandomPilot() {
+    std::unique_lock lock(this->m_lock);
+    if (true == this->m_airports.empty()) return;
+
+    auto airport = std::next(this->m_airports.begin(), this->random(0, this->m_airports.size() - 1));
+    auto &airportPilots = airport->second;
+    if (true == airportPilots.empty()) return;
+
+    auto pilot = std::next(airportPilots.begin(), this->random(0, airportPilots.size() - 1));
+    if (0 == this->random(0, 9)) {
+        this->publish(airport->first, "delete", nlohmann::json{{"callsign", pilot->first}}.dump());
+        airportPilots.erase(pilot);
+
+        auto created = this->generatePilot(airport->first);
+        const auto callsign = created["callsign"].get<std::string>();
+        this->publish(airport->first, "pilot", created.dump());
+        airportPilots[callsign] = std::move(created);
+    } else {
+        const auto tobt = std::chrono::system_clock::now() + std::chrono::minutes(this->random(0, 30));
+        auto &vacdm = pilot->second["vacdm"];
+        vacdm["tobt"] = isoString(tobt);
+        vacdm["tsat"] = isoString(tobt + std::chrono::minutes(this->random(0, 10)));
+        vacdm["ttot"] = isoString(tobt + std::chrono::minutes(this->random(10, 20)));
+        pilot->second["updatedAt"] = isoString(std::chrono::system_clock::now());
+        this->publish(airport->first, "pilot", pilot->second.dump());
+    }
+
+    lock.unlock();
+    this->m_changed.notify_all();
+}
+
+std::vector<Event> PilotStore::waitForEvents(std::uint64_t &sequence, const std::vector<std::string> &airports,
+                                             std::chrono::seconds timeout) {
+    std::unique_lock lock(this->m_lock);
+    this->m_changed.wait_for(lock, timeout, [this, &sequence]() {
+        return true == this->m_stop || (false == this->m_events.empty() && this->m_events.back().sequence > sequence);
+    });
+
+    std::vector<Event> events;
+    for (const auto &event : this->m_events) {
+        if (event.sequence <= sequence) continue;
+        if (airports.end() != std::find(airports.begin(), airports.end(), event.airport)) events.push_back(event);
+    }
+    if (false == this->m_events.empty()) sequence = std::max(sequence, this->m_events.back().sequence);
+
+    return events;
+}
+
+std::uint64_t PilotStore::latestSequence() {
+    std::lock_guard guard(this->m_lock);
+    return this->m_events.empty() ? 0 : this->m_events.back().sequence;
+}
+
+void PilotStore::stop() {
+    {
+        std::lock_guard guard(this->m_lock);
+        this->m_stop = true;
+    }
+    this->m_changed.notify_all();
+}
+
+bool PilotStore::stopped() {
+    std::lock_guard guard(this->m_lock);
+    return this->m_stop;
+}
+
+void PilotStore::populate(const std::string &airport) {
+    if (this->m_airports.end() != this->m_airports.find(airport)) return;
+
+    auto &airportPilots = this->m_airports[airport];
+    for (std::size_t i = 0; i < this->m_pilotsPerAirport; ++i) {
+        auto pilot = this->generatePilot(airport);
+        const auto callsign = pilot["callsign"].get<std::string>();
+        airportPilots[callsign] = std::move(pilot);
+    }
+}
+
+nlohmann::json PilotStore::generatePilot(const std::string &airport) {
+    static const std::vector<std::string> airlines = {"DLH", "AFR", "BAW", "KLM", "EZY", "RYR", "SWR", "AUA"};
+    static const std::vector<std::string> destinations = {"EDDF", "LFPG", "EGLL", "EHAM", "LSZH", "LOWW"};
+
+    const auto eobt = std::chrono::system_clock::now() + std::chrono::minutes(this->random(0, 60));
+    const auto callsign = airlines[this->random(0, airlines.size() - 1)] + std::to_string(++this->m_callsignCounter);
+
+    nlohmann::json pilot = {
+        {"callsign", callsign},
+        {"position", {{"lat", 48.35}, {"lon", 11.78}}},
+        {"vacdm",
+         {{"eobt", isoString(eobt)},
+          {"tobt", isoString(eobt)},
+          {"ttot", isoString(eobt + std::chrono::minutes(15))},
+          {"tsat", isoString(eobt + std::chrono::minutes(5))}}},
+        {"flightplan", {{"departure", airport}, {"arrival", destinations[this->random(0, destinations.size() - 1)]}}},
+        {"clearance", {{"dep_rwy", "26R"}, {"sid", "MIQ5S"}}},
+    };
+    this->complete(pilot);
+
+    return pilot;
+}
+
+void PilotStore::complete(nlohmann::json &pilot) {
+    const nlohmann::json defaults = {
+        {"inactive", false},
+        {"position", {{"lat", 0.0}, {"lon", 0.0}}},
+        {"vacdm",
+         {{"eobt", unsetTimestamp},
+          {"tobt", unsetTimestamp},
+          {"tobt_state", "NON-CDM"},
+          {"ctot", unsetTimestamp},
+          {"ttot", unsetTimestamp},
+          {"tsat", unsetTimestamp},
+          {"exot", 10},
+          {"asat", unsetTimestamp},
+          {"aobt", unsetTimestamp},
+          {"atot", unsetTimestamp},
+          {"asrt", unsetTimestamp},
+          {"aort", unsetTimestamp}}},
+        {"flightplan", {{"departure", ""}, {"arrival", ""}}},
+        {"clearance", {{"dep_rwy", ""}, {"sid", ""}}},
+        {"measures", nlohmann::json::array()},
+        {"hasBooking", false},
+    };
+
+    auto completed = defaults;
+    completed.merge_patch(pilot);
+    completed["updatedAt"] = isoString(std::chrono::system_clock::now());
+    // unknown fields are skipped by the plugin, they only increase the size of the responses
+    if (false == this->m_padding.empty()) completed["padding"] = this->m_padding;
+
+    pilot = std::move(completed);
+}
+
+void PilotStore::publish(const std::string &airport, const std::string &type, std::string data) {
+    const std::uint64_t sequence = this->m_events.empty() ? 1 : this->m_events.back().sequence + 1;
+    this->m_events.push_back({sequence, airport, type, std::move(data)});
+    if (this->m_events.size() > maxEventHistory) this->m_events.pop_front();
+}
+
+std::map<std::string, std::map<std::string, nlohmann::json>>::iterator PilotStore::find(
+    const std::string &callsign, std::map<std::string, nlohmann::json>::iterator &pilot) {
+    for (auto airport = this->m_airports.begin(); this->m_airports.end() != airport; ++airport) {
+        pilot = airport->second.find(callsign);
+        if (airport->second.end() != pilot) return airport;
+    }
+
+    return this->m_airports.end();
+}
+
+std::size_t PilotStore::random(std::size_t min, std::size_t max) {
+    return std::uniform_int_distribution<std::size_t>(min, max)(this->m_random);
+}
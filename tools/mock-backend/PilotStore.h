@@ -0,0 +1,87 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+namespace vacdm::mock {
+/// @brief number of events which are kept for subscriptions which are behind
+constexpr std::size_t maxEventHistory = 1000;
+/// @brief timestamp of the times which are not set
+constexpr const char *unsetTimestamp = "1969-12-31T23:59:59.999Z";
+
+std::string isoString(const std::chrono::system_clock::time_point &timepoint);
+
+/// @brief change of a pilot which is published on the event stream
+struct Event {
+    std::uint64_t sequence;
+    std::string airport;
+    std::string type;
+    std::string data;
+};
+
+/// @brief In-memory pilots of the mock backend
+///
+/// The pilots of an airport are generated when the airport is requested for the first time. All changes, by the
+/// plugin or by changeRandomPilot, are published as events.
+class PilotStore {
+   public:
+    PilotStore(std::size_t pilotsPerAirport, std::size_t paddingBytes);
+
+    /// @brief Returns the pilots of the airports which changed after the given time
+    /// @param airports ICAO codes of the departure airports, all pilots if empty
+    /// @param since ISO timestamp, all pilots if empty
+    nlohmann::json pilots(const std::vector<std::string> &airports, const std::string &since);
+    std::optional<nlohmann::json> pilot(const std::string &callsign);
+    /// @brief Creates a pilot or replaces the pilot with the same callsign
+    /// @return the stored pilot, nullopt if the content has no callsign or departure
+    std::optional<nlohmann::json> createPilot(const nlohmann::json &content);
+    /// @brief Applies the content to the pilot as JSON merge patch
+    /// @return the updated pilot, nullopt if the pilot does not exist
+    std::optional<nlohmann::json> patchPilot(const std::string &callsign, const nlohmann::json &content);
+    bool deletePilot(const std::string &callsign);
+    /// @brief Changes the times of a random pilot, replaces a pilot by a new one from time to time
+    void changeRandomPilot();
+
+    /// @brief Waits until events newer than the sequence are published or the timeout expires
+    /// @return the events of the airports, the sequence is set to the latest event
+    std::vector<Event> waitForEvents(std::uint64_t &sequence, const std::vector<std::string> &airports,
+                                     std::chrono::seconds timeout);
+    std::uint64_t latestSequence();
+
+    void stop();
+    bool stopped();
+
+   private:
+    /// @brief generates the pilots of the airport if it has not been requested before
+    void populate(const std::string &airport);
+    nlohmann::json generatePilot(const std::string &airport);
+    /// @brief fills the fields which are not set by the plugin and the padding of the pilot
+    void complete(nlohmann::json &pilot);
+    void publish(const std::string &airport, const std::string &type, std::string data);
+    /// @brief returns the airport and the position of the pilot
+    std::map<std::string, std::map<std::string, nlohmann::json>>::iterator find(
+        const std::string &callsign, std::map<std::string, nlohmann::json>::iterator &pilot);
+    std::size_t random(std::size_t min, std::size_t max);
+
+    std::mutex m_lock;
+    std::condition_variable m_changed;
+    bool m_stop;
+    std::size_t m_pilotsPerAirport;
+    std::string m_padding;
+    std::size_t m_callsignCounter;
+    /// @brief pilots per departure airport and callsign
+    std::map<std::string, std::map<std::string, nlohmann::json>> m_airports;
+    std::deque<Event> m_events;
+    std::mt19937 m_random;
+};
+}  // namespace vacdm::mock
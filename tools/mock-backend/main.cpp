@@ -0,0 +1,95 @@
+// Stand-in for the vACDM backend, used to test and load-test the plugin without a backend connection.
+//
+// The backend implements the endpoints which are used by the plugin with in-memory pilots. The pilots of an airport
+// are generated when they are requested for the first time, a random pilot is changed in a fixed interval. All
+// changes are published on /api/v1/pilots/events as server-sent events.
+//
+// The latency, the error rate and the size of the pilots can be configured to reproduce a slow or failing backend.
+
+#include <algorithm>
+#include <csignal>
+#include <iostream>
+#include <string>
+
+#include "Backend.h"
+
+using namespace vacdm::mock;
+
+namespace {
+constexpr const char *usage =
+    "Usage: vacdm-mock-backend [options]\n"
+    "  --host ADDRESS          address to listen on (default 127.0.0.1)\n"
+    "  --port PORT             port to listen on (default 8080)\n"
+    "  --airports LIST         comma separated supported airports (default EDDM,EDDF,LFPG,EGLL,EHAM,LSZH,LOWW)\n"
+    "  --pilots COUNT          generated pilots per airport (default 20)\n"
+    "  --padding BYTES         additional bytes per pilot in the responses (default 0)\n"
+    "  --latency MS            delay of every response (default 0)\n"
+    "  --jitter MS             additional random delay of every response (default 0)\n"
+    "  --error-rate PERCENT    share of the requests which fail (default 0)\n"
+    "  --error-status STATUS   HTTP status of the failed requests (default 503)\n"
+    "  --event-interval MS     interval of the random pilot changes, 0 disables them (default 1000)\n"
+    "  --bulk-requests 0|1     serve the bulk endpoints, 404 otherwise (default 1)\n";
+
+bool parseOptions(int argc, char **argv, Options &options) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string argument = argv[i];
+        if (i + 1 >= argc) return false;
+
+        const std::string value = argv[++i];
+        try {
+            if ("--host" == argument)
+                options.host = value;
+            else if ("--port" == argument)
+                options.port = std::stoi(value);
+            else if ("--airports" == argument)
+                options.airports = splitList(value);
+            else if ("--pilots" == argument)
+                options.pilotsPerAirport = static_cast<std::size_t>(std::stoul(value));
+            else if ("--padding" == argument)
+                options.paddingBytes = static_cast<std::size_t>(std::stoul(value));
+            else if ("--latency" == argument)
+                options.latency = std::chrono::milliseconds(std::stoul(value));
+            else if ("--jitter" == argument)
+                options.jitter = std::chrono::milliseconds(std::stoul(value));
+            else if ("--error-rate" == argument)
+                options.errorRate = std::clamp(std::stod(value), 0.0, 100.0);
+            else if ("--error-status" == argument)
+                options.errorStatus = std::stoi(value);
+            else if ("--event-interval" == argument)
+                options.eventInterval = std::chrono::milliseconds(std::stoul(value));
+            else if ("--bulk-requests" == argument)
+                options.bulkRequests = 0 != std::stoi(value);
+            else
+                return false;
+        } catch (const std::exception &) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+Backend *runningBackend = nullptr;
+}  // namespace
+
+int main(int argc, char **argv) {
+    Options options;
+    if (false == parseOptions(argc, argv, options)) {
+        std::cerr << usage;
+        return 1;
+    }
+
+    Backend backend(options);
+
+    runningBackend = &backend;
+    std::signal(SIGINT, [](int) {
+        if (nullptr != runningBackend) runningBackend->stop();
+    });
+
+    std::cout << "vACDM mock backend listening on http://" << options.host << ":" << options.port << std::endl;
+    if (false == backend.listen()) {
+        std::cerr << "Failed to listen on " << options.host << ":" << options.port << std::endl;
+        return 1;
+    }
+    return 0;
+}